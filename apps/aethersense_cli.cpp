@@ -1,14 +1,23 @@
+#include <charconv>
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "aethersense/core/config.hpp"
 #include "aethersense/core/version.hpp"
+#include "aethersense/io/capture_index.hpp"
 #include "aethersense/io/csi_reader.hpp"
+#include "aethersense/io/csi_writer.hpp"
 #include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/multi_stream.hpp"
 #include "aethersense/runtime/pipeline.hpp"
+#include "aethersense/runtime/pipelined_runner.hpp"
 
 namespace {
 
@@ -16,28 +25,291 @@ void PrintSchema() {
   std::cout << "AetherSense config v3 schema with io tail/checkpoint and resampling/outlier controls\n";
 }
 
+// Reads a whole-string unsigned integer (a timestamp in ns); false if `text` is not one.
+bool ParseTimestamp(const std::string &text, std::uint64_t &out) {
+  const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+  return ec == std::errc{} && ptr == text.data() + text.size() && !text.empty();
+}
+
+// --from-ts/--to-ts: start one analysis window before `from_ts` (found through the capture's
+// sidecar index) so the first decision in range has a full window, and stop after `to_ts`.
+// Decisions stamped before `from_ts` are warm-up and are not reported.
+aethersense::Result<bool> ApplyTimeRange(aethersense::Config &cfg, std::uint64_t from_ts,
+                                         std::uint64_t to_ts) {
+  cfg.io.stop_timestamp_ns = to_ts;
+  if (from_ts == 0) {
+    return true;
+  }
+  return aethersense::io::SeekToTimestamp(cfg.io, cfg.io.path, from_ts, cfg.dsp.window_frames);
+}
+
+// Several --input files: one stream each, hosted on the worker pool. Every stream gets its own
+// checkpoint file (io.checkpoint_path + "." + index) so their offsets do not collide.
+int RunMultiStream(const aethersense::Config &cfg, const std::vector<std::string> &inputs,
+                   bool dry_run, bool output_jsonl, const std::string &export_path) {
+  aethersense::MultiStreamRunner runner;
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    auto stream_cfg = cfg;
+    stream_cfg.io.path = inputs[i];
+    stream_cfg.io.checkpoint_path = cfg.io.checkpoint_path + "." + std::to_string(i);
+    auto valid = aethersense::ValidateConfig(stream_cfg, true);
+    if (!valid.ok()) {
+      std::cerr << "Config validation error: " << valid.error().message << "\n";
+      return 4;
+    }
+    auto added = runner.AddStream(stream_cfg);
+    if (!added.ok()) {
+      std::cerr << "Reader error: " << added.error().message << "\n";
+      return 5;
+    }
+  }
+
+  if (dry_run) {
+    std::cout << "dry-run ok\n";
+    return 0;
+  }
+
+  std::ofstream export_file;
+  if (!export_path.empty()) {
+    export_file.open(export_path);
+    export_file << "stream,timestamp_ns,energy_motion,energy_breathing,present\n";
+  }
+
+  std::mutex output_mutex;
+  const auto result = runner.Run(cfg.runtime.worker_threads, [&](std::size_t stream,
+                                                                   const aethersense::Decision &d) {
+    if (!output_jsonl && !export_file) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(output_mutex);
+    if (output_jsonl) {
+      std::cout << "{\"stream\":" << stream << ",\"timestamp_ns\":" << d.timestamp_ns
+                << ",\"energy_motion\":" << d.energy_motion
+                << ",\"present\":" << (d.present ? "true" : "false") << "}\n";
+    }
+    if (export_file) {
+      export_file << stream << ',' << d.timestamp_ns << ',' << d.energy_motion << ','
+                  << d.energy_breathing << ',' << (d.present ? 1 : 0) << '\n';
+    }
+  });
+
+  for (std::size_t i = 0; i < runner.size(); ++i) {
+    const auto &s = runner.stream(i);
+    if (s.error.has_value()) {
+      std::cerr << "stream " << i << " (" << inputs[i] << "): " << s.error->message << "\n";
+      continue;
+    }
+    if (!output_jsonl && s.decisions_total > 0) {
+      const double present_ratio =
+          static_cast<double>(s.present_total) / static_cast<double>(s.decisions_total);
+      const double avg_energy = s.energy_sum / static_cast<double>(s.decisions_total);
+      std::cout << "stream " << i << " final decisions=" << s.decisions_total
+                << " present_ratio=" << present_ratio << " energy_motion=" << avg_energy
+                << " windows_rejected=" << s.metrics.windows_rejected_total << "\n";
+    }
+  }
+  return result.ok() ? 0 : 6;
+}
+
+// `convert --input <capture> --output <capture> [--format csv|jsonl|binary|compressed]
+// [--to binary|compressed] [--codec lossless|int16] [--block-frames N] [--config <json>]`
+// rewrites a capture as a binary (default) or compressed one. Corrupt records are skipped as in
+// a replay; io settings other than the mode, start position and checkpoint come from --config.
+int RunConvert(int argc, char **argv) {
+  std::string config_path;
+  std::string input;
+  std::string output;
+  std::string format;
+  std::string to = "binary";
+  aethersense::WriterOptions options;
+  for (int i = 2; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--config" && i + 1 < argc) {
+      config_path = argv[++i];
+    } else if (arg == "--input" && i + 1 < argc) {
+      input = argv[++i];
+    } else if (arg == "--output" && i + 1 < argc) {
+      output = argv[++i];
+    } else if (arg == "--format" && i + 1 < argc) {
+      format = argv[++i];
+    } else if (arg == "--to" && i + 1 < argc) {
+      to = argv[++i];
+    } else if (arg == "--codec" && i + 1 < argc) {
+      options.codec = argv[++i];
+    } else if (arg == "--block-frames" && i + 1 < argc) {
+      std::uint64_t frames = 0;
+      if (!ParseTimestamp(argv[++i], frames)) {
+        std::cerr << "--block-frames takes a frame count\n";
+        return 2;
+      }
+      options.block_frames = static_cast<std::size_t>(frames);
+    }
+  }
+  if (input.empty() || output.empty()) {
+    std::cerr << "convert requires --input and --output\n";
+    return 2;
+  }
+
+  aethersense::Config cfg;
+  if (!config_path.empty()) {
+    auto config = aethersense::LoadConfigFromJsonFile(config_path);
+    if (!config.ok()) {
+      std::cerr << "Config error: " << config.error().message << "\n";
+      return 3;
+    }
+    cfg = config.value();
+  }
+  if (format.empty()) {
+    format = input.ends_with(".jsonl") ? "jsonl" : "csv";
+  }
+  if (format != "csv" && format != "jsonl" && format != "binary" && format != "compressed") {
+    std::cerr << "convert reads csv, jsonl, binary or compressed, not " << format << "\n";
+    return 2;
+  }
+  cfg.io.format = format;
+  cfg.io.path = input;
+  cfg.io.mode = "file";
+  cfg.io.start_position = "begin";
+  cfg.io.checkpoint_path.clear(); // no checkpoint file for a one-off conversion
+  auto valid = aethersense::ValidateConfig(cfg, true);
+  if (!valid.ok()) {
+    std::cerr << "Config validation error: " << valid.error().message << "\n";
+    return 4;
+  }
+
+  auto reader = aethersense::CreateReader(cfg.io, input);
+  if (!reader.ok()) {
+    std::cerr << "Reader error: " << reader.error().message << "\n";
+    return 5;
+  }
+  auto writer = aethersense::CreateWriter(to, output, options);
+  if (!writer.ok()) {
+    std::cerr << "Writer error: " << writer.error().message << "\n";
+    return 8;
+  }
+  aethersense::CsiFrame frame;
+  while (true) {
+    auto got = reader.value()->next_into(frame);
+    if (!got.ok()) {
+      std::cerr << "Read error: " << got.error().message << "\n";
+      return 6;
+    }
+    if (!got.value()) {
+      break;
+    }
+    auto written = writer.value()->write(aethersense::MakeFrameView(frame));
+    if (!written.ok()) {
+      std::cerr << "Writer error at timestamp_ns=" << frame.timestamp_ns << ": "
+                << written.error().message << "\n";
+      return 8;
+    }
+  }
+  auto closed = writer.value()->close();
+  if (!closed.ok()) {
+    std::cerr << "Writer error: " << closed.error().message << "\n";
+    return 8;
+  }
+  std::cout << "converted frames=" << writer.value()->frames_written()
+            << " corrupt=" << reader.value()->stream_stats().records_corrupt_total << " to "
+            << output << "\n";
+  return 0;
+}
+
+// `index --input <capture> [--format csv|jsonl|binary|compressed] [--config <json>]` builds (or
+// rebuilds) the sidecar timestamp index that --from-ts uses, so the first range query does not
+// pay for it.
+int RunIndex(int argc, char **argv) {
+  std::string config_path;
+  std::string input;
+  std::string format;
+  for (int i = 2; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--config" && i + 1 < argc) {
+      config_path = argv[++i];
+    } else if (arg == "--input" && i + 1 < argc) {
+      input = argv[++i];
+    } else if (arg == "--format" && i + 1 < argc) {
+      format = argv[++i];
+    }
+  }
+  if (input.empty()) {
+    std::cerr << "index requires --input\n";
+    return 2;
+  }
+
+  aethersense::Config cfg;
+  if (!config_path.empty()) {
+    auto config = aethersense::LoadConfigFromJsonFile(config_path);
+    if (!config.ok()) {
+      std::cerr << "Config error: " << config.error().message << "\n";
+      return 3;
+    }
+    cfg = config.value();
+  }
+  if (!format.empty()) {
+    cfg.io.format = format;
+  } else if (input.ends_with(".jsonl")) {
+    cfg.io.format = "jsonl";
+  }
+  cfg.io.path = input;
+  cfg.io.mode = "file";
+  auto valid = aethersense::ValidateConfig(cfg, true);
+  if (!valid.ok()) {
+    std::cerr << "Config validation error: " << valid.error().message << "\n";
+    return 4;
+  }
+
+  auto index = aethersense::io::BuildCaptureIndex(cfg.io, input);
+  if (!index.ok()) {
+    std::cerr << "Index error: " << index.error().message << "\n";
+    return 5;
+  }
+  const std::string index_path = aethersense::io::CaptureIndexPath(input);
+  auto written = aethersense::io::WriteCaptureIndex(index_path, index.value());
+  if (!written.ok()) {
+    std::cerr << "Index error: " << written.error().message << "\n";
+    return 8;
+  }
+  std::cout << "indexed frames=" << index.value().frames_total
+            << " entries=" << index.value().entries.size() << " to " << index_path << "\n";
+  return 0;
+}
+
 } // namespace
 
 int main(int argc, char **argv) {
+  if (argc > 1 && std::string(argv[1]) == "convert") {
+    return RunConvert(argc, argv);
+  }
+  if (argc > 1 && std::string(argv[1]) == "index") {
+    return RunIndex(argc, argv);
+  }
   std::string config_path;
-  std::string input_override;
+  std::vector<std::string> inputs;
   std::string format_override;
   std::string export_path;
   bool dry_run = false;
   bool output_jsonl = false;
+  std::uint64_t from_ts = 0;
+  std::uint64_t to_ts = 0;
 
   for (int i = 1; i < argc; ++i) {
     const std::string arg = argv[i];
     if (arg == "--config" && i + 1 < argc) {
       config_path = argv[++i];
     } else if (arg == "--input" && i + 1 < argc) {
-      input_override = argv[++i];
+      inputs.emplace_back(argv[++i]);
     } else if (arg == "--format" && i + 1 < argc) {
       format_override = argv[++i];
     } else if (arg == "--export-decisions" && i + 1 < argc) {
       export_path = argv[++i];
     } else if (arg == "--output" && i + 1 < argc) {
       output_jsonl = std::string(argv[++i]) == "jsonl";
+    } else if ((arg == "--from-ts" || arg == "--to-ts") && i + 1 < argc) {
+      if (!ParseTimestamp(argv[++i], arg == "--from-ts" ? from_ts : to_ts)) {
+        std::cerr << arg << " takes a timestamp in ns\n";
+        return 2;
+      }
     } else if (arg == "--print-config-schema") {
       PrintSchema();
       return 0;
@@ -60,12 +332,23 @@ int main(int argc, char **argv) {
     return 3;
   }
   auto cfg = config.value();
-  if (!input_override.empty()) {
-    cfg.io.path = input_override;
-  }
   if (!format_override.empty()) {
     cfg.io.format = format_override;
   }
+  if (to_ts > 0 && from_ts > to_ts) {
+    std::cerr << "--from-ts is after --to-ts\n";
+    return 2;
+  }
+  if (inputs.size() > 1) {
+    if (from_ts > 0 || to_ts > 0) {
+      std::cerr << "--from-ts/--to-ts take a single --input\n";
+      return 2;
+    }
+    return RunMultiStream(cfg, inputs, dry_run, output_jsonl, export_path);
+  }
+  if (!inputs.empty()) {
+    cfg.io.path = inputs.front();
+  }
 
   auto valid = aethersense::ValidateConfig(cfg, true);
   if (!valid.ok()) {
@@ -73,6 +356,12 @@ int main(int argc, char **argv) {
     return 4;
   }
 
+  auto ranged = ApplyTimeRange(cfg, from_ts, to_ts);
+  if (!ranged.ok()) {
+    std::cerr << "Index error: " << ranged.error().message << "\n";
+    return 5;
+  }
+
   auto reader = aethersense::CreateReader(cfg.io, cfg.io.path);
   if (!reader.ok()) {
     std::cerr << "Reader error: " << reader.error().message << "\n";
@@ -90,60 +379,52 @@ int main(int argc, char **argv) {
     export_file << "timestamp_ns,energy_motion,energy_breathing,present\n";
   }
 
-  aethersense::Pipeline pipeline(cfg);
-  aethersense::RuntimeMetrics metrics;
+  // Parsing runs on a reader thread, DSP on this one; a binary capture is processed in place here.
+  aethersense::PipelinedRunner runner(cfg, std::move(reader.value()));
 
   std::size_t decisions_total = 0;
   std::size_t present_total = 0;
   double energy_sum = 0.0;
   const auto report_start = std::chrono::steady_clock::now();
 
-  while (true) {
-    auto frame_result = reader.value()->next();
-    if (!frame_result.ok()) {
-      std::cerr << "Read error: " << frame_result.error().message << "\n";
-      return 6;
+  const auto result = runner.Run([&](const aethersense::Decision &decision,
+                                     const aethersense::RuntimeMetrics &metrics) {
+    if (decision.timestamp_ns < from_ts) {
+      return;
     }
-    if (!frame_result.value().has_value()) {
-      if (cfg.io.mode == "tail") {
-        continue;
-      }
-      break;
+    ++decisions_total;
+    energy_sum += decision.energy_motion;
+    if (decision.present) {
+      ++present_total;
     }
-
-    ++metrics.frames_read_total;
-    auto decision = pipeline.ProcessFrame(*frame_result.value(), metrics);
-    if (!decision.ok()) {
-      std::cerr << "Pipeline error: " << decision.error().message << "\n";
-      return 7;
+    const auto total_s =
+        std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - report_start).count();
+    const double fps = total_s > 0 ? metrics.frames_read_total / total_s : 0.0;
+    if (output_jsonl) {
+      const auto st = runner.stream_stats();
+      std::cout << "{\"timestamp_ns\":" << decision.timestamp_ns
+                << ",\"energy_motion\":" << decision.energy_motion
+                << ",\"present\":" << (decision.present ? "true" : "false")
+                << ",\"fps\":" << fps << ",\"p50_us\":" << metrics.Percentile(50)
+                << ",\"p95_us\":" << metrics.Percentile(95)
+                << ",\"drops\":" << metrics.frames_dropped_total
+                << ",\"depth\":" << metrics.ring_buffer_depth
+                << ",\"corrupt\":" << st.records_corrupt_total << "}\n";
     }
-
-    if (decision.value().has_value()) {
-      ++decisions_total;
-      energy_sum += decision.value()->energy_motion;
-      if (decision.value()->present) {
-        ++present_total;
-      }
-      const auto total_s =
-          std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - report_start).count();
-      const double fps = total_s > 0 ? metrics.frames_read_total / total_s : 0.0;
-      if (output_jsonl) {
-        const auto st = reader.value()->stream_stats();
-        std::cout << "{\"timestamp_ns\":" << decision.value()->timestamp_ns
-                  << ",\"energy_motion\":" << decision.value()->energy_motion
-                  << ",\"present\":" << (decision.value()->present ? "true" : "false")
-                  << ",\"fps\":" << fps << ",\"p50_us\":" << metrics.Percentile(50)
-                  << ",\"p95_us\":" << metrics.Percentile(95)
-                  << ",\"drops\":" << metrics.frames_dropped_total
-                  << ",\"corrupt\":" << st.records_corrupt_total << "}\n";
-      }
-      if (export_file) {
-        export_file << decision.value()->timestamp_ns << ',' << decision.value()->energy_motion
-                    << ',' << decision.value()->energy_breathing << ','
-                    << (decision.value()->present ? 1 : 0) << '\n';
-      }
+    if (export_file) {
+      export_file << decision.timestamp_ns << ',' << decision.energy_motion << ','
+                  << decision.energy_breathing << ',' << (decision.present ? 1 : 0) << '\n';
+    }
+  });
+  if (!result.ok()) {
+    if (runner.read_error().has_value()) {
+      std::cerr << "Read error: " << result.error().message << "\n";
+      return 6;
     }
+    std::cerr << "Pipeline error: " << result.error().message << "\n";
+    return 7;
   }
+  const auto &metrics = runner.metrics();
 
   if (!output_jsonl && decisions_total > 0) {
     const double present_ratio =
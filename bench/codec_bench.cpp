@@ -0,0 +1,144 @@
+// Compressed capture block codec on 3x3 links x 242 subcarriers: encode and decode throughput
+// (MB/s of float32 samples) and the compressed size against float32 samples and CSV text, for
+// both codecs and three kinds of data:
+//   integer   - integer-valued samples, as most NICs report CSI (raw int8/int16 I/Q)
+//   channel   - a slowly drifting channel plus small float noise
+//   noise     - independent gaussian samples; the worst case for the lossless codec
+//
+//   ./build/bench/aethersense_bench_codec [frames] [block_frames]
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "aethersense/io/compressed_capture.hpp"
+
+namespace {
+
+constexpr std::size_t kSamplesPerFrame = 3 * 3 * 242;
+
+struct Dataset {
+  std::string name;
+  std::vector<std::uint64_t> timestamps;
+  std::vector<std::complex<float>> samples;
+};
+
+Dataset MakeDataset(const std::string &name, std::size_t frames) {
+  std::mt19937 rng(11);
+  std::normal_distribution<float> gauss(0.0F, 1.0F);
+  std::uniform_real_distribution<float> uniform(0.0F, 6.2831853F);
+  Dataset d{name, {}, {}};
+  std::vector<float> gain(kSamplesPerFrame);
+  std::vector<float> phase(kSamplesPerFrame);
+  for (std::size_t s = 0; s < kSamplesPerFrame; ++s) {
+    gain[s] = 20.0F + 5.0F * gauss(rng);
+    phase[s] = uniform(rng);
+  }
+  for (std::size_t t = 0; t < frames; ++t) {
+    // 100 Hz with a little jitter.
+    d.timestamps.push_back(1000000000ULL + t * 10000000ULL + static_cast<std::uint64_t>(rng() % 50000));
+    for (std::size_t s = 0; s < kSamplesPerFrame; ++s) {
+      const float drift = phase[s] + 0.002F * static_cast<float>(t);
+      std::complex<float> v = std::polar(gain[s], drift);
+      if (name == "integer") {
+        v = {std::round(v.real() + 0.7F * gauss(rng)), std::round(v.imag() + 0.7F * gauss(rng))};
+      } else if (name == "channel") {
+        v += std::complex<float>(0.05F * gauss(rng), 0.05F * gauss(rng));
+      } else {
+        v = {gauss(rng), gauss(rng)};
+      }
+      d.samples.push_back(v);
+    }
+  }
+  return d;
+}
+
+// Size of the frames as CSV records with six decimals, the text capture they would replace.
+std::size_t CsvBytes(const Dataset &d) {
+  std::size_t bytes = 0;
+  char number[32];
+  for (const auto &v : d.samples) {
+    bytes += static_cast<std::size_t>(std::snprintf(number, sizeof(number), "%.6f;", v.real()));
+    bytes += static_cast<std::size_t>(std::snprintf(number, sizeof(number), "%.6f;", v.imag()));
+  }
+  return bytes + d.timestamps.size() * 36;
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Run(const Dataset &d, aethersense::io::CsiCodec codec, std::size_t block_frames,
+         std::size_t passes) {
+  const std::size_t frames = d.timestamps.size();
+  const double raw_mb = static_cast<double>(d.samples.size() * sizeof(std::complex<float>)) / 1e6;
+
+  std::vector<char> encoded;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    encoded.clear();
+    for (std::size_t first = 0; first < frames; first += block_frames) {
+      const std::size_t n = std::min(block_frames, frames - first);
+      aethersense::io::EncodeCsiBlock(
+          codec, std::span(d.timestamps).subspan(first, n),
+          std::span(d.samples).subspan(first * kSamplesPerFrame, n * kSamplesPerFrame), encoded);
+    }
+  }
+  const double encode_s = Seconds(start) / static_cast<double>(passes);
+
+  std::vector<std::uint64_t> timestamps;
+  std::vector<std::complex<float>> samples;
+  std::size_t decoded = 0;
+  start = std::chrono::steady_clock::now();
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    for (std::size_t pos = 0; pos < encoded.size();) {
+      const std::size_t bytes = aethersense::io::CheckCsiBlock(encoded.data() + pos, encoded.size() - pos);
+      if (bytes == 0 ||
+          !aethersense::io::DecodeCsiBlock(encoded.data() + pos, kSamplesPerFrame, block_frames,
+                                           timestamps, samples)) {
+        std::cerr << "decode failed at byte " << pos << "\n";
+        std::exit(1);
+      }
+      decoded += timestamps.size();
+      pos += bytes;
+    }
+  }
+  const double decode_s = Seconds(start) / static_cast<double>(passes);
+  if (decoded != frames * passes) {
+    std::cerr << "decoded " << decoded << " of " << frames * passes << " frames\n";
+    std::exit(1);
+  }
+
+  const double size = static_cast<double>(encoded.size());
+  std::printf("%-8s %-8s encode %6.0f MB/s  decode %6.0f MB/s  float32 %5.2fx  csv %5.2fx\n",
+              d.name.c_str(), codec == aethersense::io::CsiCodec::kLossless ? "lossless" : "int16",
+              raw_mb / encode_s, raw_mb / decode_s,
+              static_cast<double>(d.samples.size() * sizeof(std::complex<float>)) / size,
+              static_cast<double>(CsvBytes(d)) / size);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::size_t frames = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+  const std::size_t block_frames = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+  if (block_frames == 0 || block_frames > aethersense::io::kMaxBlockFrames) {
+    std::cerr << "block_frames must be in [1, 65535]\n";
+    return 2;
+  }
+  constexpr std::size_t kPasses = 3;
+  for (const char *name : {"integer", "channel", "noise"}) {
+    const auto dataset = MakeDataset(name, frames);
+    Run(dataset, aethersense::io::CsiCodec::kLossless, block_frames, kPasses);
+    Run(dataset, aethersense::io::CsiCodec::kInt16, block_frames, kPasses);
+  }
+  return 0;
+}
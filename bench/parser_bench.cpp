@@ -0,0 +1,254 @@
+// Record parsing throughput for 3x3 links x 242 subcarriers: the single-pass from_chars parsers
+// (into a reused frame) against the previous stringstream + std::stof implementation, kept
+// here as the baseline, and the same frames replayed from a mapped binary capture.
+//
+//   ./build/bench/aethersense_bench_parser [records]
+
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/types.hpp"
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/io/record_recovery.hpp"
+
+namespace {
+
+using aethersense::CsiFrame;
+
+constexpr int kRx = 3;
+constexpr int kTx = 3;
+constexpr int kSubcarriers = 242;
+
+namespace legacy {
+
+std::vector<std::string> Split(const std::string &value, char delim) {
+  std::stringstream ss(value);
+  std::string part;
+  std::vector<std::string> out;
+  while (std::getline(ss, part, delim)) {
+    out.push_back(part);
+  }
+  return out;
+}
+
+std::optional<CsiFrame> ParseCsv(const std::string &line) {
+  const auto cols = Split(line, ',');
+  if (cols.size() != 7) {
+    return std::nullopt;
+  }
+  CsiFrame frame;
+  try {
+    frame.timestamp_ns = std::stoull(cols[0]);
+    frame.center_freq_hz = std::stoull(cols[1]);
+    frame.rx_count = static_cast<std::uint8_t>(std::stoi(cols[2]));
+    frame.tx_count = static_cast<std::uint8_t>(std::stoi(cols[3]));
+    frame.subcarrier_count = static_cast<std::uint16_t>(std::stoi(cols[4]));
+    std::vector<float> re;
+    std::vector<float> im;
+    for (const auto &token : Split(cols[5], ';')) {
+      re.push_back(std::stof(token));
+    }
+    for (const auto &token : Split(cols[6], ';')) {
+      im.push_back(std::stof(token));
+    }
+    if (re.size() != im.size()) {
+      return std::nullopt;
+    }
+    for (std::size_t i = 0; i < re.size(); ++i) {
+      frame.data.emplace_back(re[i], im[i]);
+    }
+  } catch (...) {
+    return std::nullopt;
+  }
+  return frame;
+}
+
+std::optional<CsiFrame> ParseJsonl(const std::string &line) {
+  auto grab = [&](const std::string &key) {
+    const auto p = line.find("\"" + key + "\"");
+    const auto c = line.find(':', p);
+    auto end = line.find_first_of(",}", c + 1);
+    return line.substr(c + 1, end - c - 1);
+  };
+  auto array = [&](const std::string &key) {
+    const auto p = line.find("\"" + key + "\"");
+    const auto b = line.find('[', p);
+    const auto e = line.find(']', b);
+    return line.substr(b + 1, e - b - 1);
+  };
+  CsiFrame frame;
+  try {
+    frame.timestamp_ns = std::stoull(grab("timestamp_ns"));
+    frame.center_freq_hz = std::stoull(grab("center_freq_hz"));
+    frame.rx_count = static_cast<std::uint8_t>(std::stoi(grab("rx")));
+    frame.tx_count = static_cast<std::uint8_t>(std::stoi(grab("tx")));
+    frame.subcarrier_count = static_cast<std::uint16_t>(std::stoi(grab("subcarrier_count")));
+    std::vector<float> re;
+    std::vector<float> im;
+    for (const auto &token : Split(array("data_re"), ',')) {
+      re.push_back(std::stof(token));
+    }
+    for (const auto &token : Split(array("data_im"), ',')) {
+      im.push_back(std::stof(token));
+    }
+    if (re.size() != im.size()) {
+      return std::nullopt;
+    }
+    for (std::size_t i = 0; i < re.size(); ++i) {
+      frame.data.emplace_back(re[i], im[i]);
+    }
+  } catch (...) {
+    return std::nullopt;
+  }
+  return frame;
+}
+
+} // namespace legacy
+
+std::vector<std::string> MakeRecords(std::size_t count, bool jsonl) {
+  std::mt19937 rng(7);
+  std::normal_distribution<float> sample(0.0F, 1.0F);
+  std::vector<std::string> records;
+  records.reserve(count);
+  char number[32];
+  for (std::size_t r = 0; r < count; ++r) {
+    const char sep = jsonl ? ',' : ';';
+    std::string re;
+    std::string im;
+    for (int i = 0; i < kRx * kTx * kSubcarriers; ++i) {
+      std::snprintf(number, sizeof(number), "%.6f", sample(rng));
+      re += (i == 0 ? "" : std::string(1, sep)) + number;
+      std::snprintf(number, sizeof(number), "%.6f", sample(rng));
+      im += (i == 0 ? "" : std::string(1, sep)) + number;
+    }
+    const std::string ts = std::to_string(1000000000ULL + r * 10000000ULL);
+    if (jsonl) {
+      records.push_back("{\"timestamp_ns\":" + ts +
+                        ",\"center_freq_hz\":5800000000,\"rx\":3,\"tx\":3,"
+                        "\"subcarrier_count\":242,\"data_re\":[" +
+                        re + "],\"data_im\":[" + im + "]}");
+    } else {
+      records.push_back(ts + ",5800000000,3,3,242," + re + "," + im);
+    }
+  }
+  return records;
+}
+
+struct Throughput {
+  double mb_per_s{0.0};
+  double frames_per_s{0.0};
+};
+
+Throughput ToThroughput(std::size_t bytes, std::size_t frames,
+                        std::chrono::steady_clock::time_point start) {
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return {static_cast<double>(bytes) / 1e6 / seconds, static_cast<double>(frames) / seconds};
+}
+
+// Parses every record `passes` times; MB/s are of record text.
+template <typename Parse>
+Throughput Measure(const std::vector<std::string> &records, std::size_t passes, Parse &&parse) {
+  std::size_t bytes = 0;
+  std::size_t parsed = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    for (const auto &record : records) {
+      parsed += parse(record) ? 1 : 0;
+      bytes += record.size();
+    }
+  }
+  const auto throughput = ToThroughput(bytes, parsed, start);
+  if (parsed != records.size() * passes) {
+    std::cerr << "parse failures: " << records.size() * passes - parsed << "\n";
+    std::exit(1);
+  }
+  return throughput;
+}
+
+// Replays a binary capture `passes` times through `read`, which takes an open reader and
+// returns false at the end; MB/s are of capture bytes.
+template <typename Read>
+Throughput MeasureBinary(const std::string &path, std::size_t frames, std::size_t passes,
+                         Read &&read) {
+  std::size_t read_frames = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    aethersense::io::BinaryCaptureReader reader(aethersense::Config::Io{.checkpoint_path = ""});
+    if (!reader.Open(path).ok()) {
+      std::cerr << "cannot open " << path << "\n";
+      std::exit(1);
+    }
+    while (read(reader)) {
+      ++read_frames;
+    }
+  }
+  const auto throughput =
+      ToThroughput(std::filesystem::file_size(path) * passes, read_frames, start);
+  if (read_frames != frames * passes) {
+    std::cerr << "binary read failures: " << frames * passes - read_frames << "\n";
+    std::exit(1);
+  }
+  return throughput;
+}
+
+void Report(const std::string &name, Throughput t) {
+  std::cout << name << ": " << static_cast<std::uint64_t>(t.mb_per_s) << " MB/s, "
+            << static_cast<std::uint64_t>(t.frames_per_s) << " frames/s\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+  constexpr std::size_t kPasses = 5;
+
+  for (const bool jsonl : {false, true}) {
+    const auto records = MakeRecords(count, jsonl);
+    const std::string format = jsonl ? "JSONL" : "CSV  ";
+    Report(format + " stringstream + stof", Measure(records, kPasses, [&](const std::string &r) {
+             return jsonl ? legacy::ParseJsonl(r).has_value() : legacy::ParseCsv(r).has_value();
+           }));
+    CsiFrame frame;
+    Report(format + " from_chars, in place", Measure(records, kPasses, [&](const std::string &r) {
+             const auto status = jsonl ? aethersense::io::ParseJsonlRecordInto(r, frame)
+                                       : aethersense::io::ParseCsvRecordInto(r, frame);
+             return !status.corrupt;
+           }));
+  }
+
+  const std::string capture = "parser_bench_capture.bin";
+  {
+    aethersense::io::BinaryCaptureWriter writer;
+    CsiFrame frame;
+    if (!writer.Open(capture).ok()) {
+      std::cerr << "cannot write " << capture << "\n";
+      return 1;
+    }
+    for (const auto &record : MakeRecords(count, false)) {
+      aethersense::io::ParseCsvRecordInto(record, frame);
+      writer.write(aethersense::MakeFrameView(frame));
+    }
+    writer.close();
+  }
+  aethersense::FrameView view;
+  Report("binary, mapped views", MeasureBinary(capture, count, kPasses, [&](auto &reader) {
+           return reader.next_view(view).value();
+         }));
+  CsiFrame frame;
+  Report("binary, into frame", MeasureBinary(capture, count, kPasses, [&](auto &reader) {
+           return reader.next_into(frame).value();
+         }));
+  std::filesystem::remove(capture);
+  return 0;
+}
@@ -0,0 +1,133 @@
+// Throughput of the mutex-based RingBuffer against the lock-free SpscRingBuffer for one
+// producer thread and one consumer thread moving CsiFrame values, item by item and in batches.
+//
+//   ./build/bench/aethersense_bench_ring_buffer [frames]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aethersense/core/types.hpp"
+#include "aethersense/runtime/ring_buffer.hpp"
+#include "aethersense/runtime/spsc_ring_buffer.hpp"
+
+namespace {
+
+using aethersense::BackpressurePolicy;
+using aethersense::CsiFrame;
+
+constexpr std::size_t kCapacity = 1024;
+constexpr std::chrono::milliseconds kTimeout(100);
+
+// Runs `produce` and `consume` on two threads; returns frames per second.
+template <typename Produce, typename Consume>
+double Measure(std::size_t frames, Produce &&produce, Consume &&consume) {
+  const auto start = std::chrono::steady_clock::now();
+  std::thread producer([&] { produce(frames); });
+  const std::size_t received = consume();
+  producer.join();
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (received != frames) {
+    std::cerr << "lost frames: " << received << " of " << frames << "\n";
+    std::exit(1);
+  }
+  return static_cast<double>(frames) / seconds;
+}
+
+template <typename Ring> std::size_t ConsumeSingle(Ring &ring) {
+  std::size_t received = 0;
+  std::vector<CsiFrame> batch;
+  while (true) {
+    // One item per call.
+    if (ring.pop_batch(batch, 1, kTimeout) == 0) {
+      if (ring.closed() && ring.size() == 0) {
+        return received;
+      }
+      continue;
+    }
+    ++received;
+  }
+}
+
+template <typename Ring> std::size_t ConsumeBatched(Ring &ring, std::size_t batch_size) {
+  std::size_t received = 0;
+  std::vector<CsiFrame> batch;
+  batch.reserve(batch_size);
+  while (true) {
+    const std::size_t n = ring.pop_batch(batch, batch_size, kTimeout);
+    if (n == 0) {
+      if (ring.closed() && ring.size() == 0) {
+        return received;
+      }
+      continue;
+    }
+    received += n;
+  }
+}
+
+template <typename Ring> void ProduceSingle(Ring &ring, std::size_t frames) {
+  for (std::size_t i = 0; i < frames; ++i) {
+    CsiFrame frame;
+    frame.timestamp_ns = i;
+    while (!ring.push(std::move(frame), BackpressurePolicy::kBlock, kTimeout)) {
+    }
+  }
+  ring.close();
+}
+
+void Report(const std::string &name, double fps) {
+  std::cout << name << ": " << static_cast<std::uint64_t>(fps) << " frames/s\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::size_t frames = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  constexpr std::size_t kBatch = 16;
+
+  {
+    aethersense::RingBuffer<CsiFrame> ring(kCapacity);
+    Report("RingBuffer      push/pop        ",
+           Measure(frames, [&](std::size_t n) { ProduceSingle(ring, n); },
+                   [&] { return ConsumeSingle(ring); }));
+  }
+  {
+    aethersense::SpscRingBuffer<CsiFrame> ring(kCapacity);
+    Report("SpscRingBuffer  push/pop        ",
+           Measure(frames, [&](std::size_t n) { ProduceSingle(ring, n); },
+                   [&] { return ConsumeSingle(ring); }));
+  }
+  {
+    aethersense::RingBuffer<CsiFrame> ring(kCapacity);
+    Report("RingBuffer      push/pop_batch  ",
+           Measure(frames, [&](std::size_t n) { ProduceSingle(ring, n); },
+                   [&] { return ConsumeBatched(ring, kBatch); }));
+  }
+  {
+    aethersense::SpscRingBuffer<CsiFrame> ring(kCapacity);
+    Report("SpscRingBuffer  push_batch/pop_batch",
+           Measure(
+               frames,
+               [&](std::size_t n) {
+                 std::vector<CsiFrame> chunk(kBatch);
+                 for (std::size_t i = 0; i < n; i += kBatch) {
+                   const std::size_t count = std::min(kBatch, n - i);
+                   for (std::size_t j = 0; j < count; ++j) {
+                     chunk[j].timestamp_ns = i + j;
+                   }
+                   std::size_t sent = 0;
+                   while (sent < count) {
+                     sent += ring.push_batch(std::span<CsiFrame>(chunk).subspan(sent, count - sent),
+                                             BackpressurePolicy::kBlock, kTimeout);
+                   }
+                 }
+                 ring.close();
+               },
+               [&] { return ConsumeBatched(ring, kBatch); }));
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+// Tail-mode append-to-read latency: a writer thread appends one line at a time and the reader
+// reports how long each line took to come out of read_next(), for the polling ("stream") and
+// inotify readers. Also reports the CPU time the reader used while mostly idle.
+//
+//   ./build/bench/aethersense_bench_tail_latency [lines] [gap_ms] [poll_interval_ms]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aethersense/io/stream_reader.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ThreadCpuMs() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<double>(ts.tv_sec) * 1e3 + static_cast<double>(ts.tv_nsec) / 1e6;
+#else
+  return 0.0;
+#endif
+}
+
+void Run(const std::string &kind, std::size_t lines, int gap_ms, int poll_interval_ms) {
+  const std::string path = "tail_latency_bench_" + kind + ".log";
+  std::ofstream(path, std::ios::trunc).close();
+
+  aethersense::Config::Io io;
+  io.mode = "tail";
+  io.reader = kind;
+  io.poll_interval_ms = poll_interval_ms;
+  io.checkpoint_path.clear();
+  auto reader = aethersense::io::CreateStreamReader(io);
+  if (!reader.ok() || !reader.value()->open(path).ok()) {
+    std::fprintf(stderr, "%s: cannot open reader\n", kind.c_str());
+    std::exit(1);
+  }
+
+  // Each line carries the steady-clock time at which it was written.
+  std::thread writer([&] {
+    std::ofstream out(path, std::ios::app);
+    for (std::size_t i = 0; i < lines; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(gap_ms));
+      out << Clock::now().time_since_epoch().count() << '\n' << std::flush;
+    }
+  });
+
+  std::vector<double> latency_us;
+  const double cpu_start = ThreadCpuMs();
+  const auto start = Clock::now();
+  while (latency_us.size() < lines) {
+    auto rec = reader.value()->read_next();
+    if (!rec.ok()) {
+      std::fprintf(stderr, "%s: %s\n", kind.c_str(), rec.error().message.c_str());
+      std::exit(1);
+    }
+    if (rec.value().line.empty()) {
+      continue;
+    }
+    const auto now = Clock::now().time_since_epoch().count();
+    const auto written = std::strtoll(std::string(rec.value().line).c_str(), nullptr, 10);
+    latency_us.push_back(static_cast<double>(now - written) / 1e3);
+  }
+  const double wall_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  const double cpu_ms = ThreadCpuMs() - cpu_start;
+  writer.join();
+  std::filesystem::remove(path);
+
+  std::sort(latency_us.begin(), latency_us.end());
+  const auto pct = [&](double p) {
+    return latency_us[std::min(latency_us.size() - 1,
+                               static_cast<std::size_t>(p * static_cast<double>(latency_us.size())))];
+  };
+  std::printf("%-8s p50 %9.1f us  p99 %9.1f us  max %9.1f us  reader cpu %6.1f ms / %7.0f ms\n",
+              kind.c_str(), pct(0.5), pct(0.99), latency_us.back(), cpu_ms, wall_ms);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+  const int gap_ms = argc > 2 ? std::atoi(argv[2]) : 5;
+  const int poll_interval_ms = argc > 3 ? std::atoi(argv[3]) : 50;
+  if (lines == 0 || gap_ms < 0 || poll_interval_ms <= 0) {
+    std::fprintf(stderr, "usage: aethersense_bench_tail_latency [lines] [gap_ms] [poll_interval_ms]\n");
+    return 2;
+  }
+  Run("stream", lines, gap_ms, poll_interval_ms);
+  Run("inotify", lines, gap_ms, poll_interval_ms);
+  return 0;
+}
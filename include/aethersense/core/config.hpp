@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "aethersense/core/errors.hpp"
@@ -11,21 +12,59 @@ struct Config {
   int config_version{3};
 
   struct Io {
+    // "csv" | "jsonl" | "binary" | "compressed" (io/binary_capture.hpp,
+    // io/compressed_capture.hpp; file mode only, read through their own mapping, so `reader`
+    // and `parse_threads` do not apply).
     std::string format{"csv"};
     std::string path{};
     std::string mode{"file"};
     std::string checkpoint_path{".aethersense.checkpoint"};
+    // Checkpoints are written in batches: after `checkpoint_every_records` records or
+    // `checkpoint_interval_ms` (checked as records arrive), whichever comes first; at the end of
+    // a file-mode replay, on rotation and when the reader closes; and once the interval has
+    // passed while a tail reader waits for input. A crash can replay up to one batch again.
+    //
+    // Every write replaces the file atomically. `checkpoint_fsync` also syncs it to disk, and
+    // `checkpoint_async` moves the writes off the reading thread.
+    std::size_t checkpoint_every_records{1000};
+    int checkpoint_interval_ms{1000};
+    bool checkpoint_fsync{false};
+    bool checkpoint_async{false};
+    // "begin" | "end" | "checkpoint" | "offset" (start at byte `start_offset`, which must be the
+    // start of a record; capture_index.hpp's SeekToTimestamp picks one for a timestamp).
     std::string start_position{"begin"};
+    std::uint64_t start_offset{0};
+    // When > 0, the replay ends at the first frame stamped later than this.
+    std::uint64_t stop_timestamp_ns{0};
     std::string rotate_handling{"reopen"};
+    // "auto" maps the file in file mode and waits on inotify in tail mode (polling where that is
+    // unavailable); "mmap" | "stream" | "inotify" force one ("stream" polls in tail mode).
+    std::string reader{"auto"};
+    // File mode only: threads parsing newline-aligned chunks of `parse_chunk_bytes` in parallel
+    // (1 = a single reader, 0 = one per core; chunks are at most 1 GiB). Frames are still
+    // delivered in file order; the parallel reader always maps the file, whatever `reader` says.
+    std::size_t parse_threads{1};
+    std::size_t parse_chunk_bytes{1U << 20U};
     float max_corrupt_ratio{0.25F};
     std::size_t max_partial_line_bytes{16384};
     int poll_interval_ms{100};
+    // Set by MultiStreamRunner on the readers it creates: at the end of a tail-mode file the
+    // reader reports no data at once instead of waiting io.poll_interval_ms, so an idle stream
+    // does not hold a worker. Not read from the config file.
+    bool tail_nonblocking{false};
     int max_consecutive_errors{32};
   } io;
 
   struct Dsp {
     std::size_t window_frames{32};
     std::size_t topk_subcarriers{1};
+    std::size_t hop_frames{1};
+    // Evaluated windows between top-K reselections; the selection is reused in between.
+    std::size_t topk_reselect_every{1};
+    // "averaged" folds all rx*tx links into one series per subcarrier; "per_link" keeps every
+    // link's series and fuses the per-link band energies with `link_fusion` (max|mean|median).
+    std::string link_mode{"averaged"};
+    std::string link_fusion{"max"};
 
     struct Smoothing {
       std::string type{"ema"};
@@ -36,6 +75,7 @@ struct Config {
     struct Fft {
       std::string window{"hann"};
       bool zero_pad_pow2{true};
+      std::string engine{"fft"};
     } fft;
 
     struct Resampling {
@@ -76,6 +116,8 @@ struct Config {
     float max_jitter_ratio{0.2F};
     std::string backpressure{"drop_oldest"};
     int report_every_seconds{1};
+    // Worker pool size for multi-stream runs; 0 uses the hardware concurrency.
+    std::size_t worker_threads{0};
   } runtime;
 
   struct Logging {
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "aethersense/core/types.hpp"
+
+namespace aethersense {
+
+class FramePool;
+
+// Move-only handle to a CsiFrame borrowed from a FramePool. Destroying (or overwriting) the
+// handle hands the frame back with its sample buffer intact, so the next Acquire() parses into
+// memory that is already allocated. A default-constructed handle is empty and owns nothing.
+class PooledFrame {
+public:
+  PooledFrame() = default;
+  ~PooledFrame() { Reset(); }
+
+  PooledFrame(PooledFrame &&other) noexcept
+      : pool_(std::exchange(other.pool_, nullptr)), frame_(std::move(other.frame_)) {}
+  PooledFrame &operator=(PooledFrame &&other) noexcept {
+    if (this != &other) {
+      Reset();
+      pool_ = std::exchange(other.pool_, nullptr);
+      frame_ = std::move(other.frame_);
+    }
+    return *this;
+  }
+  PooledFrame(const PooledFrame &) = delete;
+  PooledFrame &operator=(const PooledFrame &) = delete;
+
+  [[nodiscard]] explicit operator bool() const { return pool_ != nullptr; }
+  [[nodiscard]] CsiFrame &operator*() { return frame_; }
+  [[nodiscard]] const CsiFrame &operator*() const { return frame_; }
+  [[nodiscard]] CsiFrame *operator->() { return &frame_; }
+  [[nodiscard]] const CsiFrame *operator->() const { return &frame_; }
+
+  // Returns the frame to its pool now; the handle becomes empty.
+  void Reset();
+
+private:
+  friend class FramePool;
+  PooledFrame(FramePool *pool, CsiFrame &&frame) : pool_(pool), frame_(std::move(frame)) {}
+
+  FramePool *pool_{nullptr};
+  CsiFrame frame_;
+};
+
+// Thread-safe free list of CsiFrames for the reader -> ring buffer -> pipeline hand-off: the
+// reader acquires, the processing side drops the handle when done. At most `max_cached` idle
+// frames are kept; extra returns are freed. The pool must outlive every handle it hands out.
+class FramePool {
+public:
+  explicit FramePool(std::size_t max_cached = 256) : max_cached_(max_cached) {}
+
+  FramePool(const FramePool &) = delete;
+  FramePool &operator=(const FramePool &) = delete;
+
+  // A recycled frame (sample buffer cleared, capacity kept) or a new one if none is idle.
+  PooledFrame Acquire();
+
+  [[nodiscard]] std::size_t cached() const;
+  // Frames created because the free list was empty; flat once the pool is warm.
+  [[nodiscard]] std::size_t created_total() const;
+
+private:
+  friend class PooledFrame;
+  void Release(CsiFrame &&frame);
+
+  const std::size_t max_cached_;
+  mutable std::mutex mutex_;
+  std::vector<CsiFrame> free_;
+  std::size_t created_total_{0};
+};
+
+} // namespace aethersense
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 namespace aethersense::dsp {
 
 void RemoveCommonPhaseError(std::vector<std::vector<float>> &phase_by_sc, bool robust_median);
-void RemoveLinearTrend(std::vector<float> &series);
+// Same, collecting each time step's values in `scratch`.
+void RemoveCommonPhaseError(std::vector<std::vector<float>> &phase_by_sc, bool robust_median,
+                            std::vector<float> &scratch);
+// Single-frame form for ingest: subtracts the upper median of `phase_by_sc` (the robust CPE
+// above, found by partial selection in `scratch`) and returns it.
+float RemoveFrameCommonPhaseError(std::span<float> phase_by_sc, std::vector<float> &scratch);
+// Subtracts the line through the first and last samples.
+void RemoveLinearTrend(std::span<float> series);
 
 } // namespace aethersense::dsp
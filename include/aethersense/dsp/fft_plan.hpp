@@ -0,0 +1,65 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "aethersense/dsp/filters.hpp"
+#include "aethersense/dsp/window.hpp"
+
+namespace aethersense::dsp {
+
+// Precomputed tables for the band-energy FFT of a fixed-length real window: window
+// coefficients, bit-reversal permutation, twiddles and the band bin ranges. A power-of-two
+// transform runs as a half-length complex FFT plus a real-input split step.
+class FftPlan {
+public:
+  FftPlan() = default;
+  FftPlan(std::size_t signal_len, bool zero_pad_pow2, WindowType window);
+
+  [[nodiscard]] bool Matches(std::size_t signal_len, bool zero_pad_pow2, WindowType window) const;
+  [[nodiscard]] std::size_t signal_len() const { return signal_len_; }
+  [[nodiscard]] std::size_t fft_len() const { return fft_len_; }
+  [[nodiscard]] std::span<const float> window() const { return window_; }
+
+  void ApplyWindow(std::span<float> data) const;
+  // Same values as dsp::MagnitudeSpectrum: |X[k]| for k < fft_len / 2, into `out`.
+  void MagnitudeSpectrum(std::span<const float> signal, std::vector<float> &out);
+  // MagnitudeSpectrum of `count` equal-length signals stored back to back; `out` receives
+  // count rows of fft_len / 2 bins. The signals are interleaved and transformed together, so
+  // each butterfly stage loads its twiddle once and sweeps all signals contiguously.
+  void MagnitudeSpectra(std::span<const float> signals, std::size_t count,
+                        std::vector<float> &out);
+  // dsp::BandBins for this fft_len, cached per band until the sample rate changes.
+  BinRange BandBins(float sample_rate_hz, float low_hz, float high_hz);
+
+private:
+  struct CachedBand {
+    float sample_rate_hz;
+    float low_hz;
+    float high_hz;
+    BinRange bins;
+  };
+
+  // In-place transform of `count` interleaved fft_len / 2 point signals.
+  void ComplexFft(std::span<std::complex<float>> a, std::size_t count) const;
+
+  std::size_t signal_len_{0};
+  std::size_t fft_len_{0};
+  bool zero_pad_pow2_{true};
+  WindowType window_type_{WindowType::kHann};
+  std::vector<float> window_;
+  // Power-of-two path: tables for the fft_len / 2 complex transform and the split step.
+  std::vector<std::uint32_t> bit_reverse_;
+  std::vector<std::complex<float>> twiddles_;
+  std::vector<std::complex<float>> split_twiddles_;
+  // Other lengths: e^{-2 pi i k / fft_len} for a direct DFT.
+  std::vector<std::complex<float>> dft_twiddles_;
+  // Interleaved transform buffer: work_[i * count + signal].
+  std::vector<std::complex<float>> work_;
+  std::vector<CachedBand> bands_;
+};
+
+} // namespace aethersense::dsp
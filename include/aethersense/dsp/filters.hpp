@@ -6,19 +6,26 @@
 #include <cstddef>
 #include <cstdint>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "aethersense/dsp/order_statistics.hpp"
+
 namespace aethersense::dsp {
 
-inline float Median(std::vector<float> v) {
+// Median of `v` by partial selection, reordering it in place.
+inline float MedianInPlace(std::span<float> v) {
   if (v.empty()) {
     return 0.0F;
   }
-  std::sort(v.begin(), v.end());
   const std::size_t m = v.size() / 2;
-  return (v.size() % 2 == 0) ? 0.5F * (v[m - 1] + v[m]) : v[m];
+  const auto mid = v.begin() + static_cast<std::ptrdiff_t>(m);
+  std::nth_element(v.begin(), mid, v.end());
+  return (v.size() % 2 == 0) ? 0.5F * (*std::max_element(v.begin(), mid) + *mid) : *mid;
 }
 
+inline float Median(std::vector<float> v) { return MedianInPlace(v); }
+
 inline float MedianDeltaSeconds(const std::vector<std::uint64_t> &timestamps_ns) {
   if (timestamps_ns.size() < 2) {
     return 0.0F;
@@ -28,7 +35,7 @@ inline float MedianDeltaSeconds(const std::vector<std::uint64_t> &timestamps_ns)
   for (std::size_t i = 1; i < timestamps_ns.size(); ++i) {
     deltas.push_back(static_cast<float>(timestamps_ns[i] - timestamps_ns[i - 1]) / 1e9F);
   }
-  return Median(deltas);
+  return MedianInPlace(deltas);
 }
 
 inline float JitterRatio(const std::vector<std::uint64_t> &timestamps_ns, float median_dt) {
@@ -44,30 +51,39 @@ inline float JitterRatio(const std::vector<std::uint64_t> &timestamps_ns, float
   return max_ratio;
 }
 
-inline std::vector<float> UnwrapPhase(const std::vector<float> &phase) {
+// The *InPlace and output-span variants below let callers reuse their own buffers; the
+// vector-returning forms allocate their result and delegate to them.
+
+inline void UnwrapPhaseInPlace(std::span<float> phase) {
   if (phase.empty()) {
-    return {};
+    return;
   }
   constexpr float kPi = 3.14159265358979323846F;
   constexpr float kTwoPi = 2.0F * kPi;
-  std::vector<float> out(phase.size());
-  out[0] = phase[0];
+  float prev = phase[0];
   for (std::size_t i = 1; i < phase.size(); ++i) {
-    float delta = phase[i] - phase[i - 1];
+    const float raw = phase[i];
+    float delta = raw - prev;
     if (delta > kPi) {
       delta -= kTwoPi;
     } else if (delta < -kPi) {
       delta += kTwoPi;
     }
-    out[i] = out[i - 1] + delta;
+    phase[i] = phase[i - 1] + delta;
+    prev = raw;
   }
+}
+
+inline std::vector<float> UnwrapPhase(const std::vector<float> &phase) {
+  std::vector<float> out = phase;
+  UnwrapPhaseInPlace(out);
   return out;
 }
 
-inline std::vector<float> Detrend(const std::vector<float> &x) {
+inline void DetrendInPlace(std::span<float> x) {
   const std::size_t n = x.size();
   if (n < 2) {
-    return x;
+    return;
   }
   double sum_t = 0.0;
   double sum_y = 0.0;
@@ -85,41 +101,56 @@ inline std::vector<float> Detrend(const std::vector<float> &x) {
   const double slope = denom == 0.0 ? 0.0 : (n * sum_ty - sum_t * sum_y) / denom;
   const double intercept = (sum_y - slope * sum_t) / static_cast<double>(n);
 
-  std::vector<float> out(n);
   for (std::size_t i = 0; i < n; ++i) {
-    out[i] = static_cast<float>(x[i] - (slope * static_cast<double>(i) + intercept));
+    x[i] = static_cast<float>(x[i] - (slope * static_cast<double>(i) + intercept));
   }
+}
+
+inline std::vector<float> Detrend(const std::vector<float> &x) {
+  std::vector<float> out = x;
+  DetrendInPlace(out);
   return out;
 }
 
-inline std::vector<float> EmaSmooth(const std::vector<float> &x, float alpha) {
-  if (x.empty()) {
-    return {};
-  }
-  std::vector<float> out(x.size());
-  out[0] = x[0];
+inline void EmaSmoothInPlace(std::span<float> x, float alpha) {
   for (std::size_t i = 1; i < x.size(); ++i) {
-    out[i] = alpha * x[i] + (1.0F - alpha) * out[i - 1];
+    x[i] = alpha * x[i] + (1.0F - alpha) * x[i - 1];
   }
+}
+
+inline std::vector<float> EmaSmooth(const std::vector<float> &x, float alpha) {
+  std::vector<float> out = x;
+  EmaSmoothInPlace(out, alpha);
   return out;
 }
 
-inline std::vector<float> MedianSmooth(const std::vector<float> &x, int kernel) {
+// Writes the centred median of `x` into `out` (same size), sliding the window through `stats`.
+inline void MedianSmooth(std::span<const float> x, int kernel, std::span<float> out,
+                         OrderStatistics &stats) {
   if (x.empty() || kernel <= 1) {
-    return x;
+    std::copy(x.begin(), x.end(), out.begin());
+    return;
+  }
+  const std::size_t radius = static_cast<std::size_t>(kernel / 2);
+  stats.Reset(2 * radius + 1);
+  for (std::size_t i = 0; i < std::min(x.size(), radius); ++i) {
+    stats.Insert(x[i]);
   }
-  const int radius = kernel / 2;
-  std::vector<float> out(x.size());
   for (std::size_t i = 0; i < x.size(); ++i) {
-    std::vector<float> local;
-    for (int k = -radius; k <= radius; ++k) {
-      const int idx = static_cast<int>(i) + k;
-      if (idx >= 0 && idx < static_cast<int>(x.size())) {
-        local.push_back(x[static_cast<std::size_t>(idx)]);
-      }
+    if (i > radius) {
+      stats.Erase(x[i - radius - 1]);
     }
-    out[i] = Median(local);
+    if (i + radius < x.size()) {
+      stats.Insert(x[i + radius]);
+    }
+    out[i] = stats.Median();
   }
+}
+
+inline std::vector<float> MedianSmooth(const std::vector<float> &x, int kernel) {
+  std::vector<float> out(x.size());
+  OrderStatistics stats;
+  MedianSmooth(x, kernel, out, stats);
   return out;
 }
 
@@ -161,20 +192,28 @@ inline void FftInPlace(std::vector<std::complex<float>> &a) {
   }
 }
 
-inline std::vector<float> MagnitudeSpectrum(const std::vector<float> &signal, bool zero_pad_pow2) {
+// |X[k]| for k < fft_len / 2 into `mag`, transforming in `work`; both are resized as needed.
+inline void MagnitudeSpectrum(std::span<const float> signal, bool zero_pad_pow2,
+                              std::vector<std::complex<float>> &work, std::vector<float> &mag) {
   std::size_t n = signal.size();
   if (zero_pad_pow2) {
     n = NextPow2(n);
   }
-  std::vector<std::complex<float>> data(n, {0.0F, 0.0F});
+  work.assign(n, {0.0F, 0.0F});
   for (std::size_t i = 0; i < signal.size(); ++i) {
-    data[i] = {signal[i], 0.0F};
+    work[i] = {signal[i], 0.0F};
   }
-  FftInPlace(data);
-  std::vector<float> mag(n / 2, 0.0F);
+  FftInPlace(work);
+  mag.resize(n / 2);
   for (std::size_t i = 0; i < mag.size(); ++i) {
-    mag[i] = std::abs(data[i]);
+    mag[i] = std::abs(work[i]);
   }
+}
+
+inline std::vector<float> MagnitudeSpectrum(const std::vector<float> &signal, bool zero_pad_pow2) {
+  std::vector<std::complex<float>> work;
+  std::vector<float> mag;
+  MagnitudeSpectrum(signal, zero_pad_pow2, work, mag);
   return mag;
 }
 
@@ -193,6 +232,43 @@ inline float BandEnergy(const std::vector<float> &spectrum, float sample_rate_hz
   return energy;
 }
 
+// Half-open range of spectrum bins selected by a band; see BandBins.
+struct BinRange {
+  std::size_t first{0};
+  std::size_t last{0};
+
+  [[nodiscard]] bool empty() const { return first >= last; }
+  [[nodiscard]] std::size_t size() const { return empty() ? 0 : last - first; }
+};
+
+// Bins of a length-`fft_len` magnitude spectrum that BandEnergy integrates for [low_hz, high_hz].
+inline BinRange BandBins(float sample_rate_hz, float low_hz, float high_hz, std::size_t fft_len) {
+  BinRange out;
+  if (sample_rate_hz <= 0.0F) {
+    return out;
+  }
+  bool found = false;
+  for (std::size_t i = 0; i < fft_len / 2; ++i) {
+    const float freq = sample_rate_hz * static_cast<float>(i) / static_cast<float>(fft_len);
+    if (freq >= low_hz && freq <= high_hz) {
+      if (!found) {
+        out.first = i;
+        found = true;
+      }
+      out.last = i + 1;
+    }
+  }
+  return out;
+}
+
+inline float BandEnergy(std::span<const float> spectrum, BinRange bins) {
+  float energy = 0.0F;
+  for (std::size_t i = bins.first; i < std::min(bins.last, spectrum.size()); ++i) {
+    energy += spectrum[i] * spectrum[i];
+  }
+  return energy;
+}
+
 inline std::vector<std::size_t> TopKVariance(const std::vector<std::vector<float>> &series_by_sc,
                                              std::size_t k) {
   std::vector<std::pair<float, std::size_t>> variance_index;
@@ -212,9 +288,12 @@ inline std::vector<std::size_t> TopKVariance(const std::vector<std::vector<float
     var /= static_cast<float>(s.size());
     variance_index.push_back({var, sc});
   }
-  std::sort(variance_index.begin(), variance_index.end(),
-            [](const auto &a, const auto &b) { return a.first > b.first; });
   k = std::min(k, variance_index.size());
+  const auto by_variance = [](const auto &a, const auto &b) { return a.first > b.first; };
+  std::nth_element(variance_index.begin(), variance_index.begin() + static_cast<std::ptrdiff_t>(k),
+                   variance_index.end(), by_variance);
+  std::sort(variance_index.begin(), variance_index.begin() + static_cast<std::ptrdiff_t>(k),
+            by_variance);
   std::vector<std::size_t> out;
   out.reserve(k);
   for (std::size_t i = 0; i < k; ++i) {
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace aethersense::dsp {
+
+// Sorted multiset for sliding-window order statistics: an indexable skiplist whose nodes come
+// from a preallocated pool. Insert, Erase and rank access are O(log n), so rolling medians and
+// MADs cost O(log w) per step (O(log^2 w) for the MAD) instead of a sort per window. After
+// Reset(capacity) no operation allocates while size() <= capacity. Instantiated for float
+// (signal values) and std::uint64_t (timestamp deltas). NaN sorts after every number and equals
+// itself, so a NaN sample can be erased again; Mad() treats its deviation as the largest.
+template <typename T> class BasicOrderStatistics {
+public:
+  BasicOrderStatistics() = default;
+  explicit BasicOrderStatistics(std::size_t capacity) { Reset(capacity); }
+
+  // Empties the set and sizes the pool for `capacity` elements.
+  void Reset(std::size_t capacity);
+  void Clear();
+
+  void Insert(T value);
+  // Removes one element equal to `value`; returns false if there is none.
+  bool Erase(T value);
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  // The `rank`-th smallest element (0-based); requires rank < size().
+  [[nodiscard]] T At(std::size_t rank) const;
+
+  // Element at size() / 2, the median FilterOutliers and CPE removal use.
+  [[nodiscard]] T UpperMedian() const { return At(size_ / 2); }
+  // dsp::Median semantics: mean of the two middle elements for even sizes.
+  [[nodiscard]] T Median() const;
+  // The size() / 2-th smallest |x - center| over the set, without materializing deviations.
+  [[nodiscard]] T Mad(T center) const;
+
+private:
+  static constexpr std::uint32_t kNil = 0xFFFFFFFFU;
+  static constexpr std::uint32_t kHead = 0;
+
+  [[nodiscard]] std::uint32_t &Next(std::uint32_t node, std::size_t level) {
+    return next_[node * levels_ + level];
+  }
+  [[nodiscard]] std::uint32_t Next(std::uint32_t node, std::size_t level) const {
+    return next_[node * levels_ + level];
+  }
+  [[nodiscard]] std::size_t &Width(std::uint32_t node, std::size_t level) {
+    return width_[node * levels_ + level];
+  }
+  [[nodiscard]] std::size_t Width(std::uint32_t node, std::size_t level) const {
+    return width_[node * levels_ + level];
+  }
+  std::size_t RandomHeight();
+  void Grow();
+
+  std::size_t capacity_{0};
+  std::size_t levels_{1};
+  std::size_t size_{0};
+  std::size_t nan_count_{0};
+  std::uint32_t rng_{0x9E3779B9U};
+  // Node 0 is the head; the others are handed out from `free_`.
+  std::vector<T> value_;
+  std::vector<std::uint8_t> height_;
+  std::vector<std::uint32_t> next_;
+  std::vector<std::size_t> width_;
+  std::vector<std::uint32_t> free_;
+  std::vector<std::uint32_t> chain_;
+  std::vector<std::size_t> steps_;
+};
+
+extern template class BasicOrderStatistics<float>;
+extern template class BasicOrderStatistics<std::uint64_t>;
+
+using OrderStatistics = BasicOrderStatistics<float>;
+
+} // namespace aethersense::dsp
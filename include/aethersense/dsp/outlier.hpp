@@ -1,10 +1,17 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
+#include "aethersense/dsp/order_statistics.hpp"
+
 namespace aethersense::dsp {
 
 void FilterOutliers(std::vector<float> &series, const std::string &method, float k, int window);
+// Same filter with the rolling median/MAD kept in `stats`: O(n log^2 w) instead of two sorts
+// per sample.
+void FilterOutliers(std::span<float> series, const std::string &method, float k, int window,
+                    OrderStatistics &stats);
 
 } // namespace aethersense::dsp
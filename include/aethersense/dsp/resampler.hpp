@@ -1,14 +1,41 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace aethersense::dsp {
 
 float JitterMetric(const std::vector<std::uint64_t> &timestamps_ns);
+// Same metric; `scratch` holds the intervals.
+float JitterMetric(std::span<const std::uint64_t> timestamps_ns, std::vector<float> &scratch);
+
 std::vector<float> ResampleToUniformGrid(const std::vector<std::uint64_t> &timestamps_ns,
                                          const std::vector<float> &samples,
                                          const std::string &method);
 
+// Interpolation brackets for resampling one window onto its uniform grid t0 + i * step_ns.
+// Every series of a window shares the timestamps, so the bracket search runs once in Build()
+// and Apply() is a branch-free out[i] = s[lo] + w * (s[hi] - s[lo]) per series ("nearest" and
+// the clamped tail use lo == hi, w == 0).
+class ResamplePlan {
+public:
+  // Requires at least two timestamps; buffers are reused across builds.
+  void Build(std::span<const std::uint64_t> timestamps_ns, std::uint64_t step_ns,
+             const std::string &method);
+
+  [[nodiscard]] std::size_t size() const { return weight_.size(); }
+
+  // `samples` and `out` have size() elements and must not alias.
+  void Apply(std::span<const float> samples, std::span<float> out) const;
+  // Applies the plan to `rows` consecutive series of size() elements each.
+  void ApplyRows(std::span<const float> rows, std::span<float> out) const;
+
+private:
+  std::vector<std::uint32_t> lower_;
+  std::vector<std::uint32_t> upper_;
+  std::vector<float> weight_;
+};
+
 } // namespace aethersense::dsp
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+
+namespace aethersense::dsp::simd {
+
+enum class Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Best instruction set supported by both the build and the running CPU.
+Isa DetectIsa();
+[[nodiscard]] bool IsaSupported(Isa isa);
+const char *IsaName(Isa isa);
+
+// atan2 via octant folding and a cephes-style polynomial on [0, tan(pi/8)]; absolute error
+// within a few float ulps (below 1e-6 rad).
+float FastAtan2(float y, float x);
+
+// Ingest kernel for link-major interleaved CSI (`data[link * subcarriers + sc]`): writes the
+// link-averaged magnitude and the phase of the complex link sum of every subcarrier, reading
+// each link row sequentially. Dispatches to the best ISA detected at startup.
+void LinkMagnitudePhase(const std::complex<float> *data, std::size_t links,
+                        std::size_t subcarriers, float *amplitude, float *phase);
+// Same kernel on an explicit ISA, which must satisfy IsaSupported().
+void LinkMagnitudePhase(Isa isa, const std::complex<float> *data, std::size_t links,
+                        std::size_t subcarriers, float *amplitude, float *phase);
+
+} // namespace aethersense::dsp::simd
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "aethersense/dsp/filters.hpp"
+#include "aethersense/dsp/window.hpp"
+
+namespace aethersense::dsp {
+
+// Recursive DFT over the last `length` samples of a stream, evaluated only on a tracked range
+// of bins of a length-`fft_len` (optionally zero-padded) spectrum.
+//
+// BandEnergy() reproduces the FFT engine's tail on the same `length` samples,
+//   BandEnergy(MagnitudeSpectrum(ApplyWindow(EmaSmooth(Detrend(x), alpha)))),
+// where Detrend is the first/last line of RemoveLinearTrend and EmaSmooth restarts at the window
+// start. The window, the trend and the EMA restart are all folded in per bin in the frequency
+// domain, so each Push() costs O(tracked bins). State is kept in double precision and re-seeded
+// from the history periodically; band energies agree with the float FFT path to within 1e-3
+// relative (see test_sliding_dft.cpp).
+class SlidingDft {
+public:
+  SlidingDft() = default;
+  // `ema_alpha` of 1 disables smoothing.
+  SlidingDft(std::size_t length, std::size_t fft_len, WindowType window, bool detrend,
+             float ema_alpha = 1.0F);
+
+  // Selects the bins to track; re-seeds from the sample history when the range changes.
+  void Track(BinRange bins);
+  // Replaces the sample history (oldest first, at most `length` samples) and re-seeds.
+  void Reset(std::span<const float> history);
+  void Push(float sample);
+
+  [[nodiscard]] bool full() const { return count_ >= length_; }
+  [[nodiscard]] std::size_t length() const { return length_; }
+  [[nodiscard]] std::size_t fft_len() const { return fft_len_; }
+  [[nodiscard]] BinRange tracked() const { return bins_; }
+
+  // Sum of squared bin magnitudes over `bins` (clipped to the tracked range).
+  [[nodiscard]] float BandEnergy(BinRange bins) const;
+
+private:
+  struct Tap {
+    std::complex<double> rotate;
+    std::complex<double> enter;
+    std::complex<double> state;
+  };
+
+  [[nodiscard]] std::size_t Slot(std::size_t m) const {
+    return head_ + m < length_ ? head_ + m : head_ + m - length_;
+  }
+  void Append(double sample);
+  void Reseed();
+
+  std::size_t length_{0};
+  std::size_t fft_len_{0};
+  double window_a_{1.0};
+  double window_b_{0.0};
+  bool detrend_{false};
+  double alpha_{1.0};
+  BinRange bins_{};
+  // Three taps per tracked bin (f - d, f, f + d) combine into the windowed bin value of the
+  // streaming EMA; the per-bin constants below correct it for the EMA restart and the trend.
+  std::vector<Tap> taps_;
+  std::vector<std::complex<double>> restart_gain_;
+  std::vector<std::complex<double>> offset_gain_;
+  std::vector<std::complex<double>> slope_gain_;
+  std::vector<double> raw_;
+  std::vector<double> smoothed_;
+  std::size_t head_{0};
+  std::size_t count_{0};
+  std::size_t pushes_since_reseed_{0};
+};
+
+} // namespace aethersense::dsp
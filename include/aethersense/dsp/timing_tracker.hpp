@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "aethersense/dsp/order_statistics.hpp"
+
+namespace aethersense::dsp {
+
+// Interval statistics over a sliding window of frame timestamps, updated per frame in
+// O(log w): the upper-median interval from an order-statistics set and the interval mean and
+// variance from running sums. The jitter check, the sample-rate estimate and the resampler step
+// read from here instead of each re-sorting the window's intervals.
+class TimingTracker {
+public:
+  // Tracks the last `window_frames` timestamps, i.e. window_frames - 1 intervals.
+  void Reset(std::size_t window_frames);
+  void Clear();
+  void Push(std::uint64_t timestamp_ns);
+
+  [[nodiscard]] std::size_t intervals() const { return count_; }
+  // Upper median interval; 0 until two timestamps have been pushed.
+  [[nodiscard]] std::uint64_t median_interval_ns() const;
+  [[nodiscard]] float sample_rate_hz() const;
+  // JitterMetric of the window: interval standard deviation over the median interval, 0 for
+  // fewer than three timestamps and 1 for a zero median.
+  [[nodiscard]] float jitter_ratio() const;
+
+private:
+  void Rebuild();
+
+  std::vector<std::uint64_t> intervals_;
+  std::size_t head_{0};
+  std::size_t count_{0};
+  bool has_last_{false};
+  std::uint64_t last_ns_{0};
+  BasicOrderStatistics<std::uint64_t> order_;
+  // Sums of (interval - shift), shifted by the first interval to limit cancellation.
+  double shift_{0.0};
+  double sum_{0.0};
+  double sum_sq_{0.0};
+  std::size_t pushes_since_rebuild_{0};
+};
+
+} // namespace aethersense::dsp
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace aethersense::dsp {
+
+// Population variance of every channel over a sliding window, kept as running sums so that a
+// frame entering (and one leaving) the window costs O(1) per channel. Sums are accumulated in
+// double around a per-channel shift (the first sample seen) to limit cancellation; Rebuild()
+// recomputes a channel exactly from its history.
+class VarianceTracker {
+public:
+  void Reset(std::size_t channels) {
+    shift_.assign(channels, 0.0);
+    sum_.assign(channels, 0.0);
+    sum_sq_.assign(channels, 0.0);
+    count_ = 0;
+  }
+
+  [[nodiscard]] std::size_t channels() const { return sum_.size(); }
+  [[nodiscard]] std::size_t count() const { return count_; }
+
+  // Adds one frame (one value per channel) to a growing window.
+  void Add(std::span<const float> values) {
+    if (count_ == 0) {
+      std::copy(values.begin(), values.end(), shift_.begin());
+    }
+    for (std::size_t ch = 0; ch < sum_.size(); ++ch) {
+      const double d = values[ch] - shift_[ch];
+      sum_[ch] += d;
+      sum_sq_[ch] += d * d;
+    }
+    ++count_;
+  }
+
+  // Slides a full window by one frame: `added` enters, `evicted` leaves.
+  void Replace(std::span<const float> added, std::span<const float> evicted) {
+    if (count_ == 0) {
+      Add(added);
+      return;
+    }
+    for (std::size_t ch = 0; ch < sum_.size(); ++ch) {
+      const double a = added[ch] - shift_[ch];
+      const double e = evicted[ch] - shift_[ch];
+      sum_[ch] += a - e;
+      sum_sq_[ch] += a * a - e * e;
+    }
+  }
+
+  // Recomputes channel `ch` from its window contents (split like SignalWindow::Segments).
+  void Rebuild(std::size_t ch, std::span<const float> older, std::span<const float> newer) {
+    shift_[ch] = !older.empty() ? older.front() : (!newer.empty() ? newer.front() : 0.0F);
+    sum_[ch] = 0.0;
+    sum_sq_[ch] = 0.0;
+    for (const auto &part : {older, newer}) {
+      for (float v : part) {
+        const double d = v - shift_[ch];
+        sum_[ch] += d;
+        sum_sq_[ch] += d * d;
+      }
+    }
+    count_ = older.size() + newer.size();
+  }
+
+  [[nodiscard]] float variance(std::size_t ch) const {
+    if (count_ == 0) {
+      return 0.0F;
+    }
+    const double n = static_cast<double>(count_);
+    const double mean = sum_[ch] / n;
+    return static_cast<float>(std::max(0.0, sum_sq_[ch] / n - mean * mean));
+  }
+
+private:
+  std::vector<double> shift_;
+  std::vector<double> sum_;
+  std::vector<double> sum_sq_;
+  std::size_t count_{0};
+};
+
+} // namespace aethersense::dsp
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -12,25 +14,32 @@ inline WindowType ParseWindowType(const std::string &name) {
   return name == "hamming" ? WindowType::kHamming : WindowType::kHann;
 }
 
-inline std::vector<float> BuildWindow(WindowType type, std::size_t n) {
-  std::vector<float> out(n, 1.0F);
+inline float WindowCoefficient(WindowType type, std::size_t i, std::size_t n) {
   if (n <= 1) {
-    return out;
+    return 1.0F;
   }
-  const float denom = static_cast<float>(n - 1);
-  for (std::size_t i = 0; i < n; ++i) {
-    constexpr float kPi = 3.14159265358979323846F;
-    const float phase = 2.0F * kPi * static_cast<float>(i) / denom;
-    out[i] = type == WindowType::kHamming ? 0.54F - 0.46F * std::cos(phase)
-                                          : 0.5F * (1.0F - std::cos(phase));
+  constexpr float kPi = 3.14159265358979323846F;
+  const float phase = 2.0F * kPi * static_cast<float>(i) / static_cast<float>(n - 1);
+  return type == WindowType::kHamming ? 0.54F - 0.46F * std::cos(phase)
+                                      : 0.5F * (1.0F - std::cos(phase));
+}
+
+// Fills `out` with the symmetric window of length out.size().
+inline void BuildWindow(WindowType type, std::span<float> out) {
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = WindowCoefficient(type, i, out.size());
   }
+}
+
+inline std::vector<float> BuildWindow(WindowType type, std::size_t n) {
+  std::vector<float> out(n);
+  BuildWindow(type, std::span<float>(out));
   return out;
 }
 
 inline void ApplyWindow(std::vector<float> &data, WindowType type) {
-  const auto win = BuildWindow(type, data.size());
   for (std::size_t i = 0; i < data.size(); ++i) {
-    data[i] *= win[i];
+    data[i] *= WindowCoefficient(type, i, data.size());
   }
 }
 
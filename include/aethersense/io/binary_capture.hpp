@@ -0,0 +1,133 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+#include "aethersense/core/types.hpp"
+#include "aethersense/io/checkpoint.hpp"
+#include "aethersense/io/csi_reader.hpp"
+#include "aethersense/io/csi_writer.hpp"
+#include "aethersense/io/mapped_file.hpp"
+#include "aethersense/io/record_recovery.hpp"
+
+namespace aethersense::io {
+
+// Binary CSI capture ("io.format": "binary"). All integers and floats are little-endian.
+//
+// Header, 64 bytes:
+//   0  char[8]  magic "AECSIBIN"
+//   8  u16      version (1)
+//   10 u16      header size (64)
+//   12 u8       rx_count
+//   13 u8       tx_count
+//   14 u16      subcarrier_count
+//   16 u64      center_freq_hz
+//   24 u32      record size in bytes
+//   28 u32      CRC-32C of bytes [0, 28)
+//   32          zero padding
+//
+// Then fixed-size records, one per frame, each starting on a 32-byte boundary:
+//   0  u32      sync marker 0x1ACFFC1D
+//   4  u32      CRC-32C of bytes [8, record size)
+//   8  u64      timestamp_ns
+//   16          zero padding
+//   32 f32[2n]  the frame's n = rx*tx*subcarriers samples as interleaved re/im pairs, in
+//               CsiFrame order, zero-padded to a multiple of 32 bytes
+//
+// The sample block has CsiFrame's in-memory layout, so a mapped record is handed out as a
+// FrameView without any copy. A record whose marker or CRC does not check is skipped: the reader
+// tries the next record slot first and otherwise scans forward for the next valid marker.
+inline constexpr char kBinaryCaptureMagic[8] = {'A', 'E', 'C', 'S', 'I', 'B', 'I', 'N'};
+inline constexpr std::uint16_t kBinaryCaptureVersion = 1;
+inline constexpr std::size_t kBinaryHeaderBytes = 64;
+inline constexpr std::size_t kBinaryRecordPrefixBytes = 32;
+inline constexpr std::uint32_t kBinaryRecordSync = 0x1ACFFC1DU;
+
+struct BinaryCaptureHeader {
+  std::uint8_t rx_count{0};
+  std::uint8_t tx_count{0};
+  std::uint16_t subcarrier_count{0};
+  std::uint64_t center_freq_hz{0};
+  std::uint32_t record_bytes{0};
+};
+
+// Record size for a frame shape: prefix plus the sample block rounded up to 32 bytes.
+std::size_t BinaryRecordBytes(std::uint8_t rx_count, std::uint8_t tx_count,
+                              std::uint16_t subcarrier_count);
+
+// CRC-32C (Castagnoli), using the SSE4.2 instruction where the CPU has it. `crc` continues a
+// previous call's result.
+std::uint32_t Crc32c(const void *data, std::size_t size, std::uint32_t crc = 0);
+
+// Writes a binary capture. The first frame fixes the header's shape and center frequency; later
+// frames must match it. Frames are buffered by the stream until close().
+class BinaryCaptureWriter final : public ICsiWriter {
+public:
+  BinaryCaptureWriter() = default;
+  ~BinaryCaptureWriter() override;
+
+  // Creates (or truncates) `path`.
+  Result<bool> Open(const std::string &path);
+
+  Result<bool> write(const FrameView &frame) override;
+  // A capture closed without any frame gets a header with an all-zero shape.
+  Result<bool> close() override;
+  std::size_t frames_written() const override { return frames_written_; }
+
+private:
+  Result<bool> WriteHeader();
+
+  std::ofstream out_;
+  std::string path_;
+  std::optional<BinaryCaptureHeader> header_;
+  std::vector<char> record_;
+  std::size_t frames_written_{0};
+};
+
+// File-mode reader over a mapped binary capture. next_view() hands out frames that point into
+// the mapping; next_into() copies the samples into the caller's reused buffer. Corrupt records
+// count toward io.max_corrupt_ratio like corrupt text lines, a truncated final record counts as
+// partial, and every record advances the (batched) checkpoint.
+class BinaryCaptureReader final : public ICsiReader {
+public:
+  explicit BinaryCaptureReader(const Config::Io &cfg) : cfg_(cfg), corrupt_(cfg.max_corrupt_ratio) {}
+
+  Result<bool> Open(const std::string &path);
+  [[nodiscard]] const BinaryCaptureHeader &header() const { return header_; }
+  // Byte offset of the next record to examine; a frame just returned ends there.
+  [[nodiscard]] std::size_t offset() const { return offset_; }
+
+  // The next valid record, or false at the end of the file. The view stays valid for the
+  // reader's lifetime, unless the record sits at an offset misaligned for float samples (bytes
+  // were lost or inserted before it): those samples are copied to a buffer the next read reuses.
+  Result<bool> next_view(FrameView &view) override;
+  bool reads_in_place() const override { return true; }
+
+  Result<std::optional<CsiFrame>> next() override;
+  Result<bool> next_into(CsiFrame &frame) override;
+  StreamStats stream_stats() const override;
+
+private:
+  [[nodiscard]] bool ValidRecord(std::size_t offset) const;
+  // Offset of the first valid record after the corrupt one at `offset`, or the file size.
+  [[nodiscard]] std::size_t Resync(std::size_t offset) const;
+
+  Config::Io cfg_;
+  MappedFile file_;
+  std::string signature_;
+  BinaryCaptureHeader header_;
+  std::size_t offset_{0};
+  std::vector<std::complex<float>> realigned_;
+  StreamStats stats_;
+  CorruptRatioWindow corrupt_;
+  CheckpointWriter checkpoint_{cfg_};
+};
+
+} // namespace aethersense::io
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+
+namespace aethersense::io {
+
+// Sparse timestamp -> byte offset index of a file-mode capture (any io.format), kept next to it
+// as "<capture>.idx". There is an entry for every `stride`-th valid frame; each one records
+// where that frame's record starts and the largest timestamp among the frames before it, which
+// stays correct when timestamps are not monotonic. Like file-mode replay, indexing stops at the
+// first empty line of a text capture. A compressed capture can only be entered at a block, so
+// its entries are at the first block starting `stride` or more frames after the previous one.
+struct CaptureIndexEntry {
+  std::uint64_t offset{0};
+  std::uint64_t frames_before{0};
+  // 0 when no frame precedes the entry.
+  std::uint64_t max_timestamp_before_ns{0};
+};
+
+struct CaptureIndex {
+  // FileSignature() and io.format of the capture the index was built from.
+  std::string signature;
+  std::string format;
+  std::uint64_t stride{0};
+  std::uint64_t frames_total{0};
+  std::vector<CaptureIndexEntry> entries;
+};
+
+inline constexpr std::uint64_t kCaptureIndexStride = 64;
+
+std::string CaptureIndexPath(const std::string &capture_path);
+
+// Scans the whole capture at `path` (read as io.format) and indexes every valid frame.
+Result<CaptureIndex> BuildCaptureIndex(const Config::Io &io, const std::string &path,
+                                       std::uint64_t stride = kCaptureIndexStride);
+
+std::optional<CaptureIndex> ReadCaptureIndex(const std::string &index_path);
+Result<bool> WriteCaptureIndex(const std::string &index_path, const CaptureIndex &index);
+
+// The sidecar index of `path` if it was built from this capture and format; otherwise builds
+// it and saves it for the next query (a sidecar that cannot be written is not an error).
+Result<CaptureIndex> LoadOrBuildCaptureIndex(const Config::Io &io, const std::string &path);
+
+// Offset to start reading at so that at least `warmup_frames` frames come before the first
+// frame stamped at or after `from_ts_ns` (fewer if the capture does not have them). The offset
+// is within two strides of frames of the ideal one (two blocks, for compressed captures with
+// blocks longer than the stride).
+std::uint64_t SeekOffset(const CaptureIndex &index, std::uint64_t from_ts_ns,
+                         std::uint64_t warmup_frames);
+
+// Points `io` at the record SeekOffset() picks for `path`, via start_position "offset",
+// building the index if needed.
+Result<bool> SeekToTimestamp(Config::Io &io, const std::string &path, std::uint64_t from_ts_ns,
+                             std::uint64_t warmup_frames);
+
+} // namespace aethersense::io
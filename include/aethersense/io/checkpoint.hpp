@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "aethersense/core/config.hpp"
+
+namespace aethersense::io {
+
+// Resume point of a stream reader, stored as "<signature> <offset> <timestamp_ns>".
+struct Checkpoint {
+  std::string signature;
+  std::uint64_t offset{0};
+  std::uint64_t timestamp_ns{0};
+};
+
+// Identity of the file at `path` (type and size) used to tell whether a checkpoint still
+// applies; empty if the file does not exist.
+std::string FileSignature(const std::string &path);
+
+// Device, inode and size of a file, which tell a tail reader whether the path now names another
+// file (rotation) or the file shrank (truncation) rather than grew. Device and inode are 0
+// where POSIX stat() is not available, so only truncation is seen there.
+struct FileIdentity {
+  std::uint64_t device{0};
+  std::uint64_t inode{0};
+  std::uint64_t size{0};
+};
+
+// nullopt if nothing exists at `path`.
+std::optional<FileIdentity> StatFile(const std::string &path);
+
+std::optional<Checkpoint> ReadCheckpoint(const std::string &checkpoint_path);
+// Replaces the checkpoint file atomically: writes "<path>.tmp" and renames it over `path`, so a
+// reader (or a crash) sees the old or the new checkpoint, never a torn one. With `fsync` the
+// data and the rename are synced to disk first. False if it cannot be written or the path is
+// empty.
+bool WriteCheckpoint(const std::string &checkpoint_path, const Checkpoint &checkpoint,
+                     bool fsync = false);
+
+// Batches a reader's checkpoints per io.checkpoint_* (see Config::Io): Update() only records the
+// latest resume point and writes it once a batch is due; Flush() writes whatever is pending.
+// With io.checkpoint_async the writes run on a background thread. Destruction flushes. Without
+// io.checkpoint_path it does nothing.
+class CheckpointWriter {
+public:
+  explicit CheckpointWriter(const Config::Io &cfg);
+  ~CheckpointWriter();
+  CheckpointWriter(const CheckpointWriter &) = delete;
+  CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+  // `checkpoint` becomes the resume point after `records` more records (0 to amend the current
+  // one, e.g. with its timestamp).
+  void Update(const Checkpoint &checkpoint, std::size_t records = 1);
+  // Writes the latest resume point if it has not been written yet, and waits for it.
+  void Flush();
+  // Writes the pending resume point if io.checkpoint_interval_ms has passed since the last
+  // write; for readers idling at the end of a growing file, where a slow stream would otherwise
+  // reach the end after every record.
+  void FlushIfStale();
+  // Checkpoint files written so far.
+  [[nodiscard]] std::size_t writes_total() const {
+    return writes_total_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void Write();
+  void Run();
+
+  std::string path_;
+  std::size_t every_records_;
+  std::chrono::milliseconds interval_;
+  bool fsync_;
+  Checkpoint latest_;
+  bool dirty_{false};
+  std::size_t pending_records_{0};
+  std::chrono::steady_clock::time_point last_write_;
+  std::atomic<std::size_t> writes_total_{0};
+
+  // checkpoint_async: Write() hands `queued_` to Run() on thread_.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::optional<Checkpoint> queued_;
+  std::size_t requested_{0};
+  std::size_t completed_{0};
+  bool stop_{false};
+  std::thread thread_;
+};
+
+} // namespace aethersense::io
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+#include "aethersense/core/types.hpp"
+#include "aethersense/io/checkpoint.hpp"
+#include "aethersense/io/csi_reader.hpp"
+#include "aethersense/io/csi_writer.hpp"
+#include "aethersense/io/mapped_file.hpp"
+#include "aethersense/io/record_recovery.hpp"
+
+namespace aethersense::io {
+
+// Compressed CSI capture ("io.format": "compressed"). Little-endian, like the binary capture.
+//
+// Header, 64 bytes: as binary_capture.hpp's, with magic "AECSICMP" and the maximum frames per
+// block in place of the record size.
+//
+// Then blocks of up to that many frames, each decodable on its own:
+//   0  u32      sync marker 0x1ACFFC2E
+//   4  u32      CRC-32C of bytes [8, 32 + payload size)
+//   8  u32      payload size
+//   12 u16      frame count
+//   14 u8       codec (0 lossless, 1 int16)
+//   15 u8       zero
+//   16 f32      int16 scale (0 for lossless)
+//   20 u32      zero
+//   24 u64      first timestamp_ns
+//   32          payload: zigzag varint timestamp deltas for frames 1.., then per frame the
+//               residuals of its 2n float lanes (re, im, re, ...) against the previous frame
+//               of the block (the first against zero), bit-packed in groups of 32. A group
+//               starts with a u8 bit width and a u8 shift (low zero bits common to the group,
+//               dropped before packing).
+//
+// Lossless residuals are the XOR of the float bit patterns, so values that change little
+// leave only low mantissa bits. Int16 residuals are zigzagged differences of the samples
+// quantized to round(v / scale), where scale = max |v| in the block / 32767; non-finite samples
+// are stored as 0. A block that fails its checks is skipped and the reader resyncs on the next
+// valid marker.
+enum class CsiCodec : std::uint8_t { kLossless = 0, kInt16 = 1 };
+
+inline constexpr char kCompressedCaptureMagic[8] = {'A', 'E', 'C', 'S', 'I', 'C', 'M', 'P'};
+inline constexpr std::uint16_t kCompressedCaptureVersion = 1;
+inline constexpr std::size_t kCompressedHeaderBytes = 64;
+inline constexpr std::size_t kCsiBlockHeaderBytes = 32;
+inline constexpr std::uint32_t kCsiBlockSync = 0x1ACFFC2EU;
+inline constexpr std::size_t kMaxBlockFrames = 65535;
+
+// Parses "lossless" | "int16".
+std::optional<CsiCodec> ParseCsiCodec(const std::string &name);
+
+// Encodes the frames stamped `timestamps` (samples back to back, `samples.size() /
+// timestamps.size()` per frame) as one block and appends it to `out`. At most kMaxBlockFrames.
+void EncodeCsiBlock(CsiCodec codec, std::span<const std::uint64_t> timestamps,
+                    std::span<const std::complex<float>> samples, std::vector<char> &out);
+
+// Size of the block starting at `data` if its marker, size and CRC check out, otherwise 0.
+std::size_t CheckCsiBlock(const char *data, std::size_t size);
+
+// Decodes a block that passed CheckCsiBlock(), replacing the contents of `timestamps` and
+// `samples`; false if the payload does not hold `samples_per_frame` samples per frame, or if the
+// block claims no frames or more than `max_frames`. The frame count is checked against the
+// payload size before anything is allocated.
+bool DecodeCsiBlock(const char *block, std::size_t samples_per_frame, std::size_t max_frames,
+                    std::vector<std::uint64_t> &timestamps,
+                    std::vector<std::complex<float>> &samples);
+
+// Writes a compressed capture, one block per `block_frames` frames. Shape rules are those of
+// BinaryCaptureWriter.
+class CompressedCaptureWriter final : public ICsiWriter {
+public:
+  CompressedCaptureWriter(CsiCodec codec, std::size_t block_frames)
+      : codec_(codec), block_frames_(block_frames) {}
+  ~CompressedCaptureWriter() override;
+
+  Result<bool> Open(const std::string &path);
+
+  Result<bool> write(const FrameView &frame) override;
+  Result<bool> close() override;
+  std::size_t frames_written() const override { return frames_written_; }
+
+private:
+  Result<bool> WriteHeader(std::uint8_t rx, std::uint8_t tx, std::uint16_t subcarriers,
+                           std::uint64_t center_freq_hz);
+  Result<bool> FlushBlock();
+
+  CsiCodec codec_;
+  std::size_t block_frames_;
+  std::ofstream out_;
+  std::string path_;
+  bool header_written_{false};
+  FrameView shape_;
+  std::vector<std::uint64_t> timestamps_;
+  std::vector<std::complex<float>> samples_;
+  std::vector<char> block_;
+  std::size_t frames_written_{0};
+};
+
+// File-mode reader over a mapped compressed capture. A block is decoded when its first frame
+// is read; next_view() hands out frames from the decoded block, valid until the next read.
+// Corrupt blocks count once each toward io.max_corrupt_ratio, and the (batched) checkpoint
+// advances when the last frame of a block is handed out, so a resumed replay starts at a block
+// boundary.
+class CompressedCaptureReader final : public ICsiReader {
+public:
+  explicit CompressedCaptureReader(const Config::Io &cfg)
+      : cfg_(cfg), corrupt_(cfg.max_corrupt_ratio) {}
+
+  Result<bool> Open(const std::string &path);
+  // Offset of the block that holds the frame read last.
+  [[nodiscard]] std::size_t block_offset() const { return block_offset_; }
+
+  Result<bool> next_view(FrameView &view) override;
+
+  Result<std::optional<CsiFrame>> next() override;
+  Result<bool> next_into(CsiFrame &frame) override;
+  StreamStats stream_stats() const override;
+
+private:
+  // Decodes the next valid block at or after offset_; false at the end of the file.
+  Result<bool> LoadBlock();
+
+  Config::Io cfg_;
+  MappedFile file_;
+  std::string signature_;
+  FrameView shape_;
+  std::size_t samples_per_frame_{0};
+  std::size_t block_frames_{0};
+  std::size_t offset_{0};
+  std::size_t block_offset_{0};
+  std::vector<std::uint64_t> timestamps_;
+  std::vector<std::complex<float>> samples_;
+  std::size_t next_frame_{0};
+  StreamStats stats_;
+  CorruptRatioWindow corrupt_;
+  CheckpointWriter checkpoint_{cfg_};
+};
+
+} // namespace aethersense::io
@@ -3,6 +3,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 
 #include "aethersense/core/config.hpp"
 #include "aethersense/core/errors.hpp"
@@ -15,6 +16,29 @@ class ICsiReader {
 public:
   virtual ~ICsiReader() = default;
   virtual Result<std::optional<CsiFrame>> next() = 0;
+  // Reads the next frame into `frame`, reusing its sample buffer; false when next() would have
+  // returned no frame. Readers that parse records override this to avoid a fresh buffer (and a
+  // copy) per frame.
+  virtual Result<bool> next_into(CsiFrame &frame) {
+    auto next_frame = next();
+    if (!next_frame.ok()) {
+      return next_frame.error();
+    }
+    if (!next_frame.value().has_value()) {
+      return false;
+    }
+    frame = std::move(*next_frame.value());
+    return true;
+  }
+  // Hands out the next frame in place, valid until the next read; false at end of input. Only
+  // readers over a mapped capture support it.
+  virtual Result<bool> next_view(FrameView &view) {
+    (void)view;
+    return Error{ErrorCode::kUnsupportedFormat, "reader does not hand out frame views"};
+  }
+  // True when next_view() costs next to nothing (no parsing or decoding), so there is no work
+  // worth moving off the thread that processes the frames.
+  virtual bool reads_in_place() const { return false; }
   virtual io::StreamStats stream_stats() const = 0;
 };
 
@@ -1,10 +1,31 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "aethersense/core/errors.hpp"
+#include "aethersense/core/types.hpp"
+
 namespace aethersense {
 
 class ICsiWriter {
 public:
   virtual ~ICsiWriter() = default;
+  virtual Result<bool> write(const FrameView &frame) = 0;
+  // Flushes everything written so far and closes the output; later writes fail.
+  virtual Result<bool> close() = 0;
+  virtual std::size_t frames_written() const = 0;
 };
 
+struct WriterOptions {
+  // "compressed" only: "lossless" | "int16", and frames per block.
+  std::string codec{"lossless"};
+  std::size_t block_frames{64};
+};
+
+// Only "binary" and "compressed" captures can be written; text formats are kUnsupportedFormat.
+Result<std::unique_ptr<ICsiWriter>> CreateWriter(const std::string &format, const std::string &path,
+                                                 const WriterOptions &options = {});
+
 } // namespace aethersense
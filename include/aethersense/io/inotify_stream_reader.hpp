@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+#include "aethersense/io/stream_reader.hpp"
+
+namespace aethersense::io {
+
+// Tail-mode IStreamReader that sleeps on inotify instead of polling (Linux only). At the end
+// of the file it waits up to io.poll_interval_ms for an IN_MODIFY on the file and reads new
+// lines as soon as it arrives. IN_MOVE_SELF, IN_DELETE_SELF and IN_ATTRIB on the file, or
+// IN_CREATE / IN_MOVED_TO of its name in the directory, make it check for a rotation. An
+// IN_MODIFY with nothing to read makes it check for a truncation. Reading a line does no stat()
+// calls.
+//
+// Lines are read through a buffer, and a line is handed out only once its '\n' has been
+// written. A line longer than io.max_partial_line_bytes is handed out in pieces, which parse as
+// corrupt. Checkpoints, start positions and rotate_handling behave as for the polling reader.
+//
+// kUnsupportedFormat off Linux, kIoError if no inotify instance can be created.
+Result<std::unique_ptr<IStreamReader>> CreateInotifyStreamReader(const Config::Io &cfg);
+
+} // namespace aethersense::io
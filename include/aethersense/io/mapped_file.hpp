@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "aethersense/core/errors.hpp"
+
+namespace aethersense::io {
+
+// Read-only memory mapping of a whole file, advised for sequential access so the kernel reads
+// ahead aggressively and drops pages behind the cursor. Where mmap is unavailable the file is
+// read into memory instead; callers see the same view either way.
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() { Close(); }
+
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // Maps `path`, replacing any current mapping. An empty file maps to an empty view.
+  Result<bool> Open(const std::string &path);
+  void Close();
+
+  [[nodiscard]] bool is_open() const { return open_; }
+  [[nodiscard]] const char *data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+
+private:
+  const char *data_{nullptr};
+  std::size_t size_{0};
+  bool open_{false};
+  // True for an mmap; false when the view points into `buffer_` (fallback or empty file).
+  bool mapped_{false};
+  std::string buffer_;
+};
+
+} // namespace aethersense::io
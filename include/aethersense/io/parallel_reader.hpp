@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+#include "aethersense/io/csi_reader.hpp"
+
+namespace aethersense {
+
+// File-mode ICsiReader that parses one capture on `io.parse_threads` threads. The mapped file
+// is cut at newline boundaries into chunks of about `io.parse_chunk_bytes`; workers parse whole
+// chunks ahead of the consumer (at most two per thread in flight) and next() replays each
+// chunk's records in file order. Corrupt-ratio accounting, empty-line handling and the
+// reported record counts are replayed exactly as the sequential reader would produce them;
+// only checkpoints differ, advancing once per consumed chunk instead of per line.
+Result<std::unique_ptr<ICsiReader>> CreateParallelReader(const Config::Io &io_cfg,
+                                                         const std::string &path);
+
+} // namespace aethersense
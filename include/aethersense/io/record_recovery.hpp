@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "aethersense/core/types.hpp"
 
@@ -13,7 +15,43 @@ struct RecoveryResult {
   std::string error;
 };
 
-RecoveryResult ParseCsvRecord(const std::string &line);
-RecoveryResult ParseJsonlRecord(const std::string &line);
+RecoveryResult ParseCsvRecord(std::string_view line);
+RecoveryResult ParseJsonlRecord(std::string_view line);
+
+struct ParseStatus {
+  bool corrupt{false};
+  std::string error;
+};
+
+// Parse into an existing frame, reusing its sample buffer (e.g. a pooled or per-stream frame).
+// On a corrupt record `frame` is left in an unspecified but valid state.
+ParseStatus ParseCsvRecordInto(std::string_view line, CsiFrame &frame);
+ParseStatus ParseJsonlRecordInto(std::string_view line, CsiFrame &frame);
+
+// io.max_corrupt_ratio bookkeeping shared by the readers: every record joins the current window,
+// and a corrupt record that brings it to 64 records checks the ratio and starts a new window.
+class CorruptRatioWindow {
+public:
+  explicit CorruptRatioWindow(float max_ratio) : max_ratio_(max_ratio) {}
+
+  void AddGood() { ++size_; }
+  // True when this record closes a window whose corrupt ratio exceeds the limit.
+  bool AddCorrupt() {
+    ++corrupt_;
+    ++size_;
+    if (size_ < 64) {
+      return false;
+    }
+    const float ratio = static_cast<float>(corrupt_) / static_cast<float>(size_);
+    size_ = 0;
+    corrupt_ = 0;
+    return ratio > max_ratio_;
+  }
+
+private:
+  float max_ratio_;
+  std::size_t corrupt_{0};
+  std::size_t size_{0};
+};
 
 } // namespace aethersense::io
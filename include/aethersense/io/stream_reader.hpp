@@ -6,6 +6,7 @@
 #include <optional>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "aethersense/core/config.hpp"
 #include "aethersense/core/errors.hpp"
@@ -22,8 +23,10 @@ struct StreamStats {
   std::size_t consecutive_errors_current{0};
 };
 
+// `line` points into the reader's buffer (or file mapping) and stays valid until the next
+// read_next() or open() on the same reader.
 struct StreamRecord {
-  std::string line;
+  std::string_view line;
   bool eof{false};
 };
 
@@ -36,6 +39,12 @@ public:
   virtual std::uint64_t last_timestamp_ns() const = 0;
 };
 
+// io.reader "mmap" (or "auto" in file mode) yields records straight from a read-only mapping of
+// the file; "stream" reads through std::ifstream and, in tail mode, polls every
+// io.poll_interval_ms at the end of the file. "inotify" (or "auto" in tail mode, falling back
+// to "stream" where inotify is unavailable) waits for changes instead; see
+// inotify_stream_reader.hpp. A mapped file is a snapshot taken at open(): growth and rotation
+// are only tracked by the tail readers.
 Result<std::unique_ptr<IStreamReader>> CreateStreamReader(const Config::Io &cfg);
 
 } // namespace aethersense::io
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <deque>
 #include <vector>
 
 namespace aethersense {
@@ -16,14 +15,24 @@ struct RuntimeMetrics {
   std::size_t ring_buffer_depth{0};
   float window_fill_ratio{0.0F};
 
-  std::deque<double> processing_time_us;
+  // Last `latency_window` samples as a ring (order is irrelevant to Percentile), so recording
+  // stops allocating once the ring is full.
+  std::vector<double> processing_time_us;
   std::size_t latency_window{64};
+  std::size_t latency_next{0};
 
   void AddProcessingTimeUs(double value) {
-    processing_time_us.push_back(value);
-    while (processing_time_us.size() > latency_window) {
-      processing_time_us.pop_front();
+    if (latency_window == 0) {
+      return;
     }
+    if (processing_time_us.size() < latency_window) {
+      processing_time_us.reserve(latency_window);
+      processing_time_us.push_back(value);
+      return;
+    }
+    processing_time_us.resize(latency_window);
+    latency_next %= latency_window;
+    processing_time_us[latency_next++] = value;
   }
 
   [[nodiscard]] double Percentile(double p) const {
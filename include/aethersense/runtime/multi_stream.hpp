@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+#include "aethersense/io/csi_reader.hpp"
+#include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/pipeline.hpp"
+
+namespace aethersense {
+
+// Everything one hosted sensor stream owns: its reader, its Pipeline (with its own
+// DecisionEngine) and its metrics. Aligned to a cache line so workers running different
+// streams never write to a shared line.
+struct alignas(64) StreamState {
+  StreamState(const Config &cfg, std::unique_ptr<ICsiReader> stream_reader)
+      : config(cfg), reader(std::move(stream_reader)), pipeline(cfg) {}
+
+  Config config;
+  std::unique_ptr<ICsiReader> reader;
+  Pipeline pipeline;
+  RuntimeMetrics metrics;
+  // Parse target reused for every frame of the stream (see ICsiReader::next_into).
+  CsiFrame frame;
+  std::size_t decisions_total{0};
+  std::size_t present_total{0};
+  double energy_sum{0.0};
+  // Set when the stream stopped on a read or pipeline error; other streams keep running.
+  std::optional<Error> error;
+};
+
+// Hosts many reader -> Pipeline streams in one process on a WorkStealingPool of
+// runtime.worker_threads workers. A stream is driven by a single task at a time that handles
+// up to runtime.max_batch_frames frames and then requeues itself behind the streams already
+// waiting on its worker, so frames (and decisions) of one stream stay in order, every stream
+// gets its turn, and idle workers steal whole streams from busy ones. A tail stream that has
+// caught up gives its worker back: Run() retries it after io.poll_interval_ms.
+class MultiStreamRunner {
+public:
+  // Called on a worker thread; calls for one stream are sequential and in frame order, calls
+  // for different streams may run concurrently.
+  using DecisionSink = std::function<void(std::size_t stream, const Decision &decision)>;
+
+  // Adds a stream reading `cfg.io.path` with `cfg.io`; returns its index. In tail mode the
+  // reader is created with io.tail_nonblocking. A reader passed in directly may still block
+  // while waiting for input, holding a worker meanwhile.
+  Result<std::size_t> AddStream(const Config &cfg);
+  std::size_t AddStream(const Config &cfg, std::unique_ptr<ICsiReader> reader);
+
+  [[nodiscard]] std::size_t size() const { return streams_.size(); }
+  [[nodiscard]] const StreamState &stream(std::size_t index) const { return *streams_[index]; }
+
+  // Runs every stream until end of input (indefinitely for io.mode "tail"), using
+  // `worker_threads` workers (0 = hardware concurrency). Fails with the first stream error.
+  Result<bool> Run(std::size_t worker_threads, const DecisionSink &sink = {});
+
+private:
+  std::vector<std::unique_ptr<StreamState>> streams_;
+};
+
+} // namespace aethersense
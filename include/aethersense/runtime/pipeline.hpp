@@ -2,13 +2,21 @@
 
 #include <cstdint>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "aethersense/core/config.hpp"
 #include "aethersense/core/errors.hpp"
 #include "aethersense/core/types.hpp"
+#include "aethersense/dsp/fft_plan.hpp"
+#include "aethersense/dsp/order_statistics.hpp"
+#include "aethersense/dsp/resampler.hpp"
+#include "aethersense/dsp/sliding_dft.hpp"
+#include "aethersense/dsp/timing_tracker.hpp"
+#include "aethersense/dsp/variance_tracker.hpp"
 #include "aethersense/runtime/decision_engine.hpp"
 #include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/signal_window.hpp"
 
 namespace aethersense {
 
@@ -30,11 +38,55 @@ public:
   explicit Pipeline(const Config &config);
 
   Result<std::optional<Decision>> ProcessFrame(const CsiFrame &frame, RuntimeMetrics &metrics);
+  // Same as above for a frame the caller does not own, e.g. a record of a mapped binary capture.
+  Result<std::optional<Decision>> ProcessFrame(const FrameView &frame, RuntimeMetrics &metrics);
 
 private:
+  void RunFftEngine(std::uint64_t step_ns, float sample_rate, Decision &out);
+  void RunSlidingDftEngine(float sample_rate, Decision &out);
+  // Top-K by amplitude variance, refreshed every dsp.topk_reselect_every evaluated windows.
+  void UpdateSelection();
+  // sliding_dft engine: streaming unwrap of the newest (CPE-corrected) frame before it enters
+  // the window, then one aggregated sample per frame into the recursive DFT.
+  void UnwrapPhaseAtIngest();
+  void PushSlidingSample();
+
   Config config_;
   DecisionEngine decision_engine_;
-  std::vector<FrameSignals> window_;
+  dsp::FftPlan fft_plan_;
+  SignalWindow window_;
+  // Links kept as separate channel groups: rx*tx in per_link mode, otherwise 1.
+  std::size_t links_{1};
+  std::size_t frames_until_hop_{0};
+  dsp::VarianceTracker variance_;
+  std::vector<float> evicted_;
+  std::size_t frames_since_variance_rebuild_{0};
+  std::size_t windows_until_reselect_{0};
+  dsp::TimingTracker timing_;
+  FrameSignals ingest_;
+  // Per-window buffers, reused so that a warmed-up ProcessFrame does not touch the heap.
+  std::vector<std::uint64_t> timestamps_;
+  // Conditioned phase of the selected subcarriers, one window-length row each in selection
+  // order.
+  std::vector<float> phase_rows_;
+  std::vector<float> resampled_rows_;
+  dsp::ResamplePlan resample_plan_;
+  std::vector<std::pair<float, std::size_t>> variance_index_;
+  // One window-length row per link.
+  std::vector<float> aggregate_;
+  std::vector<float> smoothed_;
+  // Magnitude spectra, one row of fft_len / 2 bins per link.
+  std::vector<float> spectrum_;
+  std::vector<float> link_energy_;
+  std::vector<float> scratch_;
+  std::vector<float> row_scratch_;
+  dsp::OrderStatistics order_stats_;
+
+  dsp::SlidingDft sliding_dft_;
+  std::vector<std::size_t> sliding_selected_;
+  std::vector<std::size_t> selected_scratch_;
+  std::vector<float> unwrap_last_;
+  std::vector<double> unwrap_sum_;
 };
 
 } // namespace aethersense
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+#include "aethersense/core/frame_pool.hpp"
+#include "aethersense/io/csi_reader.hpp"
+#include "aethersense/io/stream_reader.hpp"
+#include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/pipeline.hpp"
+
+namespace aethersense {
+
+// Single-stream runtime that overlaps parsing with DSP: a reader thread parses frames into a
+// SpscRingBuffer of runtime.ring_buffer_capacity_frames (rounded up to a power of two), and the
+// thread calling Run() drains it in batches of up to runtime.max_batch_frames through the
+// Pipeline. In io.mode "tail" a full buffer applies runtime.backpressure; a file is not a live
+// source, so file mode always blocks the reader rather than dropping frames. Frames travel
+// through the ring as PooledFrame handles, so their sample buffers are recycled rather than
+// allocated per frame. A file-mode reader that reads in place (a mapped binary capture) has no
+// parsing to overlap, so Run() hands its frame views to the Pipeline directly on the calling
+// thread, without a reader thread or a copy.
+class PipelinedRunner {
+public:
+  // Called on the processing thread, in frame order.
+  using DecisionSink = std::function<void(const Decision &decision, const RuntimeMetrics &metrics)>;
+
+  PipelinedRunner(const Config &config, std::unique_ptr<ICsiReader> reader);
+
+  // Runs until the reader reaches end of input (never in tail mode) or either side fails.
+  Result<bool> Run(const DecisionSink &sink = {});
+
+  [[nodiscard]] const RuntimeMetrics &metrics() const { return metrics_; }
+  // Which side stopped the last Run(), if any.
+  [[nodiscard]] const std::optional<Error> &read_error() const { return read_error_; }
+  [[nodiscard]] const std::optional<Error> &pipeline_error() const { return pipeline_error_; }
+  // Reader statistics, published by the reader thread every runtime.max_batch_frames frames
+  // and whenever the reader runs out of input, fails or stops.
+  [[nodiscard]] io::StreamStats stream_stats() const;
+
+private:
+  // Run() for a reader that reads in place.
+  Result<bool> RunInPlace(const DecisionSink &sink);
+
+  Config config_;
+  std::unique_ptr<ICsiReader> reader_;
+  Pipeline pipeline_;
+  // Outlives the ring and batch in Run(), which hold handles into it.
+  FramePool pool_;
+  RuntimeMetrics metrics_;
+  std::optional<Error> read_error_;
+  std::optional<Error> pipeline_error_;
+  std::atomic<std::size_t> frames_read_{0};
+  mutable std::mutex stats_mutex_;
+  io::StreamStats stats_;
+};
+
+} // namespace aethersense
@@ -20,20 +20,28 @@ public:
   explicit RingBuffer(std::size_t capacity)
       : capacity_(capacity), buffer_(capacity), head_(0), tail_(0), size_(0) {}
 
+  // Returns false when `item` was not queued: the buffer is closed, kDropNewest found it full
+  // (counted as dropped) or kBlock timed out (not counted; the caller may retry).
   bool push(T &&item, BackpressurePolicy policy,
             std::chrono::milliseconds block_timeout = std::chrono::milliseconds(100)) {
     std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+      return false;
+    }
     if (policy == BackpressurePolicy::kBlock) {
-      cv_not_full_.wait_for(lock, block_timeout, [this] { return size_ < capacity_; });
-      if (size_ == capacity_) {
+      cv_not_full_.wait_for(lock, block_timeout,
+                            [this] { return size_ < capacity_ || closed_; });
+      if (size_ == capacity_ || closed_) {
         return false;
       }
     } else if (policy == BackpressurePolicy::kDropNewest && size_ == capacity_) {
+      ++dropped_;
       return false;
     } else if (policy == BackpressurePolicy::kDropOldest && size_ == capacity_) {
       buffer_[tail_].reset();
       tail_ = (tail_ + 1) % capacity_;
       --size_;
+      ++dropped_;
     }
 
     buffer_[head_] = std::move(item);
@@ -71,6 +79,48 @@ public:
     return out;
   }
 
+  // Waits up to `timeout` for at least one item, then moves up to `max_items` into `out`
+  // (replacing its contents) under a single lock. Returns the number of items taken; 0 on
+  // timeout or once the buffer is closed and drained.
+  std::size_t pop_batch(std::vector<T> &out, std::size_t max_items,
+                        std::chrono::milliseconds timeout) {
+    out.clear();
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_not_empty_.wait_for(lock, timeout, [this] { return size_ > 0 || closed_; });
+    while (size_ > 0 && out.size() < max_items) {
+      out.push_back(std::move(*buffer_[tail_]));
+      buffer_[tail_].reset();
+      tail_ = (tail_ + 1) % capacity_;
+      --size_;
+    }
+    lock.unlock();
+    if (!out.empty()) {
+      cv_not_full_.notify_all();
+    }
+    return out.size();
+  }
+
+  // Rejects further pushes and wakes every waiter; queued items can still be popped.
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    cv_not_empty_.notify_all();
+    cv_not_full_.notify_all();
+  }
+
+  [[nodiscard]] bool closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  // Items discarded by the drop_oldest / drop_newest policies.
+  [[nodiscard]] std::size_t dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+  }
+
   [[nodiscard]] std::size_t size() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return size_;
@@ -84,6 +134,8 @@ private:
   std::size_t head_;
   std::size_t tail_;
   std::size_t size_;
+  std::size_t dropped_{0};
+  bool closed_{false};
   mutable std::mutex mutex_;
   std::condition_variable cv_not_empty_;
   std::condition_variable cv_not_full_;
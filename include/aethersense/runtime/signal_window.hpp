@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace aethersense {
+
+// Fixed-capacity sliding window of per-frame signals stored as structure-of-arrays rings.
+// Each channel (subcarrier) owns a contiguous history row, so pushing a frame writes one
+// column and never moves older samples.
+class SignalWindow {
+public:
+  template <typename T> struct Segments {
+    std::span<const T> older;
+    std::span<const T> newer;
+  };
+
+  void Reset(std::size_t capacity, std::size_t channels) {
+    capacity_ = capacity;
+    channels_ = channels;
+    timestamps_.assign(capacity_, 0);
+    amplitude_.assign(capacity_ * channels_, 0.0F);
+    phase_.assign(capacity_ * channels_, 0.0F);
+    Clear();
+  }
+
+  void Clear() {
+    start_ = 0;
+    size_ = 0;
+  }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] std::size_t capacity() const { return capacity_; }
+  [[nodiscard]] std::size_t channels() const { return channels_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] bool full() const { return size_ == capacity_; }
+
+  // Appends one frame, evicting the oldest one when the window is full.
+  void Push(std::uint64_t timestamp_ns, std::span<const float> amplitude_by_ch,
+            std::span<const float> phase_by_ch) {
+    std::size_t slot = 0;
+    if (size_ == capacity_) {
+      slot = start_;
+      start_ = Wrap(start_ + 1);
+    } else {
+      slot = Wrap(start_ + size_);
+      ++size_;
+    }
+    timestamps_[slot] = timestamp_ns;
+    for (std::size_t ch = 0; ch < channels_; ++ch) {
+      amplitude_[ch * capacity_ + slot] = amplitude_by_ch[ch];
+      phase_[ch * capacity_ + slot] = phase_by_ch[ch];
+    }
+  }
+
+  [[nodiscard]] std::uint64_t timestamp(std::size_t t) const { return timestamps_[Wrap(start_ + t)]; }
+  [[nodiscard]] std::uint64_t newest_timestamp() const { return timestamp(size_ - 1); }
+
+  // Chronological views of a ring row: `older` followed by `newer`.
+  [[nodiscard]] Segments<std::uint64_t> timestamps() const { return Split(timestamps_.data()); }
+  [[nodiscard]] Segments<float> amplitude(std::size_t ch) const {
+    return Split(amplitude_.data() + ch * capacity_);
+  }
+  [[nodiscard]] Segments<float> phase(std::size_t ch) const {
+    return Split(phase_.data() + ch * capacity_);
+  }
+
+  void CopyTimestamps(std::span<std::uint64_t> out) const { Linearize(timestamps(), out); }
+  void CopyAmplitude(std::size_t ch, std::span<float> out) const { Linearize(amplitude(ch), out); }
+  void CopyPhase(std::size_t ch, std::span<float> out) const { Linearize(phase(ch), out); }
+
+private:
+  [[nodiscard]] std::size_t Wrap(std::size_t i) const { return i >= capacity_ ? i - capacity_ : i; }
+
+  template <typename T> [[nodiscard]] Segments<T> Split(const T *row) const {
+    const std::size_t first = std::min(size_, capacity_ - start_);
+    return {std::span<const T>(row + start_, first), std::span<const T>(row, size_ - first)};
+  }
+
+  template <typename T> static void Linearize(const Segments<T> &seg, std::span<T> out) {
+    std::copy(seg.older.begin(), seg.older.end(), out.begin());
+    std::copy(seg.newer.begin(), seg.newer.end(),
+              out.begin() + static_cast<std::ptrdiff_t>(seg.older.size()));
+  }
+
+  std::size_t capacity_{0};
+  std::size_t channels_{0};
+  std::size_t start_{0};
+  std::size_t size_{0};
+  std::vector<std::uint64_t> timestamps_;
+  std::vector<float> amplitude_;
+  std::vector<float> phase_;
+};
+
+} // namespace aethersense
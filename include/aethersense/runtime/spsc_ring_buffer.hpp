@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "aethersense/runtime/ring_buffer.hpp"
+
+namespace aethersense {
+
+namespace detail {
+
+// Sleeps while `word` still holds `expected`, for at most `timeout` (a futex wait on Linux, a
+// short sleep elsewhere). Spurious returns are allowed; callers re-check their condition.
+void FutexWait(std::atomic<std::uint32_t> &word, std::uint32_t expected,
+               std::chrono::nanoseconds timeout);
+void FutexWakeAll(std::atomic<std::uint32_t> &word);
+
+} // namespace detail
+
+// Lock-free single-producer/single-consumer counterpart of RingBuffer with the same policies
+// and queue API. Capacity is rounded up to a power of two so that positions map to slots with a
+// mask. Every slot carries a sequence number (Vyukov-style): the producer fills a slot only once
+// the consumer has released it, and the consumer claims items by advancing `tail_` with a CAS.
+// The CAS lets the producer claim the oldest item itself under kDropOldest without ever touching
+// a slot the consumer is reading. Batch calls publish and claim many items per atomic update.
+// The blocking policy and pop timeouts spin briefly and then sleep on a futex; the other side
+// only issues a wake-up system call when someone is actually waiting.
+template <typename T> class SpscRingBuffer {
+public:
+  explicit SpscRingBuffer(std::size_t capacity)
+      : capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask_(capacity_ - 1),
+        slots_(std::make_unique<Slot[]>(capacity_)) {
+    for (std::size_t i = 0; i < capacity_; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  SpscRingBuffer(const SpscRingBuffer &) = delete;
+  SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+  // Producer only. Same contract as RingBuffer::push.
+  bool push(T &&item, BackpressurePolicy policy,
+            std::chrono::milliseconds block_timeout = std::chrono::milliseconds(100)) {
+    return push_batch(std::span<T>(&item, 1), policy, block_timeout) == 1;
+  }
+
+  // Producer only. Moves `items` in order and returns how many were queued; the rest were
+  // rejected by kDropNewest (counted as dropped), or kBlock timed out, or the buffer is closed.
+  std::size_t push_batch(std::span<T> items, BackpressurePolicy policy,
+                         std::chrono::milliseconds block_timeout = std::chrono::milliseconds(100)) {
+    if (closed_.load(std::memory_order_acquire)) {
+      return 0;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + block_timeout;
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    std::size_t published = head;
+    std::size_t pushed = 0;
+    for (T &item : items) {
+      Slot &slot = slots_[head & mask_];
+      if (slot.seq.load(std::memory_order_acquire) != head) {
+        // Make everything written so far visible before waiting or evicting.
+        Publish(head, published);
+        if (!MakeRoom(slot, head, policy, deadline)) {
+          break;
+        }
+      }
+      slot.value = std::move(item);
+      slot.seq.store(head + 1, std::memory_order_release);
+      ++head;
+      ++pushed;
+    }
+    Publish(head, published);
+    if (policy == BackpressurePolicy::kDropNewest && pushed < items.size() &&
+        !closed_.load(std::memory_order_relaxed)) {
+      dropped_.fetch_add(items.size() - pushed, std::memory_order_relaxed);
+    }
+    return pushed;
+  }
+
+  // Consumer only.
+  bool try_pop(T &out) {
+    std::size_t tail = 0;
+    if (Claim(1, tail) == 0) {
+      return false;
+    }
+    Release(tail, 1, [&](T &value) { out = std::move(value); });
+    return true;
+  }
+
+  // Consumer only. Same contract as RingBuffer::pop_batch.
+  std::size_t pop_batch(std::vector<T> &out, std::size_t max_items,
+                        std::chrono::milliseconds timeout) {
+    out.clear();
+    if (max_items == 0) {
+      return 0;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+      std::size_t tail = 0;
+      const std::size_t n = Claim(max_items, tail);
+      if (n > 0) {
+        Release(tail, n, [&](T &value) { out.push_back(std::move(value)); });
+        return n;
+      }
+      if (closed_.load(std::memory_order_acquire)) {
+        // Items published before close() must still be drained.
+        if (head_.load(std::memory_order_acquire) != tail_.load(std::memory_order_acquire)) {
+          continue;
+        }
+        return 0;
+      }
+      if (!Wait(not_empty_epoch_, consumer_waiting_, deadline, [this] {
+            return head_.load(std::memory_order_acquire) != tail_.load(std::memory_order_acquire);
+          })) {
+        return 0;
+      }
+    }
+  }
+
+  // Rejects further pushes and wakes both sides; queued items can still be popped.
+  void close() {
+    closed_.store(true, std::memory_order_release);
+    Signal(not_empty_epoch_, consumer_waiting_);
+    Signal(not_full_epoch_, producer_waiting_);
+  }
+
+  [[nodiscard]] bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+  // Items discarded by the drop_oldest / drop_newest policies.
+  [[nodiscard]] std::size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] std::size_t size() const {
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    return head - std::min(head, tail);
+  }
+
+  [[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+private:
+  struct Slot {
+    std::atomic<std::size_t> seq{0};
+    T value{};
+  };
+
+  static constexpr int kSpinIterations = 64;
+
+  void Publish(std::size_t head, std::size_t &published) {
+    if (head == published) {
+      return;
+    }
+    head_.store(head, std::memory_order_release);
+    published = head;
+    Signal(not_empty_epoch_, consumer_waiting_);
+  }
+
+  // Producer side: true once the slot for `head` may be overwritten.
+  bool MakeRoom(Slot &slot, std::size_t head, BackpressurePolicy policy,
+                std::chrono::steady_clock::time_point deadline) {
+    while (true) {
+      if (slot.seq.load(std::memory_order_acquire) == head) {
+        return true;
+      }
+      if (closed_.load(std::memory_order_acquire)) {
+        return false;
+      }
+      std::size_t tail = tail_.load(std::memory_order_acquire);
+      if (head - tail < capacity_) {
+        // The consumer has claimed this slot and is still moving it out.
+        std::this_thread::yield();
+        continue;
+      }
+      if (policy == BackpressurePolicy::kDropNewest) {
+        return false;
+      }
+      if (policy == BackpressurePolicy::kDropOldest) {
+        if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel)) {
+          // The oldest item is ours now; the caller's move-assignment discards it.
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        continue;
+      }
+      if (!Wait(not_full_epoch_, producer_waiting_, deadline, [&] {
+            return slot.seq.load(std::memory_order_acquire) == head ||
+                   head - tail_.load(std::memory_order_acquire) < capacity_;
+          })) {
+        return false;
+      }
+    }
+  }
+
+  // Consumer side: claims up to `max_items` published items starting at `tail`.
+  std::size_t Claim(std::size_t max_items, std::size_t &tail) {
+    tail = tail_.load(std::memory_order_acquire);
+    while (true) {
+      const std::size_t head = head_.load(std::memory_order_acquire);
+      if (head == tail) {
+        return 0;
+      }
+      const std::size_t n = std::min(max_items, head - tail);
+      if (tail_.compare_exchange_weak(tail, tail + n, std::memory_order_acq_rel)) {
+        return n;
+      }
+    }
+  }
+
+  template <typename Sink> void Release(std::size_t tail, std::size_t n, Sink &&sink) {
+    for (std::size_t i = 0; i < n; ++i) {
+      Slot &slot = slots_[(tail + i) & mask_];
+      sink(slot.value);
+      slot.seq.store(tail + i + capacity_, std::memory_order_release);
+    }
+    Signal(not_full_epoch_, producer_waiting_);
+  }
+
+  void Signal(std::atomic<std::uint32_t> &epoch, std::atomic<bool> &waiting) {
+    // Pairs with the fence in Wait(): either the waiter sees the new state on its re-check, or
+    // this load sees it waiting and the epoch bump makes its futex wait return.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+      epoch.fetch_add(1, std::memory_order_release);
+      detail::FutexWakeAll(epoch);
+    }
+  }
+
+  // Spins, then sleeps on `epoch` until `ready()` or the deadline; false on timeout.
+  template <typename Ready>
+  bool Wait(std::atomic<std::uint32_t> &epoch, std::atomic<bool> &waiting,
+            std::chrono::steady_clock::time_point deadline, Ready &&ready) {
+    for (int i = 0; i < kSpinIterations; ++i) {
+      if (ready() || closed_.load(std::memory_order_acquire)) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    const std::uint32_t observed = epoch.load(std::memory_order_acquire);
+    waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool ok = true;
+    if (!ready() && !closed_.load(std::memory_order_acquire)) {
+      const auto remaining = deadline - std::chrono::steady_clock::now();
+      if (remaining <= std::chrono::steady_clock::duration::zero()) {
+        ok = false;
+      } else {
+        detail::FutexWait(epoch, observed,
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+      }
+    }
+    waiting.store(false, std::memory_order_relaxed);
+    return ok;
+  }
+
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Producer- and consumer-owned indices on separate cache lines.
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::atomic<std::uint32_t> not_empty_epoch_{0};
+  std::atomic<bool> consumer_waiting_{false};
+  alignas(64) std::atomic<std::uint32_t> not_full_epoch_{0};
+  std::atomic<bool> producer_waiting_{false};
+  alignas(64) std::atomic<std::size_t> dropped_{0};
+  std::atomic<bool> closed_{false};
+};
+
+} // namespace aethersense
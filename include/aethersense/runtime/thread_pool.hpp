@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aethersense {
+
+// Fixed set of worker threads, each owning a task deque. A worker runs its own deque LIFO (a
+// task it just queued is still warm in its cache) and, once that is empty, steals the oldest
+// task from another worker, so uneven load spreads over the pool without a shared queue.
+class WorkStealingPool {
+public:
+  // `threads` == 0 uses std::thread::hardware_concurrency().
+  explicit WorkStealingPool(std::size_t threads = 0);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  [[nodiscard]] std::size_t size() const { return thread_count_; }
+
+  // Queues `task`: on the calling worker's own deque when called from a task of this pool,
+  // otherwise round-robin over the workers.
+  void Submit(std::function<void()> task);
+  // Like Submit(), but from a task of this pool queues `task` behind everything already on the
+  // worker's deque. For a task that requeues itself to continue: with Submit() the owner would
+  // pop it straight back (LIFO) and the tasks queued before it would never run.
+  void Yield(std::function<void()> task);
+  // Blocks until every submitted task, including those queued by running tasks, has finished.
+  void Wait();
+
+private:
+  struct alignas(64) Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void Push(std::function<void()> task, bool behind);
+  void WorkerLoop(std::size_t index);
+  bool TryTake(std::size_t index, std::function<void()> &task);
+
+  // Fixed before any worker starts; workers_ itself is still growing while they run.
+  std::size_t thread_count_{0};
+  std::unique_ptr<Queue[]> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> next_queue_{0};
+
+  std::mutex state_mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable idle_cv_;
+  // Tasks sitting in a deque, and tasks queued or running; guarded by state_mutex_.
+  std::size_t queued_{0};
+  std::size_t pending_{0};
+  bool stop_{false};
+};
+
+} // namespace aethersense
@@ -55,11 +55,31 @@ Result<bool> ValidateConfig(const Config &cfg, bool require_existing_path,
   }
   if (cfg.io.mode != "file" && cfg.io.mode != "tail")
     return Error{ErrorCode::kInvalidConfig, "io.mode must be file|tail"};
+  if (cfg.io.format != "csv" && cfg.io.format != "jsonl" && cfg.io.format != "binary" &&
+      cfg.io.format != "compressed")
+    return Error{ErrorCode::kInvalidConfig, "io.format must be csv|jsonl|binary|compressed"};
+  if ((cfg.io.format == "binary" || cfg.io.format == "compressed") && cfg.io.mode != "file")
+    return Error{ErrorCode::kInvalidConfig, "io.format " + cfg.io.format + " requires io.mode file"};
   if (cfg.io.start_position != "begin" && cfg.io.start_position != "end" &&
-      cfg.io.start_position != "checkpoint")
+      cfg.io.start_position != "checkpoint" && cfg.io.start_position != "offset")
     return Error{ErrorCode::kInvalidConfig, "invalid io.start_position"};
+  if (cfg.io.checkpoint_every_records == 0 || cfg.io.checkpoint_interval_ms <= 0)
+    return Error{ErrorCode::kInvalidConfig, "io checkpoint batch thresholds must be >0"};
   if (cfg.io.rotate_handling != "reopen" && cfg.io.rotate_handling != "error")
     return Error{ErrorCode::kInvalidConfig, "invalid io.rotate_handling"};
+  if (cfg.io.reader != "auto" && cfg.io.reader != "mmap" && cfg.io.reader != "stream" &&
+      cfg.io.reader != "inotify")
+    return Error{ErrorCode::kInvalidConfig, "io.reader must be auto|mmap|stream|inotify"};
+  if (cfg.io.reader == "mmap" && cfg.io.mode != "file")
+    return Error{ErrorCode::kInvalidConfig, "io.reader mmap requires io.mode file"};
+  if (cfg.io.reader == "inotify" && cfg.io.mode != "tail")
+    return Error{ErrorCode::kInvalidConfig, "io.reader inotify requires io.mode tail"};
+  if (cfg.io.parse_threads > 1024)
+    return Error{ErrorCode::kInvalidConfig, "io.parse_threads must be <= 1024"};
+  if (cfg.io.parse_threads != 1 && cfg.io.mode != "file")
+    return Error{ErrorCode::kInvalidConfig, "io.parse_threads requires io.mode file"};
+  if (cfg.io.parse_chunk_bytes == 0 || cfg.io.parse_chunk_bytes > (std::size_t{1} << 30U))
+    return Error{ErrorCode::kInvalidConfig, "io.parse_chunk_bytes must be in [1, 1073741824]"};
   if (cfg.io.max_corrupt_ratio < 0.0F || cfg.io.max_corrupt_ratio > 1.0F)
     return Error{ErrorCode::kInvalidConfig, "io.max_corrupt_ratio must be in [0,1]"};
   if (cfg.io.poll_interval_ms <= 0 || cfg.io.max_consecutive_errors <= 0)
@@ -68,18 +88,38 @@ Result<bool> ValidateConfig(const Config &cfg, bool require_existing_path,
     return Error{ErrorCode::kInvalidConfig, "dsp.resampling.method unsupported"};
   if (cfg.dsp.outlier.method != "mad" && cfg.dsp.outlier.method != "hampel")
     return Error{ErrorCode::kInvalidConfig, "dsp.outlier.method unsupported"};
+  if (cfg.dsp.fft.engine != "fft" && cfg.dsp.fft.engine != "sliding_dft")
+    return Error{ErrorCode::kInvalidConfig, "dsp.fft.engine must be fft|sliding_dft"};
+  if (cfg.dsp.fft.engine == "sliding_dft" && cfg.dsp.smoothing.type == "median")
+    return Error{ErrorCode::kInvalidConfig, "dsp.fft.engine sliding_dft requires ema smoothing"};
+  if (cfg.dsp.link_mode != "averaged" && cfg.dsp.link_mode != "per_link")
+    return Error{ErrorCode::kInvalidConfig, "dsp.link_mode must be averaged|per_link"};
+  if (cfg.dsp.link_fusion != "max" && cfg.dsp.link_fusion != "mean" &&
+      cfg.dsp.link_fusion != "median")
+    return Error{ErrorCode::kInvalidConfig, "dsp.link_fusion must be max|mean|median"};
+  if (cfg.dsp.link_mode == "per_link" && cfg.dsp.fft.engine != "fft")
+    return Error{ErrorCode::kInvalidConfig, "dsp.link_mode per_link requires dsp.fft.engine fft"};
   if (cfg.dsp.outlier.window < 3)
     return Error{ErrorCode::kInvalidConfig, "dsp.outlier.window must be >=3"};
 
   if (cfg.dsp.window_frames < 16) {
     return Error{ErrorCode::kInvalidConfig, "dsp.window_frames must be >= 16"};
   }
+  if (cfg.dsp.hop_frames < 1 || cfg.dsp.hop_frames > cfg.dsp.window_frames) {
+    return Error{ErrorCode::kInvalidConfig, "dsp.hop_frames must be in [1, window_frames]"};
+  }
+  if (cfg.dsp.topk_reselect_every < 1) {
+    return Error{ErrorCode::kInvalidConfig, "dsp.topk_reselect_every must be >= 1"};
+  }
   if (cfg.runtime.ring_buffer_capacity_frames < 8) {
     return Error{ErrorCode::kInvalidConfig, "runtime.ring_buffer_capacity_frames must be >= 8"};
   }
   if (cfg.runtime.max_batch_frames > cfg.runtime.ring_buffer_capacity_frames) {
     return Error{ErrorCode::kInvalidConfig, "runtime.max_batch_frames must be <= capacity"};
   }
+  if (cfg.runtime.worker_threads > 1024) {
+    return Error{ErrorCode::kInvalidConfig, "runtime.worker_threads must be <= 1024"};
+  }
   if (detected_subcarrier_count > 0 &&
       (cfg.dsp.topk_subcarriers < 1 || cfg.dsp.topk_subcarriers > detected_subcarrier_count)) {
     return Error{ErrorCode::kInvalidConfig, "dsp.topk_subcarriers out of range"};
@@ -108,8 +148,23 @@ Result<Config> LoadConfigFromJsonFile(const std::string &path) {
   ExtractOptional(text, "path", cfg.io.path);
   ExtractOptional(text, "mode", cfg.io.mode);
   ExtractOptional(text, "checkpoint_path", cfg.io.checkpoint_path);
+  {
+    // Checked before the cast: a negative count would become a huge, valid-looking one.
+    int v = 0;
+    if (ExtractOptional(text, "checkpoint_every_records", v)) {
+      if (v < 1)
+        return Error{ErrorCode::kInvalidConfig, "io.checkpoint_every_records must be >0"};
+      cfg.io.checkpoint_every_records = static_cast<std::size_t>(v);
+    }
+  }
+  ExtractOptional(text, "checkpoint_interval_ms", cfg.io.checkpoint_interval_ms);
+  ExtractOptional(text, "checkpoint_fsync", cfg.io.checkpoint_fsync);
+  ExtractOptional(text, "checkpoint_async", cfg.io.checkpoint_async);
   ExtractOptional(text, "start_position", cfg.io.start_position);
   ExtractOptional(text, "rotate_handling", cfg.io.rotate_handling);
+  ExtractOptional(text, "reader", cfg.io.reader);
+  { int v=0; if (ExtractOptional(text, "parse_threads", v)) cfg.io.parse_threads=static_cast<std::size_t>(v); }
+  { int v=0; if (ExtractOptional(text, "parse_chunk_bytes", v)) cfg.io.parse_chunk_bytes=static_cast<std::size_t>(v); }
   ExtractOptional(text, "max_corrupt_ratio", cfg.io.max_corrupt_ratio);
   { int v=0; if (ExtractOptional(text, "max_partial_line_bytes", v)) cfg.io.max_partial_line_bytes=static_cast<std::size_t>(v); }
   ExtractOptional(text, "poll_interval_ms", cfg.io.poll_interval_ms);
@@ -117,11 +172,16 @@ Result<Config> LoadConfigFromJsonFile(const std::string &path) {
 
   { int v=0; if (ExtractOptional(text, "window_frames", v)) cfg.dsp.window_frames=static_cast<std::size_t>(v); }
   { int v=0; if (ExtractOptional(text, "topk_subcarriers", v)) cfg.dsp.topk_subcarriers=static_cast<std::size_t>(v); }
+  { int v=0; if (ExtractOptional(text, "hop_frames", v)) cfg.dsp.hop_frames=static_cast<std::size_t>(v); }
+  { int v=0; if (ExtractOptional(text, "topk_reselect_every", v)) cfg.dsp.topk_reselect_every=static_cast<std::size_t>(v); }
+  ExtractOptional(text, "link_mode", cfg.dsp.link_mode);
+  ExtractOptional(text, "link_fusion", cfg.dsp.link_fusion);
   ExtractOptional(text, "type", cfg.dsp.smoothing.type);
   ExtractOptional(text, "alpha", cfg.dsp.smoothing.alpha);
   ExtractOptional(text, "kernel", cfg.dsp.smoothing.kernel);
   ExtractOptional(text, "window", cfg.dsp.fft.window);
   ExtractOptional(text, "zero_pad_pow2", cfg.dsp.fft.zero_pad_pow2);
+  ExtractOptional(text, "engine", cfg.dsp.fft.engine);
   ExtractOptional(text, "method", cfg.dsp.resampling.method);
   ExtractOptional(text, "reject_jitter_ratio", cfg.dsp.resampling.reject_jitter_ratio);
   ExtractOptional(text, "k", cfg.dsp.outlier.k);
@@ -138,6 +198,7 @@ Result<Config> LoadConfigFromJsonFile(const std::string &path) {
   ExtractOptional(text, "max_jitter_ratio", cfg.runtime.max_jitter_ratio);
   ExtractOptional(text, "backpressure", cfg.runtime.backpressure);
   ExtractOptional(text, "report_every_seconds", cfg.runtime.report_every_seconds);
+  { int v=0; if (ExtractOptional(text, "worker_threads", v)) cfg.runtime.worker_threads=static_cast<std::size_t>(v); }
   ExtractOptional(text, "level", cfg.logging.level);
 
   auto valid = ValidateConfig(cfg, false);
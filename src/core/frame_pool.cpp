@@ -0,0 +1,45 @@
+#include "aethersense/core/frame_pool.hpp"
+
+namespace aethersense {
+
+void PooledFrame::Reset() {
+  if (pool_ != nullptr) {
+    std::exchange(pool_, nullptr)->Release(std::move(frame_));
+  }
+}
+
+PooledFrame FramePool::Acquire() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_.empty()) {
+      CsiFrame frame = std::move(free_.back());
+      free_.pop_back();
+      return PooledFrame(this, std::move(frame));
+    }
+    ++created_total_;
+  }
+  return PooledFrame(this, CsiFrame{});
+}
+
+void FramePool::Release(CsiFrame &&frame) {
+  frame.data.clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_.size() < max_cached_) {
+    if (free_.capacity() == 0) {
+      free_.reserve(max_cached_);
+    }
+    free_.push_back(std::move(frame));
+  }
+}
+
+std::size_t FramePool::cached() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return free_.size();
+}
+
+std::size_t FramePool::created_total() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return created_total_;
+}
+
+} // namespace aethersense
@@ -6,19 +6,25 @@
 namespace aethersense::dsp {
 
 void RemoveCommonPhaseError(std::vector<std::vector<float>> &phase_by_sc, bool robust_median) {
+  std::vector<float> scratch;
+  RemoveCommonPhaseError(phase_by_sc, robust_median, scratch);
+}
+
+void RemoveCommonPhaseError(std::vector<std::vector<float>> &phase_by_sc, bool robust_median,
+                            std::vector<float> &vals) {
   if (phase_by_sc.empty() || phase_by_sc[0].empty())
     return;
   const std::size_t t_count = phase_by_sc[0].size();
   for (std::size_t t = 0; t < t_count; ++t) {
-    std::vector<float> vals;
-    vals.reserve(phase_by_sc.size());
+    vals.clear();
     for (const auto &series : phase_by_sc) {
       vals.push_back(series[t]);
     }
     float cpe = 0.0F;
     if (robust_median) {
-      std::sort(vals.begin(), vals.end());
-      cpe = vals[vals.size() / 2];
+      const auto mid = vals.begin() + static_cast<std::ptrdiff_t>(vals.size() / 2);
+      std::nth_element(vals.begin(), mid, vals.end());
+      cpe = *mid;
     } else {
       cpe = std::accumulate(vals.begin(), vals.end(), 0.0F) / static_cast<float>(vals.size());
     }
@@ -28,7 +34,20 @@ void RemoveCommonPhaseError(std::vector<std::vector<float>> &phase_by_sc, bool r
   }
 }
 
-void RemoveLinearTrend(std::vector<float> &series) {
+float RemoveFrameCommonPhaseError(std::span<float> phase_by_sc, std::vector<float> &scratch) {
+  if (phase_by_sc.empty())
+    return 0.0F;
+  scratch.assign(phase_by_sc.begin(), phase_by_sc.end());
+  const auto mid = scratch.begin() + static_cast<std::ptrdiff_t>(scratch.size() / 2);
+  std::nth_element(scratch.begin(), mid, scratch.end());
+  const float cpe = *mid;
+  for (float &v : phase_by_sc) {
+    v -= cpe;
+  }
+  return cpe;
+}
+
+void RemoveLinearTrend(std::span<float> series) {
   if (series.size() < 2)
     return;
   const float first = series.front();
@@ -0,0 +1,162 @@
+#include "aethersense/dsp/fft_plan.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aethersense::dsp {
+namespace {
+
+constexpr double kTwoPi = 6.28318530717958647692;
+
+std::complex<float> Twiddle(std::size_t k, std::size_t n) {
+  const double angle = -kTwoPi * static_cast<double>(k) / static_cast<double>(n);
+  return {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+}
+
+bool IsPow2(std::size_t n) { return n >= 2 && (n & (n - 1)) == 0; }
+
+} // namespace
+
+FftPlan::FftPlan(std::size_t signal_len, bool zero_pad_pow2, WindowType window)
+    : signal_len_(signal_len), fft_len_(zero_pad_pow2 ? NextPow2(signal_len) : signal_len),
+      zero_pad_pow2_(zero_pad_pow2), window_type_(window),
+      window_(BuildWindow(window, signal_len)) {
+  if (IsPow2(fft_len_)) {
+    const std::size_t half = fft_len_ / 2;
+    std::size_t bits = 0;
+    while ((std::size_t{1} << bits) < half) {
+      ++bits;
+    }
+    bit_reverse_.resize(half);
+    for (std::size_t i = 0; i < half; ++i) {
+      std::size_t r = 0;
+      for (std::size_t b = 0; b < bits; ++b) {
+        r |= ((i >> b) & 1U) << (bits - 1 - b);
+      }
+      bit_reverse_[i] = static_cast<std::uint32_t>(r);
+    }
+    twiddles_.resize(half / 2);
+    for (std::size_t j = 0; j < twiddles_.size(); ++j) {
+      twiddles_[j] = Twiddle(j, half);
+    }
+    split_twiddles_.resize(half);
+    for (std::size_t k = 0; k < half; ++k) {
+      split_twiddles_[k] = Twiddle(k, fft_len_);
+    }
+  } else {
+    dft_twiddles_.resize(fft_len_);
+    for (std::size_t k = 0; k < fft_len_; ++k) {
+      dft_twiddles_[k] = Twiddle(k, fft_len_);
+    }
+  }
+}
+
+bool FftPlan::Matches(std::size_t signal_len, bool zero_pad_pow2, WindowType window) const {
+  return signal_len_ == signal_len && zero_pad_pow2_ == zero_pad_pow2 && window_type_ == window;
+}
+
+void FftPlan::ApplyWindow(std::span<float> data) const {
+  const std::size_t n = std::min(data.size(), window_.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    data[i] *= window_[i];
+  }
+}
+
+void FftPlan::ComplexFft(std::span<std::complex<float>> a, std::size_t count) const {
+  const std::size_t n = a.size() / count;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t j = bit_reverse_[i];
+    if (i < j) {
+      std::swap_ranges(a.begin() + static_cast<std::ptrdiff_t>(i * count),
+                       a.begin() + static_cast<std::ptrdiff_t>((i + 1) * count),
+                       a.begin() + static_cast<std::ptrdiff_t>(j * count));
+    }
+  }
+  for (std::size_t len = 2; len <= n; len <<= 1U) {
+    const std::size_t half = len / 2;
+    const std::size_t stride = n / len;
+    for (std::size_t i = 0; i < n; i += len) {
+      for (std::size_t j = 0; j < half; ++j) {
+        const std::complex<float> w = twiddles_[j * stride];
+        std::complex<float> *top = &a[(i + j) * count];
+        std::complex<float> *bottom = &a[(i + j + half) * count];
+        for (std::size_t s = 0; s < count; ++s) {
+          const std::complex<float> u = top[s];
+          const std::complex<float> v = bottom[s] * w;
+          top[s] = u + v;
+          bottom[s] = u - v;
+        }
+      }
+    }
+  }
+}
+
+void FftPlan::MagnitudeSpectrum(std::span<const float> signal, std::vector<float> &out) {
+  MagnitudeSpectra(signal, 1, out);
+}
+
+void FftPlan::MagnitudeSpectra(std::span<const float> signals, std::size_t count,
+                               std::vector<float> &out) {
+  const std::size_t bins = fft_len_ / 2;
+  out.assign(bins * count, 0.0F);
+  if (count == 0) {
+    return;
+  }
+  const std::size_t len = signals.size() / count;
+  const std::size_t n = std::min(len, fft_len_);
+  if (!IsPow2(fft_len_)) {
+    for (std::size_t s = 0; s < count; ++s) {
+      const auto signal = signals.subspan(s * len, len);
+      for (std::size_t k = 0; k < bins; ++k) {
+        std::complex<float> acc(0.0F, 0.0F);
+        for (std::size_t i = 0; i < n; ++i) {
+          acc += signal[i] * dft_twiddles_[(k * i) % fft_len_];
+        }
+        out[s * bins + k] = std::abs(acc);
+      }
+    }
+    return;
+  }
+
+  // Pack even/odd samples as one half-length complex signal, transform, then split the
+  // spectra of the two real halves: X[k] = E[k] + W^k O[k].
+  work_.resize(bins * count);
+  for (std::size_t s = 0; s < count; ++s) {
+    const float *signal = signals.data() + s * len;
+    for (std::size_t i = 0; i < bins; ++i) {
+      const float re = 2 * i < n ? signal[2 * i] : 0.0F;
+      const float im = 2 * i + 1 < n ? signal[2 * i + 1] : 0.0F;
+      work_[i * count + s] = {re, im};
+    }
+  }
+  ComplexFft(work_, count);
+  for (std::size_t k = 0; k < bins; ++k) {
+    const std::complex<float> w = split_twiddles_[k];
+    const std::complex<float> *zk = &work_[k * count];
+    const std::complex<float> *zm = &work_[(k == 0 ? 0 : bins - k) * count];
+    for (std::size_t s = 0; s < count; ++s) {
+      const std::complex<float> z = zk[s];
+      const std::complex<float> zc = std::conj(zm[s]);
+      const std::complex<float> even = 0.5F * (z + zc);
+      const std::complex<float> odd = std::complex<float>(0.0F, -0.5F) * (z - zc);
+      out[s * bins + k] = std::abs(even + w * odd);
+    }
+  }
+}
+
+BinRange FftPlan::BandBins(float sample_rate_hz, float low_hz, float high_hz) {
+  for (auto &band : bands_) {
+    if (band.low_hz == low_hz && band.high_hz == high_hz) {
+      if (band.sample_rate_hz != sample_rate_hz) {
+        band.sample_rate_hz = sample_rate_hz;
+        band.bins = dsp::BandBins(sample_rate_hz, low_hz, high_hz, fft_len_);
+      }
+      return band.bins;
+    }
+  }
+  bands_.push_back(
+      {sample_rate_hz, low_hz, high_hz, dsp::BandBins(sample_rate_hz, low_hz, high_hz, fft_len_)});
+  return bands_.back().bins;
+}
+
+} // namespace aethersense::dsp
@@ -0,0 +1,214 @@
+#include "aethersense/dsp/order_statistics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace aethersense::dsp {
+namespace {
+
+template <typename T> bool IsNan(T v) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::isnan(v);
+  } else {
+    return false;
+  }
+}
+
+// Strict order of the set: numbers ascending, then NaN. Plain `<` is false for every NaN
+// comparison, which would leave NaN nodes wherever they were inserted and unmatchable on erase.
+template <typename T> bool Before(T a, T b) { return !IsNan(a) && (IsNan(b) || a < b); }
+
+} // namespace
+
+template <typename T> void BasicOrderStatistics<T>::Reset(std::size_t capacity) {
+  capacity_ = std::max<std::size_t>(capacity, 1);
+  // 1 + log2(capacity) levels keep the expected search cost logarithmic.
+  levels_ = 1;
+  while (levels_ < 32 && (std::size_t{1} << levels_) <= capacity_) {
+    ++levels_;
+  }
+  const std::size_t nodes = capacity_ + 1;
+  value_.resize(nodes);
+  height_.resize(nodes);
+  next_.resize(nodes * levels_);
+  width_.resize(nodes * levels_);
+  chain_.resize(levels_);
+  steps_.resize(levels_);
+  Clear();
+}
+
+template <typename T> void BasicOrderStatistics<T>::Clear() {
+  size_ = 0;
+  nan_count_ = 0;
+  for (std::size_t level = 0; level < levels_; ++level) {
+    Next(kHead, level) = kNil;
+    Width(kHead, level) = 1;
+  }
+  free_.resize(capacity_);
+  for (std::size_t i = 0; i < capacity_; ++i) {
+    free_[i] = static_cast<std::uint32_t>(capacity_ - i);
+  }
+}
+
+template <typename T> std::size_t BasicOrderStatistics<T>::RandomHeight() {
+  rng_ ^= rng_ << 13U;
+  rng_ ^= rng_ >> 17U;
+  rng_ ^= rng_ << 5U;
+  return std::min<std::size_t>(levels_, 1 + static_cast<std::size_t>(std::countr_zero(rng_)));
+}
+
+template <typename T> void BasicOrderStatistics<T>::Grow() {
+  std::vector<T> values(size_);
+  for (std::size_t i = 0; i < size_; ++i) {
+    values[i] = At(i);
+  }
+  Reset(2 * capacity_);
+  for (T v : values) {
+    Insert(v);
+  }
+}
+
+template <typename T> void BasicOrderStatistics<T>::Insert(T value) {
+  if (free_.empty()) {
+    Grow();
+  }
+  std::uint32_t node = kHead;
+  for (std::size_t level = levels_; level-- > 0;) {
+    steps_[level] = 0;
+    while (Next(node, level) != kNil && !Before(value, value_[Next(node, level)])) {
+      steps_[level] += Width(node, level);
+      node = Next(node, level);
+    }
+    chain_[level] = node;
+  }
+
+  const std::size_t height = RandomHeight();
+  const std::uint32_t added = free_.back();
+  free_.pop_back();
+  value_[added] = value;
+  height_[added] = static_cast<std::uint8_t>(height);
+  std::size_t steps = 0;
+  for (std::size_t level = 0; level < height; ++level) {
+    const std::uint32_t prev = chain_[level];
+    Next(added, level) = Next(prev, level);
+    Next(prev, level) = added;
+    Width(added, level) = Width(prev, level) - steps;
+    Width(prev, level) = steps + 1;
+    steps += steps_[level];
+  }
+  for (std::size_t level = height; level < levels_; ++level) {
+    ++Width(chain_[level], level);
+  }
+  ++size_;
+  nan_count_ += IsNan(value) ? 1 : 0;
+}
+
+template <typename T> bool BasicOrderStatistics<T>::Erase(T value) {
+  std::uint32_t node = kHead;
+  for (std::size_t level = levels_; level-- > 0;) {
+    while (Next(node, level) != kNil && Before(value_[Next(node, level)], value)) {
+      node = Next(node, level);
+    }
+    chain_[level] = node;
+  }
+  const std::uint32_t target = Next(chain_[0], 0);
+  if (target == kNil || Before(value, value_[target])) {
+    return false;
+  }
+
+  const std::size_t height = height_[target];
+  for (std::size_t level = 0; level < height; ++level) {
+    const std::uint32_t prev = chain_[level];
+    Width(prev, level) += Width(target, level) - 1;
+    Next(prev, level) = Next(target, level);
+  }
+  for (std::size_t level = height; level < levels_; ++level) {
+    --Width(chain_[level], level);
+  }
+  free_.push_back(target);
+  --size_;
+  nan_count_ -= IsNan(value) ? 1 : 0;
+  return true;
+}
+
+template <typename T> T BasicOrderStatistics<T>::At(std::size_t rank) const {
+  std::size_t remaining = rank + 1;
+  std::uint32_t node = kHead;
+  for (std::size_t level = levels_; level-- > 0;) {
+    while (Next(node, level) != kNil && Width(node, level) <= remaining) {
+      remaining -= Width(node, level);
+      node = Next(node, level);
+    }
+  }
+  return value_[node];
+}
+
+template <typename T> T BasicOrderStatistics<T>::Median() const {
+  if (size_ == 0) {
+    return T{};
+  }
+  const std::size_t m = size_ / 2;
+  if (size_ % 2 != 0) {
+    return At(m);
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    return T{0.5} * (At(m - 1) + At(m));
+  } else {
+    const T lo = At(m - 1);
+    return lo + (At(m) - lo) / 2;
+  }
+}
+
+template <typename T> T BasicOrderStatistics<T>::Mad(T center) const {
+  if (size_ == 0) {
+    return T{};
+  }
+  const std::size_t take = size_ / 2 + 1;
+  const std::size_t numbers = size_ - nan_count_;
+  if (IsNan(center) || take > numbers) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  // Elements below `center` give deviations center - x that ascend walking down from the
+  // split; the rest give x - center ascending upward. Select the k-th smallest of the two
+  // sorted sequences by bisecting how many come from the lower side.
+  std::size_t split = 0;
+  std::uint32_t node = kHead;
+  for (std::size_t level = levels_; level-- > 0;) {
+    while (Next(node, level) != kNil && value_[Next(node, level)] < center) {
+      split += Width(node, level);
+      node = Next(node, level);
+    }
+  }
+  const auto lower = [&](std::size_t i) { return center - At(split - 1 - i); };
+  const auto upper = [&](std::size_t j) { return At(split + j) - center; };
+  const std::size_t lower_count = split;
+  const std::size_t upper_count = numbers - split; // NaN deviations rank last
+
+  std::size_t lo = take > upper_count ? take - upper_count : 0;
+  std::size_t hi = std::min(take, lower_count);
+  while (lo < hi) {
+    const std::size_t i = lo + (hi - lo) / 2;
+    if (lower(i) < upper(take - i - 1)) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+  const std::size_t j = take - lo;
+  T out = std::numeric_limits<T>::lowest();
+  if (lo > 0) {
+    out = std::max(out, lower(lo - 1));
+  }
+  if (j > 0) {
+    out = std::max(out, upper(j - 1));
+  }
+  return out;
+}
+
+template class BasicOrderStatistics<float>;
+template class BasicOrderStatistics<std::uint64_t>;
+
+} // namespace aethersense::dsp
@@ -2,35 +2,44 @@
 
 #include <algorithm>
 #include <cmath>
-#include <numeric>
 
 namespace aethersense::dsp {
 
 void FilterOutliers(std::vector<float> &series, const std::string &method, float k, int window) {
+  OrderStatistics stats;
+  FilterOutliers(std::span<float>(series), method, k, window, stats);
+}
+
+void FilterOutliers(std::span<float> series, const std::string &method, float k, int window,
+                    OrderStatistics &stats) {
   if (series.empty() || window < 3)
     return;
-  const int half = window / 2;
-  for (int i = 0; i < static_cast<int>(series.size()); ++i) {
-    const int s = std::max(0, i - half);
-    const int e = std::min(static_cast<int>(series.size()), i + half + 1);
-    std::vector<float> local(series.begin() + s, series.begin() + e);
-    std::sort(local.begin(), local.end());
-    const float med = local[local.size() / 2];
-    std::vector<float> dev;
-    dev.reserve(local.size());
-    for (float v : local)
-      dev.push_back(std::fabs(v - med));
-    std::sort(dev.begin(), dev.end());
-    const float mad = std::max(1e-6F, dev[dev.size() / 2]);
+  const std::size_t half = static_cast<std::size_t>(window / 2);
+  const std::size_t n = series.size();
+  const bool hampel = method == "hampel";
+  stats.Reset(2 * half + 1);
+  for (std::size_t j = 0; j < std::min(n, half); ++j)
+    stats.Insert(series[j]);
+  // The window of sample i is [i - half, i + half] clipped to the series; values to the left
+  // of i are already filtered, and a replacement is swapped into the set as it happens.
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i > half)
+      stats.Erase(series[i - half - 1]);
+    if (i + half < n)
+      stats.Insert(series[i + half]);
+    const float med = stats.UpperMedian();
+    const float mad = std::max(1e-6F, stats.Mad(med));
     const float z = std::fabs(series[i] - med) / mad;
     if (z > k) {
-      if (method == "hampel") {
-        series[i] = med;
-      } else {
+      float replacement = med;
+      if (!hampel) {
         const float left = (i > 0) ? series[i - 1] : med;
-        const float right = (i + 1 < static_cast<int>(series.size())) ? series[i + 1] : med;
-        series[i] = 0.5F * (left + right);
+        const float right = (i + 1 < n) ? series[i + 1] : med;
+        replacement = 0.5F * (left + right);
       }
+      stats.Erase(series[i]);
+      stats.Insert(replacement);
+      series[i] = replacement;
     }
   }
 }
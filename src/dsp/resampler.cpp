@@ -8,25 +8,30 @@
 namespace aethersense::dsp {
 
 float JitterMetric(const std::vector<std::uint64_t> &timestamps_ns) {
+  std::vector<float> scratch;
+  return JitterMetric(timestamps_ns, scratch);
+}
+
+float JitterMetric(std::span<const std::uint64_t> timestamps_ns, std::vector<float> &scratch) {
   if (timestamps_ns.size() < 3)
     return 0.0F;
-  std::vector<float> dt;
-  dt.reserve(timestamps_ns.size() - 1);
+  scratch.clear();
   for (std::size_t i = 1; i < timestamps_ns.size(); ++i) {
-    dt.push_back(static_cast<float>(timestamps_ns[i] - timestamps_ns[i - 1]) / 1e9F);
+    scratch.push_back(static_cast<float>(timestamps_ns[i] - timestamps_ns[i - 1]) / 1e9F);
   }
-  std::vector<float> sorted = dt;
-  std::sort(sorted.begin(), sorted.end());
-  const float med = sorted[sorted.size() / 2];
-  if (med <= 0.0F)
-    return 1.0F;
-  const float mean = std::accumulate(dt.begin(), dt.end(), 0.0F) / static_cast<float>(dt.size());
+  const float mean =
+      std::accumulate(scratch.begin(), scratch.end(), 0.0F) / static_cast<float>(scratch.size());
   float var = 0.0F;
-  for (float v : dt) {
+  for (float v : scratch) {
     const float d = v - mean;
     var += d * d;
   }
-  var /= static_cast<float>(dt.size());
+  var /= static_cast<float>(scratch.size());
+  const auto mid = scratch.begin() + static_cast<std::ptrdiff_t>(scratch.size() / 2);
+  std::nth_element(scratch.begin(), mid, scratch.end());
+  const float med = *mid;
+  if (med <= 0.0F)
+    return 1.0F;
   return std::sqrt(var) / med;
 }
 
@@ -43,29 +48,59 @@ std::vector<float> ResampleToUniformGrid(const std::vector<std::uint64_t> &times
   std::sort(dtns.begin(), dtns.end());
   const std::uint64_t step = dtns[dtns.size() / 2];
 
+  ResamplePlan plan;
+  plan.Build(timestamps_ns, step, method);
   std::vector<float> out(samples.size(), 0.0F);
+  plan.Apply(samples, out);
+  return out;
+}
+
+void ResamplePlan::Build(std::span<const std::uint64_t> timestamps_ns, std::uint64_t step_ns,
+                         const std::string &method) {
+  const std::size_t n = timestamps_ns.size();
+  const bool nearest = method == "nearest";
+  lower_.resize(n);
+  upper_.resize(n);
+  weight_.resize(n);
   std::size_t src = 0;
-  for (std::size_t i = 0; i < out.size(); ++i) {
-    const auto t = timestamps_ns.front() + static_cast<std::uint64_t>(i) * step;
-    while (src + 1 < timestamps_ns.size() && timestamps_ns[src + 1] < t) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto t = timestamps_ns.front() + static_cast<std::uint64_t>(i) * step_ns;
+    while (src + 1 < n && timestamps_ns[src + 1] < t) {
       ++src;
     }
-    if (src + 1 >= timestamps_ns.size()) {
-      out[i] = samples.back();
+    if (src + 1 >= n) {
+      lower_[i] = upper_[i] = static_cast<std::uint32_t>(n - 1);
+      weight_[i] = 0.0F;
       continue;
     }
-    if (method == "nearest") {
+    if (nearest) {
       const auto dl = t - timestamps_ns[src];
       const auto dr = timestamps_ns[src + 1] - t;
-      out[i] = (dl <= dr) ? samples[src] : samples[src + 1];
+      lower_[i] = upper_[i] = static_cast<std::uint32_t>(dl <= dr ? src : src + 1);
+      weight_[i] = 0.0F;
       continue;
     }
     const float t0 = static_cast<float>(timestamps_ns[src]);
     const float t1 = static_cast<float>(timestamps_ns[src + 1]);
-    const float a = (static_cast<float>(t) - t0) / (t1 - t0 + 1e-9F);
-    out[i] = samples[src] + a * (samples[src + 1] - samples[src]);
+    lower_[i] = static_cast<std::uint32_t>(src);
+    upper_[i] = static_cast<std::uint32_t>(src + 1);
+    weight_[i] = (static_cast<float>(t) - t0) / (t1 - t0 + 1e-9F);
+  }
+}
+
+void ResamplePlan::Apply(std::span<const float> samples, std::span<float> out) const {
+  const std::size_t n = weight_.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const float lo = samples[lower_[i]];
+    out[i] = lo + weight_[i] * (samples[upper_[i]] - lo);
+  }
+}
+
+void ResamplePlan::ApplyRows(std::span<const float> rows, std::span<float> out) const {
+  const std::size_t n = weight_.size();
+  for (std::size_t offset = 0; n > 0 && offset + n <= rows.size(); offset += n) {
+    Apply(rows.subspan(offset, n), out.subspan(offset, n));
   }
-  return out;
 }
 
 } // namespace aethersense::dsp
@@ -0,0 +1,324 @@
+#include "aethersense/dsp/simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define AETHERSENSE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace aethersense::dsp::simd {
+namespace {
+
+constexpr float kPi = 3.14159265358979323846F;
+constexpr float kHalfPi = 0.5F * kPi;
+constexpr float kQuarterPi = 0.25F * kPi;
+constexpr float kTanPiOver8 = 0.414213562F;
+// Cephes atanf coefficients: atan(t) ~ t + t^3 * P(t^2) for |t| <= tan(pi/8).
+constexpr float kP0 = -3.33329491539e-1F;
+constexpr float kP1 = 1.99777106478e-1F;
+constexpr float kP2 = -1.38776856032e-1F;
+constexpr float kP3 = 8.05374449538e-2F;
+
+void ScalarKernel(const std::complex<float> *data, std::size_t links, std::size_t subcarriers,
+                  std::size_t begin, float *amplitude, float *phase) {
+  for (std::size_t sc = begin; sc < subcarriers; ++sc) {
+    float amp_sum = 0.0F;
+    float re = 0.0F;
+    float im = 0.0F;
+    for (std::size_t link = 0; link < links; ++link) {
+      const auto s = data[link * subcarriers + sc];
+      amp_sum += std::sqrt(s.real() * s.real() + s.imag() * s.imag());
+      re += s.real();
+      im += s.imag();
+    }
+    amplitude[sc] = amp_sum / static_cast<float>(links);
+    phase[sc] = FastAtan2(im, re);
+  }
+}
+
+#ifdef AETHERSENSE_SIMD_X86
+
+__m128 Atan2Sse2(__m128 y, __m128 x) {
+  const __m128 sign_mask = _mm_set1_ps(-0.0F);
+  const __m128 ax = _mm_andnot_ps(sign_mask, x);
+  const __m128 ay = _mm_andnot_ps(sign_mask, y);
+  const __m128 hi = _mm_max_ps(ax, ay);
+  const __m128 lo = _mm_min_ps(ax, ay);
+  __m128 z = _mm_div_ps(lo, _mm_max_ps(hi, _mm_set1_ps(1e-30F)));
+  const __m128 fold = _mm_cmpgt_ps(z, _mm_set1_ps(kTanPiOver8));
+  const __m128 one = _mm_set1_ps(1.0F);
+  z = _mm_or_ps(_mm_and_ps(fold, _mm_div_ps(_mm_sub_ps(z, one), _mm_add_ps(z, one))),
+                _mm_andnot_ps(fold, z));
+  const __m128 z2 = _mm_mul_ps(z, z);
+  __m128 p = _mm_set1_ps(kP3);
+  p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(kP2));
+  p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(kP1));
+  p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(kP0));
+  __m128 a = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z2), z), z);
+  a = _mm_add_ps(a, _mm_and_ps(fold, _mm_set1_ps(kQuarterPi)));
+  const __m128 swap = _mm_cmpgt_ps(ay, ax);
+  a = _mm_or_ps(_mm_and_ps(swap, _mm_sub_ps(_mm_set1_ps(kHalfPi), a)), _mm_andnot_ps(swap, a));
+  const __m128 neg_x = _mm_cmplt_ps(x, _mm_setzero_ps());
+  a = _mm_or_ps(_mm_and_ps(neg_x, _mm_sub_ps(_mm_set1_ps(kPi), a)), _mm_andnot_ps(neg_x, a));
+  return _mm_or_ps(a, _mm_and_ps(y, sign_mask));
+}
+
+// Each vector width processes whole blocks from `sc` and returns where it stopped; the
+// remainder falls through to a narrower width and finally the scalar loop.
+std::size_t Sse2Blocks(const std::complex<float> *data, std::size_t links,
+                       std::size_t subcarriers, std::size_t sc, float *amplitude, float *phase) {
+  const auto *raw = reinterpret_cast<const float *>(data);
+  const __m128 link_count = _mm_set1_ps(static_cast<float>(links));
+  for (; sc + 4 <= subcarriers; sc += 4) {
+    __m128 amp = _mm_setzero_ps();
+    __m128 re = _mm_setzero_ps();
+    __m128 im = _mm_setzero_ps();
+    for (std::size_t link = 0; link < links; ++link) {
+      const float *p = raw + 2 * (link * subcarriers + sc);
+      const __m128 a = _mm_loadu_ps(p);
+      const __m128 b = _mm_loadu_ps(p + 4);
+      const __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+      const __m128 i = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+      amp = _mm_add_ps(amp, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(i, i))));
+      re = _mm_add_ps(re, r);
+      im = _mm_add_ps(im, i);
+    }
+    _mm_storeu_ps(amplitude + sc, _mm_div_ps(amp, link_count));
+    _mm_storeu_ps(phase + sc, Atan2Sse2(im, re));
+  }
+  return sc;
+}
+
+void Sse2Kernel(const std::complex<float> *data, std::size_t links, std::size_t subcarriers,
+                float *amplitude, float *phase) {
+  const std::size_t sc = Sse2Blocks(data, links, subcarriers, 0, amplitude, phase);
+  ScalarKernel(data, links, subcarriers, sc, amplitude, phase);
+}
+
+__attribute__((target("avx2,fma"))) __m256 Atan2Avx2(__m256 y, __m256 x) {
+  const __m256 sign_mask = _mm256_set1_ps(-0.0F);
+  const __m256 ax = _mm256_andnot_ps(sign_mask, x);
+  const __m256 ay = _mm256_andnot_ps(sign_mask, y);
+  const __m256 hi = _mm256_max_ps(ax, ay);
+  const __m256 lo = _mm256_min_ps(ax, ay);
+  __m256 z = _mm256_div_ps(lo, _mm256_max_ps(hi, _mm256_set1_ps(1e-30F)));
+  const __m256 fold = _mm256_cmp_ps(z, _mm256_set1_ps(kTanPiOver8), _CMP_GT_OQ);
+  const __m256 one = _mm256_set1_ps(1.0F);
+  z = _mm256_blendv_ps(z, _mm256_div_ps(_mm256_sub_ps(z, one), _mm256_add_ps(z, one)), fold);
+  const __m256 z2 = _mm256_mul_ps(z, z);
+  __m256 p = _mm256_set1_ps(kP3);
+  p = _mm256_fmadd_ps(p, z2, _mm256_set1_ps(kP2));
+  p = _mm256_fmadd_ps(p, z2, _mm256_set1_ps(kP1));
+  p = _mm256_fmadd_ps(p, z2, _mm256_set1_ps(kP0));
+  __m256 a = _mm256_fmadd_ps(_mm256_mul_ps(p, z2), z, z);
+  a = _mm256_add_ps(a, _mm256_and_ps(fold, _mm256_set1_ps(kQuarterPi)));
+  a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(kHalfPi), a),
+                       _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+  a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(kPi), a),
+                       _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+  return _mm256_or_ps(a, _mm256_and_ps(y, sign_mask));
+}
+
+__attribute__((target("avx2,fma"))) void Avx2Kernel(const std::complex<float> *data,
+                                                     std::size_t links, std::size_t subcarriers,
+                                                     float *amplitude, float *phase) {
+  const auto *raw = reinterpret_cast<const float *>(data);
+  const __m256 link_count = _mm256_set1_ps(static_cast<float>(links));
+  std::size_t sc = 0;
+  for (; sc + 8 <= subcarriers; sc += 8) {
+    __m256 amp = _mm256_setzero_ps();
+    __m256 re = _mm256_setzero_ps();
+    __m256 im = _mm256_setzero_ps();
+    for (std::size_t link = 0; link < links; ++link) {
+      const float *p = raw + 2 * (link * subcarriers + sc);
+      const __m256 a = _mm256_loadu_ps(p);
+      const __m256 b = _mm256_loadu_ps(p + 8);
+      // In-lane shuffles leave 64-bit pairs as [a01 b01 a23 b23]; restore sample order.
+      const __m256 r = _mm256_castpd_ps(_mm256_permute4x64_pd(
+          _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))),
+          _MM_SHUFFLE(3, 1, 2, 0)));
+      const __m256 i = _mm256_castpd_ps(_mm256_permute4x64_pd(
+          _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))),
+          _MM_SHUFFLE(3, 1, 2, 0)));
+      amp = _mm256_add_ps(amp, _mm256_sqrt_ps(_mm256_fmadd_ps(r, r, _mm256_mul_ps(i, i))));
+      re = _mm256_add_ps(re, r);
+      im = _mm256_add_ps(im, i);
+    }
+    _mm256_storeu_ps(amplitude + sc, _mm256_div_ps(amp, link_count));
+    _mm256_storeu_ps(phase + sc, Atan2Avx2(im, re));
+  }
+  sc = Sse2Blocks(data, links, subcarriers, sc, amplitude, phase);
+  ScalarKernel(data, links, subcarriers, sc, amplitude, phase);
+}
+
+// GCC 12 flags the _mm512_undefined_ps() passthrough inside its own intrinsics.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f"))) __m512 Atan2Avx512(__m512 y, __m512 x) {
+  const __m512 ax = _mm512_abs_ps(x);
+  const __m512 ay = _mm512_abs_ps(y);
+  const __m512 hi = _mm512_max_ps(ax, ay);
+  const __m512 lo = _mm512_min_ps(ax, ay);
+  __m512 z = _mm512_div_ps(lo, _mm512_max_ps(hi, _mm512_set1_ps(1e-30F)));
+  const __mmask16 fold = _mm512_cmp_ps_mask(z, _mm512_set1_ps(kTanPiOver8), _CMP_GT_OQ);
+  const __m512 one = _mm512_set1_ps(1.0F);
+  z = _mm512_mask_div_ps(z, fold, _mm512_sub_ps(z, one), _mm512_add_ps(z, one));
+  const __m512 z2 = _mm512_mul_ps(z, z);
+  __m512 p = _mm512_set1_ps(kP3);
+  p = _mm512_fmadd_ps(p, z2, _mm512_set1_ps(kP2));
+  p = _mm512_fmadd_ps(p, z2, _mm512_set1_ps(kP1));
+  p = _mm512_fmadd_ps(p, z2, _mm512_set1_ps(kP0));
+  __m512 a = _mm512_fmadd_ps(_mm512_mul_ps(p, z2), z, z);
+  a = _mm512_mask_add_ps(a, fold, a, _mm512_set1_ps(kQuarterPi));
+  a = _mm512_mask_sub_ps(a, _mm512_cmp_ps_mask(ay, ax, _CMP_GT_OQ), _mm512_set1_ps(kHalfPi), a);
+  a = _mm512_mask_sub_ps(a, _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ),
+                         _mm512_set1_ps(kPi), a);
+  const __m512i sign = _mm512_and_si512(_mm512_castps_si512(y), _mm512_set1_epi32(INT32_MIN));
+  return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), sign));
+}
+
+__attribute__((target("avx512f"))) void Avx512Kernel(const std::complex<float> *data,
+                                                     std::size_t links, std::size_t subcarriers,
+                                                     float *amplitude, float *phase) {
+  const auto *raw = reinterpret_cast<const float *>(data);
+  const __m512i even = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+  const __m512i odd = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+  const __m512 link_count = _mm512_set1_ps(static_cast<float>(links));
+  std::size_t sc = 0;
+  for (; sc + 16 <= subcarriers; sc += 16) {
+    __m512 amp = _mm512_setzero_ps();
+    __m512 re = _mm512_setzero_ps();
+    __m512 im = _mm512_setzero_ps();
+    for (std::size_t link = 0; link < links; ++link) {
+      const float *p = raw + 2 * (link * subcarriers + sc);
+      const __m512 a = _mm512_loadu_ps(p);
+      const __m512 b = _mm512_loadu_ps(p + 16);
+      const __m512 r = _mm512_permutex2var_ps(a, even, b);
+      const __m512 i = _mm512_permutex2var_ps(a, odd, b);
+      amp = _mm512_add_ps(amp, _mm512_sqrt_ps(_mm512_fmadd_ps(r, r, _mm512_mul_ps(i, i))));
+      re = _mm512_add_ps(re, r);
+      im = _mm512_add_ps(im, i);
+    }
+    _mm512_storeu_ps(amplitude + sc, _mm512_div_ps(amp, link_count));
+    _mm512_storeu_ps(phase + sc, Atan2Avx512(im, re));
+  }
+  sc = Sse2Blocks(data, links, subcarriers, sc, amplitude, phase);
+  ScalarKernel(data, links, subcarriers, sc, amplitude, phase);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+using Kernel = void (*)(const std::complex<float> *, std::size_t, std::size_t, float *, float *);
+
+void ScalarEntry(const std::complex<float> *data, std::size_t links, std::size_t subcarriers,
+                 float *amplitude, float *phase) {
+  ScalarKernel(data, links, subcarriers, 0, amplitude, phase);
+}
+
+Kernel KernelFor(Isa isa) {
+#ifdef AETHERSENSE_SIMD_X86
+  switch (isa) {
+  case Isa::kAvx512:
+    return Avx512Kernel;
+  case Isa::kAvx2:
+    return Avx2Kernel;
+  case Isa::kSse2:
+    return Sse2Kernel;
+  case Isa::kScalar:
+    break;
+  }
+#else
+  (void)isa;
+#endif
+  return ScalarEntry;
+}
+
+} // namespace
+
+bool IsaSupported(Isa isa) {
+#ifdef AETHERSENSE_SIMD_X86
+  __builtin_cpu_init();
+  switch (isa) {
+  case Isa::kAvx512:
+    return __builtin_cpu_supports("avx512f");
+  case Isa::kAvx2:
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  case Isa::kSse2:
+    return __builtin_cpu_supports("sse2");
+  case Isa::kScalar:
+    return true;
+  }
+  return false;
+#else
+  return isa == Isa::kScalar;
+#endif
+}
+
+Isa DetectIsa() {
+  for (Isa isa : {Isa::kAvx512, Isa::kAvx2, Isa::kSse2}) {
+    if (IsaSupported(isa)) {
+      return isa;
+    }
+  }
+  return Isa::kScalar;
+}
+
+const char *IsaName(Isa isa) {
+  switch (isa) {
+  case Isa::kAvx512:
+    return "avx512";
+  case Isa::kAvx2:
+    return "avx2";
+  case Isa::kSse2:
+    return "sse2";
+  case Isa::kScalar:
+    break;
+  }
+  return "scalar";
+}
+
+float FastAtan2(float y, float x) {
+  const float ax = std::fabs(x);
+  const float ay = std::fabs(y);
+  const float hi = std::max(ax, ay);
+  float z = std::min(ax, ay) / std::max(hi, 1e-30F);
+  const bool fold = z > kTanPiOver8;
+  if (fold) {
+    z = (z - 1.0F) / (z + 1.0F);
+  }
+  const float z2 = z * z;
+  float a = (((kP3 * z2 + kP2) * z2 + kP1) * z2 + kP0) * z2 * z + z;
+  if (fold) {
+    a += kQuarterPi;
+  }
+  if (ay > ax) {
+    a = kHalfPi - a;
+  }
+  if (x < 0.0F) {
+    a = kPi - a;
+  }
+  return std::copysign(a, y);
+}
+
+void LinkMagnitudePhase(const std::complex<float> *data, std::size_t links,
+                        std::size_t subcarriers, float *amplitude, float *phase) {
+  static const Kernel kernel = KernelFor(DetectIsa());
+  kernel(data, links, subcarriers, amplitude, phase);
+}
+
+void LinkMagnitudePhase(Isa isa, const std::complex<float> *data, std::size_t links,
+                        std::size_t subcarriers, float *amplitude, float *phase) {
+  KernelFor(isa)(data, links, subcarriers, amplitude, phase);
+}
+
+} // namespace aethersense::dsp::simd
@@ -0,0 +1,146 @@
+#include "aethersense/dsp/sliding_dft.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aethersense::dsp {
+namespace {
+
+constexpr double kTwoPi = 6.28318530717958647692;
+// Re-seeding from the history bounds the rounding drift of the recursion; amortized over this
+// many pushes it costs far less than one bin update per sample.
+constexpr std::size_t kReseedInterval = 4096;
+
+std::complex<double> Phasor(double angle) { return {std::cos(angle), std::sin(angle)}; }
+
+} // namespace
+
+SlidingDft::SlidingDft(std::size_t length, std::size_t fft_len, WindowType window, bool detrend,
+                       float ema_alpha)
+    : length_(length), fft_len_(fft_len), detrend_(detrend), alpha_(ema_alpha),
+      raw_(length, 0.0), smoothed_(length, 0.0) {
+  if (length_ > 1) {
+    window_a_ = window == WindowType::kHamming ? 0.54 : 0.5;
+    window_b_ = window == WindowType::kHamming ? 0.46 : 0.5;
+  }
+}
+
+void SlidingDft::Track(BinRange bins) {
+  bins.last = std::min(bins.last, fft_len_ / 2);
+  if (bins.empty()) {
+    bins = {};
+  }
+  if (bins.first == bins_.first && bins.last == bins_.last && taps_.size() == 3 * bins.size()) {
+    return;
+  }
+  bins_ = bins;
+  taps_.assign(3 * bins_.size(), Tap{});
+  restart_gain_.assign(bins_.size(), {0.0, 0.0});
+  offset_gain_.assign(bins_.size(), {0.0, 0.0});
+  slope_gain_.assign(bins_.size(), {0.0, 0.0});
+
+  const double n = static_cast<double>(length_);
+  const double shift = length_ > 1 ? 1.0 / (n - 1.0) : 0.0;
+  for (std::size_t i = 0; i < bins_.size(); ++i) {
+    const double freq = static_cast<double>(bins_.first + i) / static_cast<double>(fft_len_);
+    for (std::size_t d = 0; d < 3; ++d) {
+      const double theta = kTwoPi * (freq + (static_cast<double>(d) - 1.0) * shift);
+      taps_[3 * i + d].rotate = Phasor(theta);
+      taps_[3 * i + d].enter = Phasor(-theta * (n - 1.0));
+    }
+    // restart: window * (1 - alpha)^m, offset: window, slope: window * EMA of the ramp m.
+    double decay = 1.0;
+    double ramp = 0.0;
+    for (std::size_t m = 0; m < length_; ++m) {
+      const double md = static_cast<double>(m);
+      const double w = window_a_ - window_b_ * std::cos(kTwoPi * md * shift);
+      const auto e = w * Phasor(-kTwoPi * freq * md);
+      if (m > 0) {
+        decay *= 1.0 - alpha_;
+        ramp = alpha_ * md + (1.0 - alpha_) * ramp;
+      }
+      restart_gain_[i] += decay * e;
+      offset_gain_[i] += e;
+      slope_gain_[i] += ramp * e;
+    }
+  }
+  Reseed();
+}
+
+void SlidingDft::Reset(std::span<const float> history) {
+  std::fill(raw_.begin(), raw_.end(), 0.0);
+  std::fill(smoothed_.begin(), smoothed_.end(), 0.0);
+  head_ = 0;
+  count_ = 0;
+  const std::size_t skip = history.size() > length_ ? history.size() - length_ : 0;
+  for (std::size_t i = skip; i < history.size(); ++i) {
+    Append(history[i]);
+  }
+  Reseed();
+}
+
+void SlidingDft::Append(double sample) {
+  const double prev = smoothed_[head_ == 0 ? length_ - 1 : head_ - 1];
+  raw_[head_] = sample;
+  smoothed_[head_] = count_ == 0 ? sample : alpha_ * sample + (1.0 - alpha_) * prev;
+  head_ = head_ + 1 == length_ ? 0 : head_ + 1;
+  count_ = std::min(count_ + 1, length_);
+}
+
+void SlidingDft::Push(float sample) {
+  if (length_ == 0) {
+    return;
+  }
+  const double old = smoothed_[head_];
+  Append(sample);
+  const double x = smoothed_[head_ == 0 ? length_ - 1 : head_ - 1];
+  for (auto &tap : taps_) {
+    tap.state = (tap.state - old) * tap.rotate + x * tap.enter;
+  }
+  if (++pushes_since_reseed_ >= kReseedInterval) {
+    Reseed();
+  }
+}
+
+void SlidingDft::Reseed() {
+  pushes_since_reseed_ = 0;
+  for (auto &tap : taps_) {
+    // conj(rotate) steps the phasor e^{-j theta m} one sample forward.
+    const auto step = std::conj(tap.rotate);
+    std::complex<double> e(1.0, 0.0);
+    std::complex<double> acc(0.0, 0.0);
+    for (std::size_t m = 0; m < length_; ++m) {
+      acc += smoothed_[Slot(m)] * e;
+      e *= step;
+    }
+    tap.state = acc;
+  }
+}
+
+float SlidingDft::BandEnergy(BinRange bins) const {
+  const std::size_t first = std::max(bins.first, bins_.first);
+  const std::size_t last = std::min(bins.last, bins_.last);
+  if (first >= last || length_ == 0) {
+    return 0.0F;
+  }
+  const double oldest = raw_[Slot(0)];
+  const double restart = oldest - smoothed_[Slot(0)];
+  double slope = 0.0;
+  if (detrend_ && length_ > 1) {
+    slope = (raw_[Slot(length_ - 1)] - oldest) / static_cast<double>(length_ - 1);
+  }
+  double energy = 0.0;
+  for (std::size_t k = first; k < last; ++k) {
+    const std::size_t i = k - bins_.first;
+    auto value = window_a_ * taps_[3 * i + 1].state -
+                 0.5 * window_b_ * (taps_[3 * i].state + taps_[3 * i + 2].state) +
+                 restart * restart_gain_[i];
+    if (detrend_ && length_ > 1) {
+      value -= oldest * offset_gain_[i] + slope * slope_gain_[i];
+    }
+    energy += std::norm(value);
+  }
+  return static_cast<float>(energy);
+}
+
+} // namespace aethersense::dsp
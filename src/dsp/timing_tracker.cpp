@@ -0,0 +1,99 @@
+#include "aethersense/dsp/timing_tracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aethersense::dsp {
+namespace {
+
+// Re-deriving the sums from the interval ring bounds their rounding drift.
+constexpr std::size_t kRebuildInterval = 4096;
+
+} // namespace
+
+void TimingTracker::Reset(std::size_t window_frames) {
+  intervals_.resize(window_frames > 1 ? window_frames - 1 : 0);
+  order_.Reset(intervals_.size());
+  Clear();
+}
+
+void TimingTracker::Clear() {
+  head_ = 0;
+  count_ = 0;
+  has_last_ = false;
+  last_ns_ = 0;
+  order_.Clear();
+  shift_ = 0.0;
+  sum_ = 0.0;
+  sum_sq_ = 0.0;
+  pushes_since_rebuild_ = 0;
+}
+
+void TimingTracker::Push(std::uint64_t timestamp_ns) {
+  const std::uint64_t interval = timestamp_ns - last_ns_;
+  const bool first = !has_last_;
+  has_last_ = true;
+  last_ns_ = timestamp_ns;
+  if (first || intervals_.empty()) {
+    return;
+  }
+
+  if (count_ == intervals_.size()) {
+    const std::uint64_t evicted = intervals_[head_];
+    order_.Erase(evicted);
+    const double e = static_cast<double>(evicted) - shift_;
+    sum_ -= e;
+    sum_sq_ -= e * e;
+    intervals_[head_] = interval;
+    head_ = (head_ + 1) % intervals_.size();
+  } else {
+    if (count_ == 0) {
+      shift_ = static_cast<double>(interval);
+    }
+    intervals_[(head_ + count_) % intervals_.size()] = interval;
+    ++count_;
+  }
+  order_.Insert(interval);
+  const double d = static_cast<double>(interval) - shift_;
+  sum_ += d;
+  sum_sq_ += d * d;
+
+  if (++pushes_since_rebuild_ >= kRebuildInterval) {
+    Rebuild();
+  }
+}
+
+void TimingTracker::Rebuild() {
+  pushes_since_rebuild_ = 0;
+  sum_ = 0.0;
+  sum_sq_ = 0.0;
+  for (std::size_t i = 0; i < count_; ++i) {
+    const double d = static_cast<double>(intervals_[(head_ + i) % intervals_.size()]) - shift_;
+    sum_ += d;
+    sum_sq_ += d * d;
+  }
+}
+
+std::uint64_t TimingTracker::median_interval_ns() const {
+  return count_ == 0 ? 0 : order_.UpperMedian();
+}
+
+float TimingTracker::sample_rate_hz() const {
+  return 1e9F / static_cast<float>(median_interval_ns());
+}
+
+float TimingTracker::jitter_ratio() const {
+  if (count_ < 2) {
+    return 0.0F;
+  }
+  const std::uint64_t median = median_interval_ns();
+  if (median == 0) {
+    return 1.0F;
+  }
+  const double n = static_cast<double>(count_);
+  const double mean = sum_ / n;
+  const double var = std::max(0.0, sum_sq_ / n - mean * mean);
+  return static_cast<float>(std::sqrt(var) / static_cast<double>(median));
+}
+
+} // namespace aethersense::dsp
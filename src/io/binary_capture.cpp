@@ -0,0 +1,404 @@
+#include "aethersense/io/binary_capture.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include "aethersense/io/checkpoint.hpp"
+#include "aethersense/io/compressed_capture.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define AETHERSENSE_CRC_X86 1
+#include <immintrin.h>
+#endif
+
+namespace aethersense::io {
+namespace {
+
+static_assert(std::endian::native == std::endian::little,
+              "binary captures are read and written in native (little-endian) byte order");
+
+// Header field offsets; see binary_capture.hpp.
+constexpr std::size_t kVersionOffset = 8;
+constexpr std::size_t kHeaderSizeOffset = 10;
+constexpr std::size_t kRxOffset = 12;
+constexpr std::size_t kTxOffset = 13;
+constexpr std::size_t kSubcarriersOffset = 14;
+constexpr std::size_t kCenterFreqOffset = 16;
+constexpr std::size_t kRecordBytesOffset = 24;
+constexpr std::size_t kHeaderCrcOffset = 28;
+// Record field offsets.
+constexpr std::size_t kRecordCrcOffset = 4;
+constexpr std::size_t kTimestampOffset = 8;
+
+template <typename T> T Load(const char *p) {
+  T v{};
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+template <typename T> void Store(char *p, T v) { std::memcpy(p, &v, sizeof(T)); }
+
+constexpr std::uint32_t kCrc32cPoly = 0x82F63B78U; // reflected Castagnoli polynomial
+
+std::array<std::uint32_t, 256> MakeCrc32cTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t c = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      c = (c & 1U) != 0 ? (c >> 1U) ^ kCrc32cPoly : c >> 1U;
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+std::uint32_t Crc32cScalar(const unsigned char *p, std::size_t size, std::uint32_t state) {
+  static const auto table = MakeCrc32cTable();
+  for (std::size_t i = 0; i < size; ++i) {
+    state = table[(state ^ p[i]) & 0xFFU] ^ (state >> 8U);
+  }
+  return state;
+}
+
+#ifdef AETHERSENSE_CRC_X86
+__attribute__((target("sse4.2"))) std::uint32_t Crc32cSse42(const unsigned char *p,
+                                                             std::size_t size,
+                                                             std::uint32_t state) {
+  std::uint64_t wide = state;
+  for (; size >= 8; size -= 8, p += 8) {
+    wide = _mm_crc32_u64(wide, Load<std::uint64_t>(reinterpret_cast<const char *>(p)));
+  }
+  auto narrow = static_cast<std::uint32_t>(wide);
+  for (; size > 0; --size, ++p) {
+    narrow = _mm_crc32_u8(narrow, *p);
+  }
+  return narrow;
+}
+
+bool HasSse42() {
+  static const bool supported = __builtin_cpu_supports("sse4.2");
+  return supported;
+}
+#endif
+
+} // namespace
+
+std::size_t BinaryRecordBytes(std::uint8_t rx_count, std::uint8_t tx_count,
+                              std::uint16_t subcarrier_count) {
+  const std::size_t samples =
+      static_cast<std::size_t>(rx_count) * tx_count * subcarrier_count * sizeof(std::complex<float>);
+  return kBinaryRecordPrefixBytes + (samples + 31) / 32 * 32;
+}
+
+std::uint32_t Crc32c(const void *data, std::size_t size, std::uint32_t crc) {
+  const auto *p = static_cast<const unsigned char *>(data);
+#ifdef AETHERSENSE_CRC_X86
+  if (HasSse42()) {
+    return ~Crc32cSse42(p, size, ~crc);
+  }
+#endif
+  return ~Crc32cScalar(p, size, ~crc);
+}
+
+BinaryCaptureWriter::~BinaryCaptureWriter() { close(); }
+
+Result<bool> BinaryCaptureWriter::Open(const std::string &path) {
+  close();
+  out_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to open capture for writing: " + path};
+  }
+  path_ = path;
+  header_.reset();
+  frames_written_ = 0;
+  return true;
+}
+
+Result<bool> BinaryCaptureWriter::write(const FrameView &frame) {
+  if (!out_.is_open()) {
+    return Error{ErrorCode::kIoError, "capture writer is not open"};
+  }
+  const std::size_t samples =
+      static_cast<std::size_t>(frame.rx_count) * frame.tx_count * frame.subcarrier_count;
+  const std::size_t record_bytes =
+      BinaryRecordBytes(frame.rx_count, frame.tx_count, frame.subcarrier_count);
+  if (record_bytes > std::numeric_limits<std::uint32_t>::max()) {
+    // The header stores the record size as a u32.
+    return Error{ErrorCode::kInvalidArgument, "frame shape is too large for a binary capture"};
+  }
+  if (frame.data.size() < samples) {
+    return Error{ErrorCode::kInvalidArgument, "frame.data is smaller than rx*tx*subcarriers"};
+  }
+  if (!header_.has_value()) {
+    header_ = BinaryCaptureHeader{frame.rx_count, frame.tx_count, frame.subcarrier_count,
+                                  frame.center_freq_hz,
+                                  static_cast<std::uint32_t>(record_bytes)};
+    auto written = WriteHeader();
+    if (!written.ok()) {
+      return written;
+    }
+    // Zeroed once: every record overwrites the same fields and leaves the padding alone.
+    record_.assign(header_->record_bytes, 0);
+    Store(record_.data(), kBinaryRecordSync);
+  } else if (frame.rx_count != header_->rx_count || frame.tx_count != header_->tx_count ||
+             frame.subcarrier_count != header_->subcarrier_count ||
+             frame.center_freq_hz != header_->center_freq_hz) {
+    return Error{ErrorCode::kInvalidArgument, "frame shape differs from the capture header"};
+  }
+
+  Store(record_.data() + kTimestampOffset, frame.timestamp_ns);
+  std::memcpy(record_.data() + kBinaryRecordPrefixBytes, frame.data.data(),
+              samples * sizeof(std::complex<float>));
+  Store(record_.data() + kRecordCrcOffset,
+        Crc32c(record_.data() + kTimestampOffset, record_.size() - kTimestampOffset));
+  out_.write(record_.data(), static_cast<std::streamsize>(record_.size()));
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to write capture: " + path_};
+  }
+  ++frames_written_;
+  return true;
+}
+
+Result<bool> BinaryCaptureWriter::close() {
+  if (!out_.is_open()) {
+    return true;
+  }
+  if (!header_.has_value()) {
+    header_ = BinaryCaptureHeader{};
+    header_->record_bytes = static_cast<std::uint32_t>(BinaryRecordBytes(0, 0, 0));
+    auto written = WriteHeader();
+    if (!written.ok()) {
+      out_.close();
+      return written;
+    }
+  }
+  out_.close();
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to write capture: " + path_};
+  }
+  return true;
+}
+
+Result<bool> BinaryCaptureWriter::WriteHeader() {
+  std::array<char, kBinaryHeaderBytes> header{};
+  std::memcpy(header.data(), kBinaryCaptureMagic, sizeof(kBinaryCaptureMagic));
+  Store(header.data() + kVersionOffset, kBinaryCaptureVersion);
+  Store(header.data() + kHeaderSizeOffset, static_cast<std::uint16_t>(kBinaryHeaderBytes));
+  Store(header.data() + kRxOffset, header_->rx_count);
+  Store(header.data() + kTxOffset, header_->tx_count);
+  Store(header.data() + kSubcarriersOffset, header_->subcarrier_count);
+  Store(header.data() + kCenterFreqOffset, header_->center_freq_hz);
+  Store(header.data() + kRecordBytesOffset, header_->record_bytes);
+  Store(header.data() + kHeaderCrcOffset, Crc32c(header.data(), kHeaderCrcOffset));
+  out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to write capture: " + path_};
+  }
+  return true;
+}
+
+Result<bool> BinaryCaptureReader::Open(const std::string &path) {
+  auto mapped = file_.Open(path);
+  if (!mapped.ok()) {
+    return mapped.error();
+  }
+  const char *h = file_.data();
+  if (file_.size() < kBinaryHeaderBytes ||
+      std::memcmp(h, kBinaryCaptureMagic, sizeof(kBinaryCaptureMagic)) != 0) {
+    return Error{ErrorCode::kUnsupportedFormat, "not a binary CSI capture: " + path};
+  }
+  if (Load<std::uint32_t>(h + kHeaderCrcOffset) != Crc32c(h, kHeaderCrcOffset)) {
+    return Error{ErrorCode::kParseError, "binary capture header is corrupt: " + path};
+  }
+  if (Load<std::uint16_t>(h + kVersionOffset) != kBinaryCaptureVersion ||
+      Load<std::uint16_t>(h + kHeaderSizeOffset) != kBinaryHeaderBytes) {
+    return Error{ErrorCode::kUnsupportedFormat, "unsupported binary capture version: " + path};
+  }
+  header_.rx_count = Load<std::uint8_t>(h + kRxOffset);
+  header_.tx_count = Load<std::uint8_t>(h + kTxOffset);
+  header_.subcarrier_count = Load<std::uint16_t>(h + kSubcarriersOffset);
+  header_.center_freq_hz = Load<std::uint64_t>(h + kCenterFreqOffset);
+  header_.record_bytes = Load<std::uint32_t>(h + kRecordBytesOffset);
+  if (header_.record_bytes !=
+      BinaryRecordBytes(header_.rx_count, header_.tx_count, header_.subcarrier_count)) {
+    return Error{ErrorCode::kParseError, "binary capture header is corrupt: " + path};
+  }
+
+  signature_ = FileSignature(path);
+  offset_ = kBinaryHeaderBytes;
+  if (cfg_.start_position == "end") {
+    offset_ = file_.size();
+  } else if (cfg_.start_position == "offset") {
+    offset_ = static_cast<std::size_t>(std::clamp<std::uint64_t>(
+        cfg_.start_offset, kBinaryHeaderBytes, std::max(file_.size(), kBinaryHeaderBytes)));
+  } else if (cfg_.start_position == "checkpoint") {
+    // Only a checkpoint of this very file, at its end or on a valid record, is honoured. After a
+    // resync that record may lie off the record grid.
+    const auto ck = ReadCheckpoint(cfg_.checkpoint_path);
+    if (ck.has_value() && ck->signature == signature_ && ck->offset >= kBinaryHeaderBytes &&
+        (ck->offset == file_.size() || ValidRecord(static_cast<std::size_t>(ck->offset)))) {
+      offset_ = static_cast<std::size_t>(ck->offset);
+      ++stats_.checkpoint_resume_total;
+    }
+  }
+  return true;
+}
+
+bool BinaryCaptureReader::ValidRecord(std::size_t offset) const {
+  const std::size_t bytes = header_.record_bytes;
+  if (offset > file_.size() || file_.size() - offset < bytes) {
+    return false;
+  }
+  const char *rec = file_.data() + offset;
+  return Load<std::uint32_t>(rec) == kBinaryRecordSync &&
+         Load<std::uint32_t>(rec + kRecordCrcOffset) ==
+             Crc32c(rec + kTimestampOffset, bytes - kTimestampOffset);
+}
+
+std::size_t BinaryCaptureReader::Resync(std::size_t offset) const {
+  // A record damaged in place leaves the next slot intact; bytes lost or inserted shift it.
+  if (ValidRecord(offset + header_.record_bytes)) {
+    return offset + header_.record_bytes;
+  }
+  const char *data = file_.data();
+  const std::size_t size = file_.size();
+  constexpr auto kFirstSyncByte = static_cast<unsigned char>(kBinaryRecordSync & 0xFFU);
+  for (std::size_t pos = offset + 1; pos < size;) {
+    const auto *hit =
+        static_cast<const char *>(std::memchr(data + pos, kFirstSyncByte, size - pos));
+    if (hit == nullptr) {
+      break;
+    }
+    pos = static_cast<std::size_t>(hit - data);
+    if (ValidRecord(pos)) {
+      return pos;
+    }
+    ++pos;
+  }
+  return size;
+}
+
+Result<bool> BinaryCaptureReader::next_view(FrameView &view) {
+  if (!file_.is_open()) {
+    return Error{ErrorCode::kIoError, "stream not opened"};
+  }
+  const std::size_t bytes = header_.record_bytes;
+  const std::size_t samples =
+      static_cast<std::size_t>(header_.rx_count) * header_.tx_count * header_.subcarrier_count;
+  while (true) {
+    const std::size_t size = file_.size();
+    if (offset_ >= size) {
+      checkpoint_.Flush();
+      return false;
+    }
+    if (size - offset_ < bytes) {
+      // A capture cut off mid-record.
+      ++stats_.records_partial_total;
+      offset_ = size;
+      checkpoint_.Flush();
+      return false;
+    }
+    if (!ValidRecord(offset_)) {
+      ++stats_.records_corrupt_total;
+      offset_ = Resync(offset_);
+      if (corrupt_.AddCorrupt()) {
+        return Error{ErrorCode::kParseError, "corrupt ratio exceeded"};
+      }
+      continue;
+    }
+
+    const char *rec = file_.data() + offset_;
+    view.timestamp_ns = Load<std::uint64_t>(rec + kTimestampOffset);
+    view.center_freq_hz = header_.center_freq_hz;
+    view.subcarrier_count = header_.subcarrier_count;
+    view.rx_count = header_.rx_count;
+    view.tx_count = header_.tx_count;
+    const char *block = rec + kBinaryRecordPrefixBytes;
+    if (reinterpret_cast<std::uintptr_t>(block) % alignof(std::complex<float>) == 0) {
+      view.data = std::span<const std::complex<float>>(
+          reinterpret_cast<const std::complex<float> *>(block), samples);
+    } else {
+      // Resynced onto a record shifted off the 4-byte grid: copy it out rather than hand out a
+      // misaligned view.
+      realigned_.resize(samples);
+      std::memcpy(realigned_.data(), block, samples * sizeof(std::complex<float>));
+      view.data = realigned_;
+    }
+    offset_ += bytes;
+    ++stats_.records_total;
+    corrupt_.AddGood();
+    checkpoint_.Update({signature_, offset_, view.timestamp_ns});
+    return true;
+  }
+}
+
+Result<std::optional<CsiFrame>> BinaryCaptureReader::next() {
+  CsiFrame frame;
+  auto got = next_into(frame);
+  if (!got.ok()) {
+    return got.error();
+  }
+  if (!got.value()) {
+    return std::optional<CsiFrame>{};
+  }
+  return std::optional<CsiFrame>{std::move(frame)};
+}
+
+Result<bool> BinaryCaptureReader::next_into(CsiFrame &frame) {
+  FrameView view;
+  auto got = next_view(view);
+  if (!got.ok() || !got.value()) {
+    return got;
+  }
+  frame.timestamp_ns = view.timestamp_ns;
+  frame.center_freq_hz = view.center_freq_hz;
+  frame.subcarrier_count = view.subcarrier_count;
+  frame.rx_count = view.rx_count;
+  frame.tx_count = view.tx_count;
+  frame.data.assign(view.data.begin(), view.data.end());
+  return true;
+}
+
+StreamStats BinaryCaptureReader::stream_stats() const {
+  StreamStats stats = stats_;
+  stats.checkpoint_writes_total = checkpoint_.writes_total();
+  return stats;
+}
+
+} // namespace aethersense::io
+
+namespace aethersense {
+
+Result<std::unique_ptr<ICsiWriter>> CreateWriter(const std::string &format,
+                                                 const std::string &path,
+                                                 const WriterOptions &options) {
+  if (format == "binary") {
+    auto writer = std::make_unique<io::BinaryCaptureWriter>();
+    auto opened = writer->Open(path);
+    if (!opened.ok()) {
+      return opened.error();
+    }
+    return std::unique_ptr<ICsiWriter>(std::move(writer));
+  }
+  if (format == "compressed") {
+    const auto codec = io::ParseCsiCodec(options.codec);
+    if (!codec.has_value()) {
+      return Error{ErrorCode::kInvalidArgument, "codec must be lossless|int16"};
+    }
+    auto writer = std::make_unique<io::CompressedCaptureWriter>(*codec, options.block_frames);
+    auto opened = writer->Open(path);
+    if (!opened.ok()) {
+      return opened.error();
+    }
+    return std::unique_ptr<ICsiWriter>(std::move(writer));
+  }
+  return Error{ErrorCode::kUnsupportedFormat, "no writer for format: " + format};
+}
+
+} // namespace aethersense
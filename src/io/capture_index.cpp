@@ -0,0 +1,225 @@
+#include "aethersense/io/capture_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+#include "aethersense/core/types.hpp"
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/io/checkpoint.hpp"
+#include "aethersense/io/compressed_capture.hpp"
+#include "aethersense/io/mapped_file.hpp"
+#include "aethersense/io/record_recovery.hpp"
+
+namespace aethersense::io {
+namespace {
+
+constexpr const char *kIndexMagic = "aethersense-capture-index";
+constexpr int kIndexVersion = 1;
+
+// Adds one valid frame, starting at byte `offset`, to `index`.
+void AddFrame(CaptureIndex &index, std::uint64_t offset, std::uint64_t timestamp_ns,
+              std::uint64_t &max_timestamp_ns) {
+  if (index.frames_total % index.stride == 0) {
+    index.entries.push_back({offset, index.frames_total, max_timestamp_ns});
+  }
+  max_timestamp_ns = std::max(max_timestamp_ns, timestamp_ns);
+  ++index.frames_total;
+}
+
+Result<bool> IndexBinary(const Config::Io &io, const std::string &path, CaptureIndex &index) {
+  Config::Io cfg = io;
+  cfg.start_position = "begin";
+  cfg.checkpoint_path.clear();
+  cfg.max_corrupt_ratio = 1.0F; // skip corrupt records rather than give up
+  BinaryCaptureReader reader(cfg);
+  auto opened = reader.Open(path);
+  if (!opened.ok()) {
+    return opened;
+  }
+  std::uint64_t max_timestamp_ns = 0;
+  FrameView view;
+  while (true) {
+    auto got = reader.next_view(view);
+    if (!got.ok() || !got.value()) {
+      return got;
+    }
+    AddFrame(index, reader.offset() - reader.header().record_bytes, view.timestamp_ns,
+             max_timestamp_ns);
+  }
+}
+
+Result<bool> IndexCompressed(const Config::Io &io, const std::string &path, CaptureIndex &index) {
+  Config::Io cfg = io;
+  cfg.start_position = "begin";
+  cfg.checkpoint_path.clear();
+  cfg.max_corrupt_ratio = 1.0F;
+  CompressedCaptureReader reader(cfg);
+  auto opened = reader.Open(path);
+  if (!opened.ok()) {
+    return opened;
+  }
+  std::uint64_t max_timestamp_ns = 0;
+  std::size_t block_offset = 0;
+  FrameView view;
+  while (true) {
+    auto got = reader.next_view(view);
+    if (!got.ok() || !got.value()) {
+      return got;
+    }
+    if (reader.block_offset() != block_offset) {
+      block_offset = reader.block_offset();
+      if (index.entries.empty() ||
+          index.frames_total - index.entries.back().frames_before >= index.stride) {
+        index.entries.push_back({block_offset, index.frames_total, max_timestamp_ns});
+      }
+    }
+    max_timestamp_ns = std::max(max_timestamp_ns, view.timestamp_ns);
+    ++index.frames_total;
+  }
+}
+
+Result<bool> IndexText(const Config::Io &io, const std::string &path, CaptureIndex &index) {
+  MappedFile file;
+  auto opened = file.Open(path);
+  if (!opened.ok()) {
+    return opened;
+  }
+  const bool csv = io.format == "csv";
+  std::uint64_t max_timestamp_ns = 0;
+  CsiFrame frame;
+  std::size_t pos = 0;
+  while (pos < file.size()) {
+    const char *begin = file.data() + pos;
+    const auto *nl = static_cast<const char *>(std::memchr(begin, '\n', file.size() - pos));
+    const std::size_t len = nl != nullptr ? static_cast<std::size_t>(nl - begin) : file.size() - pos;
+    if (len == 0) {
+      break; // file-mode replay ends here too
+    }
+    const std::string_view line(begin, len);
+    const auto status = csv ? ParseCsvRecordInto(line, frame) : ParseJsonlRecordInto(line, frame);
+    if (!status.corrupt) {
+      AddFrame(index, pos, frame.timestamp_ns, max_timestamp_ns);
+    }
+    pos += nl != nullptr ? len + 1 : len;
+  }
+  return true;
+}
+
+} // namespace
+
+std::string CaptureIndexPath(const std::string &capture_path) { return capture_path + ".idx"; }
+
+Result<CaptureIndex> BuildCaptureIndex(const Config::Io &io, const std::string &path,
+                                       std::uint64_t stride) {
+  if (stride == 0) {
+    return Error{ErrorCode::kInvalidArgument, "index stride must be >0"};
+  }
+  CaptureIndex index;
+  index.signature = FileSignature(path);
+  index.format = io.format;
+  index.stride = stride;
+  auto built = io.format == "binary"       ? IndexBinary(io, path, index)
+               : io.format == "compressed" ? IndexCompressed(io, path, index)
+                                           : IndexText(io, path, index);
+  if (!built.ok()) {
+    return built.error();
+  }
+  return index;
+}
+
+std::optional<CaptureIndex> ReadCaptureIndex(const std::string &index_path) {
+  std::ifstream in(index_path);
+  if (!in) {
+    return std::nullopt;
+  }
+  std::string magic;
+  int version = 0;
+  CaptureIndex index;
+  std::size_t entries = 0;
+  in >> magic >> version >> index.signature >> index.format >> index.stride >>
+      index.frames_total >> entries;
+  if (!in || magic != kIndexMagic || version != kIndexVersion || index.stride == 0 ||
+      entries > (index.frames_total + index.stride - 1) / index.stride ||
+      (entries == 0) != (index.frames_total == 0)) {
+    return std::nullopt;
+  }
+  index.entries.resize(entries);
+  for (auto &entry : index.entries) {
+    in >> entry.offset >> entry.frames_before >> entry.max_timestamp_before_ns;
+  }
+  if (!in) {
+    return std::nullopt; // truncated
+  }
+  return index;
+}
+
+Result<bool> WriteCaptureIndex(const std::string &index_path, const CaptureIndex &index) {
+  std::ofstream out(index_path, std::ios::trunc);
+  if (!out) {
+    return Error{ErrorCode::kIoError, "failed to open index for writing: " + index_path};
+  }
+  out << kIndexMagic << ' ' << kIndexVersion << '\n'
+      << index.signature << ' ' << index.format << ' ' << index.stride << ' '
+      << index.frames_total << ' ' << index.entries.size() << '\n';
+  for (const auto &entry : index.entries) {
+    out << entry.offset << ' ' << entry.frames_before << ' ' << entry.max_timestamp_before_ns
+        << '\n';
+  }
+  out.close();
+  if (!out) {
+    return Error{ErrorCode::kIoError, "failed to write index: " + index_path};
+  }
+  return true;
+}
+
+Result<CaptureIndex> LoadOrBuildCaptureIndex(const Config::Io &io, const std::string &path) {
+  const std::string index_path = CaptureIndexPath(path);
+  auto index = ReadCaptureIndex(index_path);
+  if (index.has_value() && index->signature == FileSignature(path) && index->format == io.format) {
+    return std::move(*index);
+  }
+  auto built = BuildCaptureIndex(io, path);
+  if (built.ok()) {
+    WriteCaptureIndex(index_path, built.value());
+  }
+  return built;
+}
+
+std::uint64_t SeekOffset(const CaptureIndex &index, std::uint64_t from_ts_ns,
+                         std::uint64_t warmup_frames) {
+  const auto &entries = index.entries;
+  if (entries.empty()) {
+    return 0;
+  }
+  // max_timestamp_before_ns never decreases, so the entries whose preceding frames are all
+  // earlier than from_ts_ns form a prefix; the first frame at or after it follows the last one.
+  const auto after = std::partition_point(entries.begin(), entries.end(), [&](const auto &e) {
+    return e.frames_before == 0 || e.max_timestamp_before_ns < from_ts_ns;
+  });
+  const std::uint64_t target = std::prev(after)->frames_before;
+  const std::uint64_t limit = target > warmup_frames ? target - warmup_frames : 0;
+  const auto start = std::partition_point(entries.begin(), after, [&](const auto &e) {
+    return e.frames_before <= limit;
+  });
+  return std::prev(start)->offset;
+}
+
+Result<bool> SeekToTimestamp(Config::Io &io, const std::string &path, std::uint64_t from_ts_ns,
+                             std::uint64_t warmup_frames) {
+  if (io.mode != "file") {
+    return Error{ErrorCode::kInvalidConfig, "seeking by timestamp requires io.mode file"};
+  }
+  auto index = LoadOrBuildCaptureIndex(io, path);
+  if (!index.ok()) {
+    return index.error();
+  }
+  io.start_position = "offset";
+  io.start_offset = SeekOffset(index.value(), from_ts_ns, warmup_frames);
+  return true;
+}
+
+} // namespace aethersense::io
@@ -0,0 +1,177 @@
+#include "aethersense/io/checkpoint.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aethersense::io {
+namespace fs = std::filesystem;
+
+std::string FileSignature(const std::string &path) {
+  if (!fs::exists(path))
+    return {};
+  auto s = fs::status(path);
+  auto fsz = fs::file_size(path);
+  return std::to_string(static_cast<int>(s.type())) + ":" + std::to_string(fsz);
+}
+
+std::optional<FileIdentity> StatFile(const std::string &path) {
+#if defined(__unix__) || defined(__APPLE__)
+  struct stat st {};
+  if (::stat(path.c_str(), &st) != 0)
+    return std::nullopt;
+  return FileIdentity{static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino),
+                      static_cast<std::uint64_t>(st.st_size)};
+#else
+  std::error_code ec;
+  const auto size = fs::file_size(path, ec);
+  if (ec)
+    return std::nullopt;
+  return FileIdentity{0, 0, static_cast<std::uint64_t>(size)};
+#endif
+}
+
+std::optional<Checkpoint> ReadCheckpoint(const std::string &checkpoint_path) {
+  std::ifstream ck(checkpoint_path);
+  if (!ck)
+    return std::nullopt;
+  Checkpoint out;
+  ck >> out.signature >> out.offset >> out.timestamp_ns;
+  return out;
+}
+
+bool WriteCheckpoint(const std::string &checkpoint_path, const Checkpoint &checkpoint,
+                     bool fsync) {
+  if (checkpoint_path.empty())
+    return false;
+  const std::string tmp = checkpoint_path + ".tmp";
+  const std::string text = checkpoint.signature + ' ' + std::to_string(checkpoint.offset) + ' ' +
+                           std::to_string(checkpoint.timestamp_ns);
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0)
+    return false;
+  const bool written = ::write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()) &&
+                       (!fsync || ::fsync(fd) == 0);
+  if (::close(fd) != 0 || !written || ::rename(tmp.c_str(), checkpoint_path.c_str()) != 0)
+    return false;
+  if (fsync) {
+    // Make the rename itself durable.
+    const auto dir = fs::path(checkpoint_path).parent_path();
+    const int dir_fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_CLOEXEC);
+    if (dir_fd >= 0) {
+      ::fsync(dir_fd);
+      ::close(dir_fd);
+    }
+  }
+  return true;
+#else
+  {
+    std::ofstream ck(tmp, std::ios::trunc);
+    if (!(ck << text))
+      return false;
+  }
+  std::error_code ec;
+  fs::rename(tmp, checkpoint_path, ec);
+  return !ec;
+#endif
+}
+
+CheckpointWriter::CheckpointWriter(const Config::Io &cfg)
+    : path_(cfg.checkpoint_path), every_records_(cfg.checkpoint_every_records),
+      interval_(cfg.checkpoint_interval_ms), fsync_(cfg.checkpoint_fsync),
+      last_write_(std::chrono::steady_clock::now()) {
+  if (cfg.checkpoint_async && !path_.empty()) {
+    thread_ = std::thread([this] { Run(); });
+  }
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  Flush();
+  if (thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+}
+
+void CheckpointWriter::Update(const Checkpoint &checkpoint, std::size_t records) {
+  if (path_.empty())
+    return;
+  latest_.signature = checkpoint.signature; // reuses the string's buffer
+  latest_.offset = checkpoint.offset;
+  latest_.timestamp_ns = checkpoint.timestamp_ns;
+  dirty_ = true;
+  pending_records_ += records;
+  if (pending_records_ >= every_records_ ||
+      std::chrono::steady_clock::now() - last_write_ >= interval_) {
+    Write();
+  }
+}
+
+void CheckpointWriter::Flush() {
+  if (dirty_) {
+    Write();
+  }
+  if (thread_.joinable()) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return completed_ == requested_; });
+  }
+}
+
+void CheckpointWriter::FlushIfStale() {
+  if (dirty_ && std::chrono::steady_clock::now() - last_write_ >= interval_) {
+    Write();
+  }
+}
+
+void CheckpointWriter::Write() {
+  dirty_ = false;
+  pending_records_ = 0;
+  last_write_ = std::chrono::steady_clock::now();
+  if (!thread_.joinable()) {
+    if (WriteCheckpoint(path_, latest_, fsync_)) {
+      writes_total_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return;
+  }
+  {
+    // A checkpoint still queued is superseded by this one.
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_ = latest_;
+    ++requested_;
+  }
+  cv_.notify_all();
+}
+
+void CheckpointWriter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [&] { return stop_ || queued_.has_value(); });
+    if (!queued_.has_value()) {
+      return; // stopping with nothing left to write
+    }
+    const Checkpoint checkpoint = std::move(*queued_);
+    queued_.reset();
+    const std::size_t sequence = requested_;
+    lock.unlock();
+    if (WriteCheckpoint(path_, checkpoint, fsync_)) {
+      writes_total_.fetch_add(1, std::memory_order_relaxed);
+    }
+    lock.lock();
+    completed_ = sequence;
+    cv_.notify_all();
+  }
+}
+
+} // namespace aethersense::io
@@ -0,0 +1,542 @@
+#include "aethersense/io/compressed_capture.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/io/checkpoint.hpp"
+
+namespace aethersense::io {
+namespace {
+
+// File header field offsets (shared with the binary capture's header).
+constexpr std::size_t kVersionOffset = 8;
+constexpr std::size_t kHeaderSizeOffset = 10;
+constexpr std::size_t kRxOffset = 12;
+constexpr std::size_t kTxOffset = 13;
+constexpr std::size_t kSubcarriersOffset = 14;
+constexpr std::size_t kCenterFreqOffset = 16;
+constexpr std::size_t kBlockFramesOffset = 24;
+constexpr std::size_t kHeaderCrcOffset = 28;
+// Block header field offsets.
+constexpr std::size_t kBlockCrcOffset = 4;
+constexpr std::size_t kPayloadBytesOffset = 8;
+constexpr std::size_t kFrameCountOffset = 12;
+constexpr std::size_t kCodecOffset = 14;
+constexpr std::size_t kScaleOffset = 16;
+constexpr std::size_t kFirstTimestampOffset = 24;
+
+constexpr std::size_t kGroup = 32;
+constexpr float kInt16Max = 32767.0F;
+
+template <typename T> T Load(const char *p) {
+  T v{};
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+template <typename T> void Store(char *p, T v) { std::memcpy(p, &v, sizeof(T)); }
+
+std::uint32_t ZigZag(std::int32_t v) {
+  return (static_cast<std::uint32_t>(v) << 1U) ^ static_cast<std::uint32_t>(v >> 31);
+}
+std::int32_t UnZigZag(std::uint32_t v) {
+  return static_cast<std::int32_t>(v >> 1U) ^ -static_cast<std::int32_t>(v & 1U);
+}
+
+void PutVarint(std::uint64_t v, std::vector<char> &out) {
+  while (v >= 0x80U) {
+    out.push_back(static_cast<char>((v & 0x7FU) | 0x80U));
+    v >>= 7U;
+  }
+  out.push_back(static_cast<char>(v));
+}
+
+bool GetVarint(const char *&p, const char *end, std::uint64_t &v) {
+  v = 0;
+  for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+    const auto byte = static_cast<unsigned char>(*p++);
+    v |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+    if ((byte & 0x80U) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Appends `values` in groups of kGroup, each a width byte and a shift byte followed by the
+// group's values, shifted right by the low zero bits they all share, packed LSB-first at that
+// width.
+void PackGroups(const std::uint32_t *values, std::size_t count, std::vector<char> &out) {
+  for (std::size_t g = 0; g < count; g += kGroup) {
+    const std::size_t n = std::min(kGroup, count - g);
+    std::uint32_t any = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      any |= values[g + i];
+    }
+    const auto shift = any == 0 ? 0U : static_cast<unsigned>(std::countr_zero(any));
+    const auto width = static_cast<unsigned>(32 - std::countl_zero(any)) - shift;
+    const std::size_t bytes = (n * width + 7) / 8;
+    const std::size_t at = out.size();
+    out.resize(at + 2 + bytes + 4); // slack for the last 32-bit store
+    char *p = out.data() + at;
+    *p++ = static_cast<char>(width);
+    *p++ = static_cast<char>(shift);
+    std::uint64_t acc = 0;
+    unsigned bits = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      acc |= static_cast<std::uint64_t>(values[g + i] >> shift) << bits;
+      bits += width;
+      if (bits >= 32) {
+        Store(p, static_cast<std::uint32_t>(acc));
+        p += 4;
+        acc >>= 32U;
+        bits -= 32;
+      }
+    }
+    Store(p, static_cast<std::uint32_t>(acc));
+    out.resize(at + 2 + bytes);
+  }
+}
+
+// Inverse of PackGroups; null if the groups run past `end`.
+const char *UnpackGroups(const char *p, const char *end, std::size_t count,
+                         std::uint32_t *values) {
+  for (std::size_t g = 0; g < count; g += kGroup) {
+    if (end - p < 2) {
+      return nullptr;
+    }
+    const std::size_t n = std::min(kGroup, count - g);
+    const auto width = static_cast<unsigned>(static_cast<unsigned char>(*p++));
+    const auto shift = static_cast<unsigned>(static_cast<unsigned char>(*p++));
+    const std::size_t bytes = (n * width + 7) / 8;
+    if (width + shift > 32 || static_cast<std::size_t>(end - p) < bytes) {
+      return nullptr;
+    }
+    if (width == 0) {
+      std::fill_n(values + g, n, 0U);
+      continue;
+    }
+    const std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+    const auto *in = reinterpret_cast<const unsigned char *>(p);
+    std::uint64_t acc = 0;
+    unsigned bits = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      while (bits < width) {
+        acc |= static_cast<std::uint64_t>(*in++) << bits;
+        bits += 8;
+      }
+      values[g + i] = static_cast<std::uint32_t>(acc & mask) << shift;
+      acc >>= width;
+      bits -= width;
+    }
+    p += bytes;
+  }
+  return p;
+}
+
+std::int32_t Quantize(float v, float inv_scale) {
+  if (!std::isfinite(v)) {
+    return 0;
+  }
+  return static_cast<std::int32_t>(std::clamp(std::nearbyint(v * inv_scale), -kInt16Max, kInt16Max));
+}
+
+} // namespace
+
+std::optional<CsiCodec> ParseCsiCodec(const std::string &name) {
+  if (name == "lossless") {
+    return CsiCodec::kLossless;
+  }
+  if (name == "int16") {
+    return CsiCodec::kInt16;
+  }
+  return std::nullopt;
+}
+
+void EncodeCsiBlock(CsiCodec codec, std::span<const std::uint64_t> timestamps,
+                    std::span<const std::complex<float>> samples, std::vector<char> &out) {
+  const std::size_t frames = timestamps.size();
+  const std::size_t lanes = frames == 0 ? 0 : 2 * (samples.size() / frames);
+  const auto *values = reinterpret_cast<const float *>(samples.data());
+
+  float scale = 0.0F;
+  if (codec == CsiCodec::kInt16) {
+    float max_abs = 0.0F;
+    for (std::size_t i = 0; i < frames * lanes; ++i) {
+      if (std::isfinite(values[i])) {
+        max_abs = std::max(max_abs, std::fabs(values[i]));
+      }
+    }
+    scale = max_abs / kInt16Max;
+  }
+  const float inv_scale = scale > 0.0F ? 1.0F / scale : 0.0F;
+
+  const std::size_t start = out.size();
+  out.resize(start + kCsiBlockHeaderBytes);
+  for (std::size_t t = 1; t < frames; ++t) {
+    const auto delta = static_cast<std::int64_t>(timestamps[t] - timestamps[t - 1]);
+    PutVarint((static_cast<std::uint64_t>(delta) << 1U) ^ static_cast<std::uint64_t>(delta >> 63),
+              out);
+  }
+  std::vector<std::uint32_t> residual(lanes);
+  std::vector<std::uint32_t> previous(lanes, 0U);
+  for (std::size_t t = 0; t < frames; ++t) {
+    const float *frame = values + t * lanes;
+    for (std::size_t k = 0; k < lanes; ++k) {
+      if (codec == CsiCodec::kLossless) {
+        const auto bits = std::bit_cast<std::uint32_t>(frame[k]);
+        residual[k] = bits ^ previous[k];
+        previous[k] = bits;
+      } else {
+        const std::int32_t q = Quantize(frame[k], inv_scale);
+        residual[k] = ZigZag(q - static_cast<std::int32_t>(previous[k]));
+        previous[k] = static_cast<std::uint32_t>(q);
+      }
+    }
+    PackGroups(residual.data(), lanes, out);
+  }
+
+  char *header = out.data() + start;
+  const std::size_t payload = out.size() - start - kCsiBlockHeaderBytes;
+  std::memset(header, 0, kCsiBlockHeaderBytes);
+  Store(header, kCsiBlockSync);
+  Store(header + kPayloadBytesOffset, static_cast<std::uint32_t>(payload));
+  Store(header + kFrameCountOffset, static_cast<std::uint16_t>(frames));
+  Store(header + kCodecOffset, static_cast<std::uint8_t>(codec));
+  Store(header + kScaleOffset, scale);
+  Store(header + kFirstTimestampOffset, frames == 0 ? std::uint64_t{0} : timestamps[0]);
+  Store(header + kBlockCrcOffset,
+        Crc32c(header + kPayloadBytesOffset, kCsiBlockHeaderBytes - kPayloadBytesOffset + payload));
+}
+
+std::size_t CheckCsiBlock(const char *data, std::size_t size) {
+  if (size < kCsiBlockHeaderBytes || Load<std::uint32_t>(data) != kCsiBlockSync) {
+    return 0;
+  }
+  const std::size_t payload = Load<std::uint32_t>(data + kPayloadBytesOffset);
+  if (payload > size - kCsiBlockHeaderBytes ||
+      Load<std::uint32_t>(data + kBlockCrcOffset) !=
+          Crc32c(data + kPayloadBytesOffset, kCsiBlockHeaderBytes - kPayloadBytesOffset + payload)) {
+    return 0;
+  }
+  return kCsiBlockHeaderBytes + payload;
+}
+
+bool DecodeCsiBlock(const char *block, std::size_t samples_per_frame, std::size_t max_frames,
+                    std::vector<std::uint64_t> &timestamps,
+                    std::vector<std::complex<float>> &samples) {
+  const std::size_t frames = Load<std::uint16_t>(block + kFrameCountOffset);
+  const auto codec = static_cast<CsiCodec>(Load<std::uint8_t>(block + kCodecOffset));
+  const auto scale = Load<float>(block + kScaleOffset);
+  const std::size_t payload = Load<std::uint32_t>(block + kPayloadBytesOffset);
+  const char *p = block + kCsiBlockHeaderBytes;
+  const char *end = p + payload;
+  if (codec != CsiCodec::kLossless && codec != CsiCodec::kInt16) {
+    return false;
+  }
+  // Each timestamp delta takes at least one byte and each packed group at least two, so a frame
+  // count the payload cannot hold is rejected before it sizes the outputs.
+  const std::size_t lanes = 2 * samples_per_frame;
+  const std::size_t min_frame_bytes = (lanes + kGroup - 1) / kGroup * 2;
+  if (frames == 0 || frames > max_frames ||
+      payload < (frames - 1) + frames * min_frame_bytes) {
+    return false;
+  }
+
+  timestamps.resize(frames);
+  timestamps[0] = Load<std::uint64_t>(block + kFirstTimestampOffset);
+  for (std::size_t t = 1; t < frames; ++t) {
+    std::uint64_t zigzag = 0;
+    if (!GetVarint(p, end, zigzag)) {
+      return false;
+    }
+    const std::uint64_t delta = (zigzag >> 1U) ^ (~(zigzag & 1U) + 1);
+    timestamps[t] = timestamps[t - 1] + delta;
+  }
+
+  samples.resize(frames * samples_per_frame);
+  auto *values = reinterpret_cast<float *>(samples.data());
+  std::vector<std::uint32_t> residual(lanes);
+  std::vector<std::int32_t> quantized(codec == CsiCodec::kInt16 ? lanes : 0, 0);
+  for (std::size_t t = 0; t < frames; ++t) {
+    p = UnpackGroups(p, end, lanes, residual.data());
+    if (p == nullptr) {
+      return false;
+    }
+    float *frame = values + t * lanes;
+    if (codec == CsiCodec::kLossless) {
+      const float *previous = t == 0 ? nullptr : frame - lanes;
+      for (std::size_t k = 0; k < lanes; ++k) {
+        const std::uint32_t before = previous == nullptr ? 0U : std::bit_cast<std::uint32_t>(previous[k]);
+        frame[k] = std::bit_cast<float>(residual[k] ^ before);
+      }
+    } else {
+      for (std::size_t k = 0; k < lanes; ++k) {
+        quantized[k] += UnZigZag(residual[k]);
+        frame[k] = static_cast<float>(quantized[k]) * scale;
+      }
+    }
+  }
+  return p == end;
+}
+
+CompressedCaptureWriter::~CompressedCaptureWriter() { close(); }
+
+Result<bool> CompressedCaptureWriter::Open(const std::string &path) {
+  close();
+  if (block_frames_ == 0 || block_frames_ > kMaxBlockFrames) {
+    return Error{ErrorCode::kInvalidArgument, "block frames must be in [1, 65535]"};
+  }
+  out_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to open capture for writing: " + path};
+  }
+  path_ = path;
+  header_written_ = false;
+  timestamps_.clear();
+  samples_.clear();
+  frames_written_ = 0;
+  return true;
+}
+
+Result<bool> CompressedCaptureWriter::write(const FrameView &frame) {
+  if (!out_.is_open()) {
+    return Error{ErrorCode::kIoError, "capture writer is not open"};
+  }
+  const std::size_t samples =
+      static_cast<std::size_t>(frame.rx_count) * frame.tx_count * frame.subcarrier_count;
+  if (frame.data.size() < samples) {
+    return Error{ErrorCode::kInvalidArgument, "frame.data is smaller than rx*tx*subcarriers"};
+  }
+  if (!header_written_) {
+    auto written =
+        WriteHeader(frame.rx_count, frame.tx_count, frame.subcarrier_count, frame.center_freq_hz);
+    if (!written.ok()) {
+      return written;
+    }
+    shape_ = frame;
+    shape_.data = {};
+    timestamps_.reserve(block_frames_);
+    samples_.reserve(block_frames_ * samples);
+  } else if (frame.rx_count != shape_.rx_count || frame.tx_count != shape_.tx_count ||
+             frame.subcarrier_count != shape_.subcarrier_count ||
+             frame.center_freq_hz != shape_.center_freq_hz) {
+    return Error{ErrorCode::kInvalidArgument, "frame shape differs from the capture header"};
+  }
+
+  timestamps_.push_back(frame.timestamp_ns);
+  samples_.insert(samples_.end(), frame.data.begin(), frame.data.begin() + static_cast<std::ptrdiff_t>(samples));
+  ++frames_written_;
+  if (timestamps_.size() == block_frames_) {
+    return FlushBlock();
+  }
+  return true;
+}
+
+Result<bool> CompressedCaptureWriter::close() {
+  if (!out_.is_open()) {
+    return true;
+  }
+  auto flushed = header_written_ ? FlushBlock() : WriteHeader(0, 0, 0, 0);
+  out_.close();
+  if (!flushed.ok()) {
+    return flushed;
+  }
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to write capture: " + path_};
+  }
+  return true;
+}
+
+Result<bool> CompressedCaptureWriter::WriteHeader(std::uint8_t rx, std::uint8_t tx,
+                                                  std::uint16_t subcarriers,
+                                                  std::uint64_t center_freq_hz) {
+  std::array<char, kCompressedHeaderBytes> header{};
+  std::memcpy(header.data(), kCompressedCaptureMagic, sizeof(kCompressedCaptureMagic));
+  Store(header.data() + kVersionOffset, kCompressedCaptureVersion);
+  Store(header.data() + kHeaderSizeOffset, static_cast<std::uint16_t>(kCompressedHeaderBytes));
+  Store(header.data() + kRxOffset, rx);
+  Store(header.data() + kTxOffset, tx);
+  Store(header.data() + kSubcarriersOffset, subcarriers);
+  Store(header.data() + kCenterFreqOffset, center_freq_hz);
+  Store(header.data() + kBlockFramesOffset, static_cast<std::uint32_t>(block_frames_));
+  Store(header.data() + kHeaderCrcOffset, Crc32c(header.data(), kHeaderCrcOffset));
+  out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to write capture: " + path_};
+  }
+  header_written_ = true;
+  return true;
+}
+
+Result<bool> CompressedCaptureWriter::FlushBlock() {
+  if (timestamps_.empty()) {
+    return true;
+  }
+  block_.clear();
+  EncodeCsiBlock(codec_, timestamps_, samples_, block_);
+  timestamps_.clear();
+  samples_.clear();
+  out_.write(block_.data(), static_cast<std::streamsize>(block_.size()));
+  if (!out_) {
+    return Error{ErrorCode::kIoError, "failed to write capture: " + path_};
+  }
+  return true;
+}
+
+Result<bool> CompressedCaptureReader::Open(const std::string &path) {
+  auto mapped = file_.Open(path);
+  if (!mapped.ok()) {
+    return mapped.error();
+  }
+  const char *h = file_.data();
+  if (file_.size() < kCompressedHeaderBytes ||
+      std::memcmp(h, kCompressedCaptureMagic, sizeof(kCompressedCaptureMagic)) != 0) {
+    return Error{ErrorCode::kUnsupportedFormat, "not a compressed CSI capture: " + path};
+  }
+  if (Load<std::uint32_t>(h + kHeaderCrcOffset) != Crc32c(h, kHeaderCrcOffset)) {
+    return Error{ErrorCode::kParseError, "compressed capture header is corrupt: " + path};
+  }
+  if (Load<std::uint16_t>(h + kVersionOffset) != kCompressedCaptureVersion ||
+      Load<std::uint16_t>(h + kHeaderSizeOffset) != kCompressedHeaderBytes) {
+    return Error{ErrorCode::kUnsupportedFormat, "unsupported compressed capture version: " + path};
+  }
+  shape_.rx_count = Load<std::uint8_t>(h + kRxOffset);
+  shape_.tx_count = Load<std::uint8_t>(h + kTxOffset);
+  shape_.subcarrier_count = Load<std::uint16_t>(h + kSubcarriersOffset);
+  shape_.center_freq_hz = Load<std::uint64_t>(h + kCenterFreqOffset);
+  samples_per_frame_ =
+      static_cast<std::size_t>(shape_.rx_count) * shape_.tx_count * shape_.subcarrier_count;
+  block_frames_ = Load<std::uint32_t>(h + kBlockFramesOffset);
+  if (block_frames_ == 0 || block_frames_ > kMaxBlockFrames) {
+    return Error{ErrorCode::kParseError, "compressed capture block size is invalid: " + path};
+  }
+
+  signature_ = FileSignature(path);
+  offset_ = kCompressedHeaderBytes;
+  if (cfg_.start_position == "end") {
+    offset_ = file_.size();
+  } else if (cfg_.start_position == "offset") {
+    offset_ = static_cast<std::size_t>(std::clamp<std::uint64_t>(
+        cfg_.start_offset, kCompressedHeaderBytes, std::max(file_.size(), kCompressedHeaderBytes)));
+  } else if (cfg_.start_position == "checkpoint") {
+    const auto ck = ReadCheckpoint(cfg_.checkpoint_path);
+    if (ck.has_value() && ck->signature == signature_ && ck->offset >= kCompressedHeaderBytes &&
+        ck->offset <= file_.size()) {
+      offset_ = static_cast<std::size_t>(ck->offset);
+      ++stats_.checkpoint_resume_total;
+    }
+  }
+  return true;
+}
+
+Result<bool> CompressedCaptureReader::LoadBlock() {
+  while (offset_ < file_.size()) {
+    const std::size_t size = file_.size() - offset_;
+    const std::size_t bytes = CheckCsiBlock(file_.data() + offset_, size);
+    if (bytes > 0 && DecodeCsiBlock(file_.data() + offset_, samples_per_frame_, block_frames_,
+                                    timestamps_, samples_)) {
+      block_offset_ = offset_;
+      offset_ += bytes;
+      next_frame_ = 0;
+      return true;
+    }
+    if (size < kCsiBlockHeaderBytes ||
+        (Load<std::uint32_t>(file_.data() + offset_) == kCsiBlockSync &&
+         Load<std::uint32_t>(file_.data() + offset_ + kPayloadBytesOffset) >
+             size - kCsiBlockHeaderBytes)) {
+      // A capture cut off mid-block.
+      ++stats_.records_partial_total;
+      offset_ = file_.size();
+      return false;
+    }
+
+    ++stats_.records_corrupt_total;
+    const char *data = file_.data();
+    constexpr auto kFirstSyncByte = static_cast<unsigned char>(kCsiBlockSync & 0xFFU);
+    std::size_t pos = offset_ + 1;
+    offset_ = file_.size();
+    while (pos < file_.size()) {
+      const auto *hit =
+          static_cast<const char *>(std::memchr(data + pos, kFirstSyncByte, file_.size() - pos));
+      if (hit == nullptr) {
+        break;
+      }
+      pos = static_cast<std::size_t>(hit - data);
+      if (CheckCsiBlock(data + pos, file_.size() - pos) > 0) {
+        offset_ = pos;
+        break;
+      }
+      ++pos;
+    }
+    if (corrupt_.AddCorrupt()) {
+      return Error{ErrorCode::kParseError, "corrupt ratio exceeded"};
+    }
+  }
+  return false;
+}
+
+Result<bool> CompressedCaptureReader::next_view(FrameView &view) {
+  if (!file_.is_open()) {
+    return Error{ErrorCode::kIoError, "stream not opened"};
+  }
+  if (next_frame_ >= timestamps_.size()) {
+    auto loaded = LoadBlock();
+    if (!loaded.ok() || !loaded.value()) {
+      checkpoint_.Flush();
+      return loaded;
+    }
+  }
+  const std::size_t t = next_frame_++;
+  view = shape_;
+  view.timestamp_ns = timestamps_[t];
+  view.data = std::span<const std::complex<float>>(samples_).subspan(t * samples_per_frame_,
+                                                                     samples_per_frame_);
+  ++stats_.records_total;
+  corrupt_.AddGood();
+  if (next_frame_ == timestamps_.size()) {
+    checkpoint_.Update({signature_, offset_, view.timestamp_ns}, timestamps_.size());
+  }
+  return true;
+}
+
+StreamStats CompressedCaptureReader::stream_stats() const {
+  StreamStats stats = stats_;
+  stats.checkpoint_writes_total = checkpoint_.writes_total();
+  return stats;
+}
+
+Result<std::optional<CsiFrame>> CompressedCaptureReader::next() {
+  CsiFrame frame;
+  auto got = next_into(frame);
+  if (!got.ok()) {
+    return got.error();
+  }
+  if (!got.value()) {
+    return std::optional<CsiFrame>{};
+  }
+  return std::optional<CsiFrame>{std::move(frame)};
+}
+
+Result<bool> CompressedCaptureReader::next_into(CsiFrame &frame) {
+  FrameView view;
+  auto got = next_view(view);
+  if (!got.ok() || !got.value()) {
+    return got;
+  }
+  frame.timestamp_ns = view.timestamp_ns;
+  frame.center_freq_hz = view.center_freq_hz;
+  frame.subcarrier_count = view.subcarrier_count;
+  frame.rx_count = view.rx_count;
+  frame.tx_count = view.tx_count;
+  frame.data.assign(view.data.begin(), view.data.end());
+  return true;
+}
+
+} // namespace aethersense::io
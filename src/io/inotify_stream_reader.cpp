@@ -0,0 +1,294 @@
+#include "aethersense/io/inotify_stream_reader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aethersense/io/checkpoint.hpp"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aethersense::io {
+
+#if defined(__linux__)
+namespace {
+
+constexpr std::size_t kReadChunkBytes = 64 * 1024;
+constexpr std::uint32_t kFileEvents = IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF | IN_ATTRIB;
+constexpr std::uint32_t kDirEvents = IN_CREATE | IN_MOVED_TO;
+
+class InotifyStreamReader final : public IStreamReader {
+public:
+  InotifyStreamReader(const Config::Io &cfg, int inotify_fd)
+      : cfg_(cfg), inotify_fd_(inotify_fd),
+        buffer_(kReadChunkBytes + std::max<std::size_t>(cfg.max_partial_line_bytes, 1)) {}
+
+  ~InotifyStreamReader() override {
+    CloseFile();
+    ::close(inotify_fd_);
+  }
+
+  Result<bool> open(const std::string &path) override {
+    path_ = path;
+    const auto slash = path_.find_last_of('/');
+    name_ = slash == std::string::npos ? path_ : path_.substr(slash + 1);
+    const std::string dir =
+        slash == std::string::npos ? "." : path_.substr(0, std::max<std::size_t>(slash, 1));
+    if (dir_wd_ >= 0) {
+      ::inotify_rm_watch(inotify_fd_, dir_wd_);
+    }
+    // Without the directory watch a rotation is still seen through the file's own events.
+    dir_wd_ = ::inotify_add_watch(inotify_fd_, dir.c_str(), kDirEvents);
+    auto opened = OpenFile();
+    if (!opened.ok()) {
+      return opened;
+    }
+    ResumeIfCheckpointed();
+    return true;
+  }
+
+  Result<StreamRecord> read_next() override {
+    if (fd_ < 0) {
+      return Error{ErrorCode::kIoError, "stream not opened"};
+    }
+    bool waited = false;
+    while (true) {
+      const char *begin = buffer_.data() + begin_;
+      const std::size_t pending = end_ - begin_;
+      const auto *nl = static_cast<const char *>(std::memchr(begin, '\n', pending));
+      if (nl != nullptr || (pending > 0 && pending >= cfg_.max_partial_line_bytes)) {
+        const std::size_t len = nl != nullptr ? static_cast<std::size_t>(nl - begin) : pending;
+        const std::size_t consumed = nl != nullptr ? len + 1 : len;
+        begin_ += consumed;
+        offset_ += consumed;
+        ++stats_.records_total;
+        stats_.consecutive_errors_current = 0;
+        checkpoint_.Update({signature_, offset_, 0});
+        return StreamRecord{std::string_view(begin, len), false};
+      }
+
+      auto filled = Fill();
+      if (!filled.ok()) {
+        ++stats_.consecutive_errors_current;
+        return filled.error();
+      }
+      if (filled.value()) {
+        continue;
+      }
+      // At the end of the file.
+      if ((modified_ || replaced_) && CheckRotation()) {
+        continue;
+      }
+      if (waited) {
+        return StreamRecord{"", false};
+      }
+      checkpoint_.FlushIfStale();
+      waited = true;
+      if (!Wait()) {
+        return StreamRecord{"", false};
+      }
+    }
+  }
+
+  StreamStats stats() const override {
+    StreamStats stats = stats_;
+    stats.checkpoint_writes_total = checkpoint_.writes_total();
+    return stats;
+  }
+  std::uint64_t last_timestamp_ns() const override { return 0; }
+
+private:
+  Result<bool> OpenFile() {
+    const int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return Error{ErrorCode::kIoError, "failed to open stream: " + path_};
+    }
+    CloseFile();
+    fd_ = fd;
+    struct stat st {};
+    ::fstat(fd_, &st);
+    device_ = static_cast<std::uint64_t>(st.st_dev);
+    inode_ = static_cast<std::uint64_t>(st.st_ino);
+    if (file_wd_ >= 0) {
+      ::inotify_rm_watch(inotify_fd_, file_wd_);
+    }
+    file_wd_ = ::inotify_add_watch(inotify_fd_, path_.c_str(), kFileEvents);
+    signature_ = FileSignature(path_);
+    begin_ = end_ = 0;
+    offset_ = file_pos_ = 0;
+    modified_ = replaced_ = false;
+    return true;
+  }
+
+  void CloseFile() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  void SeekTo(std::uint64_t offset) {
+    const auto pos = ::lseek(fd_, static_cast<off_t>(offset), SEEK_SET);
+    offset_ = file_pos_ = pos < 0 ? 0 : static_cast<std::uint64_t>(pos);
+  }
+
+  void ResumeIfCheckpointed() {
+    if (cfg_.start_position == "end") {
+      const auto end = ::lseek(fd_, 0, SEEK_END);
+      offset_ = file_pos_ = end < 0 ? 0 : static_cast<std::uint64_t>(end);
+      return;
+    }
+    if (cfg_.start_position == "offset") {
+      SeekTo(cfg_.start_offset);
+      return;
+    }
+    if (cfg_.start_position != "checkpoint")
+      return;
+    const auto ck = ReadCheckpoint(cfg_.checkpoint_path);
+    if (ck.has_value() && ck->signature == signature_) {
+      SeekTo(ck->offset);
+      ++stats_.checkpoint_resume_total;
+    }
+  }
+
+  // Moves the unconsumed bytes to the front and reads once; false at the end of the file.
+  Result<bool> Fill() {
+    if (begin_ > 0) {
+      std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+      end_ -= begin_;
+      begin_ = 0;
+    }
+    while (true) {
+      const ssize_t n = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+      if (n > 0) {
+        end_ += static_cast<std::size_t>(n);
+        file_pos_ += static_cast<std::uint64_t>(n);
+        modified_ = false; // new data: not a truncation
+        return true;
+      }
+      if (n == 0) {
+        return false;
+      }
+      if (errno != EINTR) {
+        return Error{ErrorCode::kIoError,
+                     "stream read failure: " + std::string(std::strerror(errno))};
+      }
+    }
+  }
+
+  // True if the file was rotated or truncated and reading starts over.
+  bool CheckRotation() {
+    bool rotated = false;
+    if (modified_) {
+      struct stat st {};
+      rotated = ::fstat(fd_, &st) == 0 && static_cast<std::uint64_t>(st.st_size) < file_pos_;
+      modified_ = false;
+    }
+    if (replaced_) {
+      // A missing path keeps the open file until the new one appears (IN_CREATE).
+      const auto now = StatFile(path_);
+      rotated = rotated || (now.has_value() && (now->device != device_ || now->inode != inode_));
+      replaced_ = false;
+    }
+    if (!rotated) {
+      return false;
+    }
+    ++stats_.rotations_detected_total;
+    checkpoint_.Flush();
+    if (cfg_.rotate_handling != "reopen") {
+      return false;
+    }
+    if (end_ > begin_) {
+      ++stats_.records_partial_total; // the old file ended mid-line
+    }
+    return OpenFile().ok();
+  }
+
+  // Sleeps until the file or its directory changes, or io.poll_interval_ms passes (only checks
+  // with io.tail_nonblocking); false on timeout.
+  bool Wait() {
+    pollfd pfd{inotify_fd_, POLLIN, 0};
+    const int ready = ::poll(&pfd, 1, cfg_.tail_nonblocking ? 0 : cfg_.poll_interval_ms);
+    if (ready <= 0) {
+      if (file_wd_ < 0) {
+        // Unwatched file (e.g. inotify_add_watch failed): fall back to checking on every poll.
+        modified_ = replaced_ = true;
+      }
+      return false;
+    }
+    DrainEvents();
+    return true;
+  }
+
+  void DrainEvents() {
+    alignas(inotify_event) char events[4096];
+    while (true) {
+      const ssize_t n = ::read(inotify_fd_, events, sizeof(events));
+      if (n <= 0) {
+        return;
+      }
+      for (ssize_t at = 0; at < n;) {
+        const auto *event = reinterpret_cast<const inotify_event *>(events + at);
+        if (event->wd == file_wd_) {
+          modified_ = modified_ || (event->mask & IN_MODIFY) != 0;
+          replaced_ = replaced_ || (event->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_ATTRIB)) != 0;
+        } else if (event->wd == dir_wd_ && event->len > 0 && name_ == event->name) {
+          replaced_ = true;
+        }
+        at += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+      }
+    }
+  }
+
+  Config::Io cfg_;
+  int inotify_fd_;
+  int file_wd_{-1};
+  int dir_wd_{-1};
+  int fd_{-1};
+  std::string path_;
+  std::string name_;
+  std::uint64_t device_{0};
+  std::uint64_t inode_{0};
+  // buffer_[begin_, end_) holds read but unconsumed bytes; the first is at file offset offset_,
+  // and file_pos_ is where the next read() starts.
+  std::vector<char> buffer_;
+  std::size_t begin_{0};
+  std::size_t end_{0};
+  std::uint64_t offset_{0};
+  std::uint64_t file_pos_{0};
+  bool modified_{false};
+  bool replaced_{false};
+  std::string signature_;
+  StreamStats stats_;
+  CheckpointWriter checkpoint_{cfg_};
+};
+
+} // namespace
+
+Result<std::unique_ptr<IStreamReader>> CreateInotifyStreamReader(const Config::Io &cfg) {
+  const int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd < 0) {
+    return Error{ErrorCode::kIoError, "inotify unavailable: " + std::string(std::strerror(errno))};
+  }
+  return std::unique_ptr<IStreamReader>(new InotifyStreamReader(cfg, fd));
+}
+
+#else
+
+Result<std::unique_ptr<IStreamReader>> CreateInotifyStreamReader(const Config::Io &) {
+  return Error{ErrorCode::kUnsupportedFormat, "io.reader inotify requires Linux"};
+}
+
+#endif
+
+} // namespace aethersense::io
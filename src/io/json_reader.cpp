@@ -1,7 +1,12 @@
 #include "aethersense/io/csi_reader.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <utility>
 
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/io/compressed_capture.hpp"
+#include "aethersense/io/parallel_reader.hpp"
 #include "aethersense/io/record_recovery.hpp"
 
 namespace aethersense {
@@ -10,9 +15,22 @@ namespace {
 class RecoveryReader final : public ICsiReader {
 public:
   RecoveryReader(const Config::Io &cfg, std::unique_ptr<io::IStreamReader> stream)
-      : cfg_(cfg), stream_(std::move(stream)) {}
+      : cfg_(cfg), stream_(std::move(stream)), corrupt_(cfg.max_corrupt_ratio) {}
 
   Result<std::optional<CsiFrame>> next() override {
+    CsiFrame frame;
+    auto got = next_into(frame);
+    if (!got.ok()) {
+      return got.error();
+    }
+    if (!got.value()) {
+      return std::optional<CsiFrame>{};
+    }
+    return std::optional<CsiFrame>{std::move(frame)};
+  }
+
+  // Parses straight into the caller's frame: the sample buffer keeps its capacity across calls.
+  Result<bool> next_into(CsiFrame &frame) override {
     while (true) {
       auto rec = stream_->read_next();
       if (!rec.ok()) {
@@ -23,33 +41,26 @@ public:
         continue;
       }
       if (rec.value().eof) {
-        return std::optional<CsiFrame>{};
+        return false;
       }
       if (rec.value().line.empty()) {
-        return std::optional<CsiFrame>{};
+        return false;
       }
 
-      auto parsed = (cfg_.format == "csv") ? io::ParseCsvRecord(rec.value().line)
-                                             : io::ParseJsonlRecord(rec.value().line);
+      auto parsed = (cfg_.format == "csv") ? io::ParseCsvRecordInto(rec.value().line, frame)
+                                             : io::ParseJsonlRecordInto(rec.value().line, frame);
       if (parsed.corrupt) {
         ++stats_.records_corrupt_total;
-        ++corrupt_window_;
-        ++window_size_;
-        if (window_size_ >= 64) {
-          const float ratio = static_cast<float>(corrupt_window_) / static_cast<float>(window_size_);
-          window_size_ = 0;
-          corrupt_window_ = 0;
-          if (ratio > cfg_.max_corrupt_ratio) {
-            return Error{ErrorCode::kParseError, "corrupt ratio exceeded"};
-          }
+        if (corrupt_.AddCorrupt()) {
+          return Error{ErrorCode::kParseError, "corrupt ratio exceeded"};
         }
         continue;
       }
 
       ++stats_.records_total;
-      ++window_size_;
+      corrupt_.AddGood();
       stats_.consecutive_errors_current = 0;
-      return std::optional<CsiFrame>{*parsed.frame};
+      return true;
     }
   }
 
@@ -65,13 +76,67 @@ private:
   Config::Io cfg_;
   std::unique_ptr<io::IStreamReader> stream_;
   io::StreamStats stats_;
-  std::size_t corrupt_window_{0};
-  std::size_t window_size_{0};
+  io::CorruptRatioWindow corrupt_;
 };
 
-} // namespace
+// Ends the replay at the first frame stamped after io.stop_timestamp_ns.
+class StopTimestampReader final : public ICsiReader {
+public:
+  StopTimestampReader(std::unique_ptr<ICsiReader> inner, std::uint64_t stop_timestamp_ns)
+      : inner_(std::move(inner)), stop_timestamp_ns_(stop_timestamp_ns) {}
 
-Result<std::unique_ptr<ICsiReader>> CreateReader(const Config::Io &io_cfg, const std::string &path) {
+  Result<std::optional<CsiFrame>> next() override {
+    CsiFrame frame;
+    auto got = next_into(frame);
+    if (!got.ok()) {
+      return got.error();
+    }
+    if (!got.value()) {
+      return std::optional<CsiFrame>{};
+    }
+    return std::optional<CsiFrame>{std::move(frame)};
+  }
+
+  Result<bool> next_into(CsiFrame &frame) override {
+    if (stopped_) {
+      return false;
+    }
+    auto got = inner_->next_into(frame);
+    if (got.ok() && got.value() && frame.timestamp_ns > stop_timestamp_ns_) {
+      stopped_ = true;
+      return false;
+    }
+    return got;
+  }
+
+  io::StreamStats stream_stats() const override { return inner_->stream_stats(); }
+
+private:
+  std::unique_ptr<ICsiReader> inner_;
+  std::uint64_t stop_timestamp_ns_;
+  bool stopped_{false};
+};
+
+Result<std::unique_ptr<ICsiReader>> OpenReader(const Config::Io &io_cfg, const std::string &path) {
+  if (io_cfg.format == "binary") {
+    auto reader = std::make_unique<io::BinaryCaptureReader>(io_cfg);
+    auto opened = reader->Open(path);
+    if (!opened.ok()) {
+      return opened.error();
+    }
+    return std::unique_ptr<ICsiReader>(std::move(reader));
+  }
+  if (io_cfg.format == "compressed") {
+    auto reader = std::make_unique<io::CompressedCaptureReader>(io_cfg);
+    auto opened = reader->Open(path);
+    if (!opened.ok()) {
+      return opened.error();
+    }
+    return std::unique_ptr<ICsiReader>(std::move(reader));
+  }
+  if (io_cfg.mode == "file" && io_cfg.parse_threads != 1) {
+    return CreateParallelReader(io_cfg, path);
+  }
   auto stream = io::CreateStreamReader(io_cfg);
   if (!stream.ok()) {
     return stream.error();
@@ -83,4 +148,15 @@ Result<std::unique_ptr<ICsiReader>> CreateReader(const Config::Io &io_cfg, const
   return std::unique_ptr<ICsiReader>(new RecoveryReader(io_cfg, std::move(stream.value())));
 }
 
+} // namespace
+
+Result<std::unique_ptr<ICsiReader>> CreateReader(const Config::Io &io_cfg, const std::string &path) {
+  auto reader = OpenReader(io_cfg, path);
+  if (!reader.ok() || io_cfg.stop_timestamp_ns == 0) {
+    return reader;
+  }
+  return std::unique_ptr<ICsiReader>(
+      new StopTimestampReader(std::move(reader.value()), io_cfg.stop_timestamp_ns));
+}
+
 } // namespace aethersense
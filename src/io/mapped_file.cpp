@@ -0,0 +1,85 @@
+#include "aethersense/io/mapped_file.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aethersense::io {
+
+MappedFile::MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Close();
+    size_ = std::exchange(other.size_, 0);
+    open_ = std::exchange(other.open_, false);
+    mapped_ = std::exchange(other.mapped_, false);
+    buffer_ = std::move(other.buffer_);
+    data_ = mapped_ ? std::exchange(other.data_, nullptr) : buffer_.data();
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+Result<bool> MappedFile::Open(const std::string &path) {
+  Close();
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return Error{ErrorCode::kIoError, "failed to open stream: " + path};
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return Error{ErrorCode::kIoError, "failed to stat stream: " + path};
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ > 0) {
+    void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      size_ = 0;
+      return Error{ErrorCode::kIoError, "failed to map stream: " + path};
+    }
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char *>(addr);
+    mapped_ = true;
+  } else {
+    data_ = buffer_.data();
+  }
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+#else
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in) {
+    return Error{ErrorCode::kIoError, "failed to open stream: " + path};
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+  open_ = true;
+  return true;
+}
+
+void MappedFile::Close() {
+#if defined(__unix__) || defined(__APPLE__)
+  if (mapped_) {
+    ::munmap(const_cast<char *>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+  mapped_ = false;
+  buffer_.clear();
+}
+
+} // namespace aethersense::io
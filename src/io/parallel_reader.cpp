@@ -0,0 +1,253 @@
+#include "aethersense/io/parallel_reader.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "aethersense/io/checkpoint.hpp"
+#include "aethersense/io/mapped_file.hpp"
+#include "aethersense/io/record_recovery.hpp"
+
+namespace aethersense {
+namespace {
+
+enum class LineOutcome : std::uint8_t { kFrame, kCorrupt, kEmpty };
+
+// One newline-aligned byte range of the file and what parsing it produced. `frames` keeps its
+// elements (and their sample buffers) across the chunks that reuse the slot.
+struct Chunk {
+  std::size_t begin{0};
+  std::size_t end{0};
+  std::vector<LineOutcome> lines;
+  std::vector<CsiFrame> frames;
+  bool ready{false};
+};
+
+class ParallelFileReader final : public ICsiReader {
+public:
+  ParallelFileReader(const Config::Io &cfg, std::size_t threads)
+      : cfg_(cfg), threads_(threads), slots_(2 * threads), corrupt_(cfg.max_corrupt_ratio) {}
+
+  ~ParallelFileReader() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    space_cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  Result<bool> Open(const std::string &path) {
+    auto mapped = file_.Open(path);
+    if (!mapped.ok()) {
+      return mapped.error();
+    }
+    signature_ = io::FileSignature(path);
+    std::size_t pos = 0;
+    if (cfg_.start_position == "end") {
+      pos = file_.size();
+    } else if (cfg_.start_position == "offset") {
+      pos = static_cast<std::size_t>(std::min<std::uint64_t>(cfg_.start_offset, file_.size()));
+    } else if (cfg_.start_position == "checkpoint") {
+      const auto ck = io::ReadCheckpoint(cfg_.checkpoint_path);
+      if (ck.has_value() && ck->signature == signature_) {
+        pos = static_cast<std::size_t>(std::min<std::uint64_t>(ck->offset, file_.size()));
+        ++stats_.checkpoint_resume_total;
+      }
+    }
+
+    bounds_.assign(1, pos);
+    while (pos < file_.size()) {
+      if (cfg_.parse_chunk_bytes >= file_.size() - pos) {
+        pos = file_.size();
+      } else {
+        const std::size_t target = pos + cfg_.parse_chunk_bytes - 1;
+        const auto *nl = static_cast<const char *>(
+            std::memchr(file_.data() + target, '\n', file_.size() - target));
+        pos = nl != nullptr ? static_cast<std::size_t>(nl - file_.data()) + 1 : file_.size();
+      }
+      bounds_.push_back(pos);
+    }
+
+    const std::size_t workers = std::min(threads_, bounds_.size() - 1);
+    for (std::size_t i = 0; i < workers; ++i) {
+      workers_.emplace_back([this] { Work(); });
+    }
+    return true;
+  }
+
+  Result<std::optional<CsiFrame>> next() override {
+    CsiFrame frame;
+    auto got = next_into(frame);
+    if (!got.ok()) {
+      return got.error();
+    }
+    if (!got.value()) {
+      return std::optional<CsiFrame>{};
+    }
+    return std::optional<CsiFrame>{std::move(frame)};
+  }
+
+  // Replays the parsed lines in file order with RecoveryReader's accounting. The caller's frame
+  // is swapped with the parsed one, so its buffer goes back to the chunk slot for reuse.
+  Result<bool> next_into(CsiFrame &frame) override {
+    while (true) {
+      if (current_ == nullptr) {
+        if (consumed_ + 1 >= bounds_.size()) {
+          checkpoint_.Flush();
+          return false;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        Chunk &chunk = slots_[consumed_ % slots_.size()];
+        ready_cv_.wait(lock, [&] { return chunk.ready; });
+        current_ = &chunk;
+        line_ = 0;
+        frame_ = 0;
+      }
+
+      Chunk &chunk = *current_;
+      if (line_ == chunk.lines.size()) {
+        checkpoint_.Update({signature_, chunk.end, 0}, chunk.lines.size());
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          chunk.ready = false;
+          ++consumed_;
+        }
+        space_cv_.notify_all();
+        current_ = nullptr;
+        continue;
+      }
+
+      // Every line counts as a stream record, as it does for the stream readers.
+      ++stats_.records_total;
+      switch (chunk.lines[line_++]) {
+      case LineOutcome::kEmpty:
+        checkpoint_.Flush();
+        return false;
+      case LineOutcome::kCorrupt:
+        ++stats_.records_corrupt_total;
+        if (corrupt_.AddCorrupt()) {
+          return Error{ErrorCode::kParseError, "corrupt ratio exceeded"};
+        }
+        continue;
+      case LineOutcome::kFrame:
+        ++stats_.records_total;
+        corrupt_.AddGood();
+        std::swap(frame, chunk.frames[frame_++]);
+        return true;
+      }
+    }
+  }
+
+  io::StreamStats stream_stats() const override {
+    io::StreamStats stats = stats_;
+    stats.checkpoint_writes_total = checkpoint_.writes_total();
+    return stats;
+  }
+
+private:
+  void Work() {
+    while (true) {
+      std::size_t index = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // A slot is free once the consumer has replayed the chunk that used it before.
+        space_cv_.wait(lock, [&] {
+          return stop_ || next_claim_ + 1 >= bounds_.size() ||
+                 next_claim_ < consumed_ + slots_.size();
+        });
+        if (stop_ || next_claim_ + 1 >= bounds_.size()) {
+          return;
+        }
+        index = next_claim_++;
+      }
+      Chunk &chunk = slots_[index % slots_.size()];
+      chunk.begin = bounds_[index];
+      chunk.end = bounds_[index + 1];
+      Parse(chunk);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunk.ready = true;
+      }
+      ready_cv_.notify_one();
+    }
+  }
+
+  void Parse(Chunk &chunk) const {
+    const bool csv = cfg_.format == "csv";
+    chunk.lines.clear();
+    std::size_t frames = 0;
+    const char *p = file_.data() + chunk.begin;
+    const char *end = file_.data() + chunk.end;
+    while (p < end) {
+      const auto *nl = static_cast<const char *>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+      const std::string_view line(p, static_cast<std::size_t>((nl != nullptr ? nl : end) - p));
+      p = nl != nullptr ? nl + 1 : end;
+      if (line.empty()) {
+        chunk.lines.push_back(LineOutcome::kEmpty);
+        continue;
+      }
+      if (frames == chunk.frames.size()) {
+        chunk.frames.emplace_back();
+      }
+      const auto status = csv ? io::ParseCsvRecordInto(line, chunk.frames[frames])
+                              : io::ParseJsonlRecordInto(line, chunk.frames[frames]);
+      if (status.corrupt) {
+        chunk.lines.push_back(LineOutcome::kCorrupt);
+      } else {
+        chunk.lines.push_back(LineOutcome::kFrame);
+        ++frames;
+      }
+    }
+  }
+
+  Config::Io cfg_;
+  std::size_t threads_;
+  io::MappedFile file_;
+  std::string signature_;
+  // Chunk i spans [bounds_[i], bounds_[i + 1]) and is parsed into slots_[i % slots_.size()].
+  std::vector<std::size_t> bounds_;
+  std::vector<Chunk> slots_;
+
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::condition_variable space_cv_;
+  std::size_t next_claim_{0};
+  std::size_t consumed_{0};
+  bool stop_{false};
+  std::vector<std::thread> workers_;
+
+  // Consumer-side replay state.
+  Chunk *current_{nullptr};
+  std::size_t line_{0};
+  std::size_t frame_{0};
+  io::StreamStats stats_;
+  io::CorruptRatioWindow corrupt_;
+  io::CheckpointWriter checkpoint_{cfg_};
+};
+
+} // namespace
+
+Result<std::unique_ptr<ICsiReader>> CreateParallelReader(const Config::Io &io_cfg,
+                                                         const std::string &path) {
+  std::size_t threads = io_cfg.parse_threads;
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  auto reader = std::make_unique<ParallelFileReader>(io_cfg, threads);
+  auto opened = reader->Open(path);
+  if (!opened.ok()) {
+    return opened.error();
+  }
+  return std::unique_ptr<ICsiReader>(std::move(reader));
+}
+
+} // namespace aethersense
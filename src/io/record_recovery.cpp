@@ -1,122 +1,328 @@
 #include "aethersense/io/record_recovery.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <complex>
-#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 namespace aethersense::io {
 namespace {
-std::vector<std::string> Split(const std::string &value, char delim) {
-  std::stringstream ss(value);
-  std::string part;
-  std::vector<std::string> out;
-  while (std::getline(ss, part, delim)) {
-    out.push_back(part);
-  }
-  return out;
+
+// Single-pass, exception-free field parsing. Tokens follow the std::sto* rules the parsers
+// used to rely on: leading whitespace and a '+' sign are skipped and anything after the number,
+// up to the token delimiter, is ignored. A token without a leading number (including an empty
+// one) or one that overflows is invalid. Unlike std::stoull, a '-' on an unsigned field is
+// rejected rather than wrapped.
+
+bool IsSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+// Moves `p` to the first of `delims` at or after it, or to `end`.
+const char *SkipToAny(const char *p, const char *end, std::string_view delims) {
+  while (p < end && delims.find(*p) == std::string_view::npos) {
+    ++p;
+  }
+  return p;
 }
 
-bool ParseFloatList(const std::string &value, char delim, std::vector<float> &out) {
-  for (const auto &token : Split(value, delim)) {
-    try {
-      out.push_back(std::stof(token));
-    } catch (...) {
-      return false;
+// Parses the number that starts the token at `p` and advances `p` to the token's delimiter.
+template <typename T>
+bool ParseToken(const char *&p, const char *end, std::string_view delims, T &out) {
+  while (p < end && IsSpace(*p)) {
+    ++p;
+  }
+  if (p < end && *p == '+') {
+    ++p;
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    // strtof also reads hexadecimal floats ("0x1.8p3"); from_chars wants them without "0x".
+    const bool negative = p < end && *p == '-';
+    const char *hex = p + (negative ? 1 : 0);
+    if (end - hex > 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+      const auto [ptr, ec] = std::from_chars(hex + 2, end, out, std::chars_format::hex);
+      if (ec == std::errc{}) {
+        out = negative ? -out : out;
+        p = SkipToAny(ptr, end, delims);
+        return true;
+      }
     }
   }
-  return true;
+  const auto [ptr, ec] = std::from_chars(p, end, out);
+  const bool ok = ec == std::errc{} && ptr != p;
+  p = SkipToAny(ptr, end, delims);
+  return ok;
 }
-} // namespace
 
-RecoveryResult ParseCsvRecord(const std::string &line) {
-  const auto cols = Split(line, ',');
-  if (cols.size() != 7) {
-    return {.corrupt = true, .error = "CSV line must have 7 columns"};
+enum class Part { kReal, kImag };
+
+// Parses a `sep`-separated list of floats that ends at `terminator` (or `end`) into one part
+// of `data`, growing it as needed; returns the token count. As with std::getline splitting, an
+// empty list has no tokens and a trailing separator adds none. `bad_token` is set (and the rest
+// of the list skipped) on the first invalid token.
+std::size_t ParseFloatList(const char *&p, const char *end, char sep, char terminator, Part part,
+                           std::vector<std::complex<float>> &data, bool &bad_token) {
+  const char delims[] = {sep, terminator};
+  const std::string_view token_delims(delims, 2);
+  std::size_t count = 0;
+  while (p < end && *p != terminator) {
+    float v = 0.0F;
+    if (!ParseToken(p, end, token_delims, v)) {
+      bad_token = true;
+      p = SkipToAny(p, end, token_delims.substr(1));
+      return count;
+    }
+    if (count < data.size()) {
+      part == Part::kReal ? data[count].real(v) : data[count].imag(v);
+    } else {
+      data.emplace_back(part == Part::kReal ? v : 0.0F, part == Part::kImag ? v : 0.0F);
+    }
+    ++count;
+    if (p < end && *p == sep) {
+      ++p;
+    }
   }
-  CsiFrame frame;
-  try {
-    frame.timestamp_ns = static_cast<std::uint64_t>(std::stoull(cols[0]));
-    frame.center_freq_hz = static_cast<std::uint64_t>(std::stoull(cols[1]));
-    frame.rx_count = static_cast<std::uint8_t>(std::stoi(cols[2]));
-    frame.tx_count = static_cast<std::uint8_t>(std::stoi(cols[3]));
-    frame.subcarrier_count = static_cast<std::uint16_t>(std::stoi(cols[4]));
-  } catch (...) {
-    return {.corrupt = true, .error = "invalid numeric field"};
+  return count;
+}
+
+// Reserves the sample buffer for `expected` values, bounded by what `line` could hold so a
+// corrupt header cannot trigger a huge allocation.
+void ReserveSamples(std::vector<std::complex<float>> &data, std::size_t expected,
+                    std::size_t line_size) {
+  data.reserve(std::min(expected, line_size / 2 + 1));
+}
+
+RecoveryResult ToResult(ParseStatus status, CsiFrame &&frame) {
+  if (status.corrupt) {
+    return {.frame = std::nullopt, .corrupt = true, .error = std::move(status.error)};
   }
+  return {.frame = std::move(frame), .corrupt = false, .error = {}};
+}
+} // namespace
 
-  std::vector<float> re;
-  std::vector<float> im;
-  if (!ParseFloatList(cols[5], ';', re) || !ParseFloatList(cols[6], ';', im)) {
-    return {.corrupt = true, .error = "invalid float token"};
+RecoveryResult ParseCsvRecord(std::string_view line) {
+  CsiFrame frame;
+  auto status = ParseCsvRecordInto(line, frame);
+  return ToResult(std::move(status), std::move(frame));
+}
+
+RecoveryResult ParseJsonlRecord(std::string_view line) {
+  CsiFrame frame;
+  auto status = ParseJsonlRecordInto(line, frame);
+  return ToResult(std::move(status), std::move(frame));
+}
+
+ParseStatus ParseCsvRecordInto(std::string_view line, CsiFrame &frame) {
+  // timestamp_ns,center_freq_hz,rx,tx,subcarrier_count,data_re,data_im with ';'-separated
+  // lists. Columns are walked once; errors are reported in the order the checks were always
+  // made: column count, numeric fields, float tokens, list lengths.
+  const char *p = line.data();
+  const char *end = p + line.size();
+  std::size_t columns = 0;
+  bool numeric_ok = true;
+  bool bad_token = false;
+  std::size_t re_count = 0;
+  std::size_t im_count = 0;
+  int rx = 0;
+  int tx = 0;
+  int subcarriers = 0;
+  frame.data.clear();
+  // A column that would start at the end of the line does not exist (std::getline splitting).
+  while (p < end) {
+    if (columns == 7) {
+      ++columns;
+      break;
+    }
+    switch (columns) {
+    case 0:
+      numeric_ok &= ParseToken(p, end, ",", frame.timestamp_ns);
+      break;
+    case 1:
+      numeric_ok &= ParseToken(p, end, ",", frame.center_freq_hz);
+      break;
+    case 2:
+      numeric_ok &= ParseToken(p, end, ",", rx);
+      break;
+    case 3:
+      numeric_ok &= ParseToken(p, end, ",", tx);
+      break;
+    case 4:
+      numeric_ok &= ParseToken(p, end, ",", subcarriers);
+      if (numeric_ok) {
+        ReserveSamples(frame.data,
+                       static_cast<std::size_t>(static_cast<std::uint8_t>(rx)) *
+                           static_cast<std::uint8_t>(tx) * static_cast<std::uint16_t>(subcarriers),
+                       line.size());
+      }
+      break;
+    default:
+      if (numeric_ok && !bad_token) {
+        (columns == 5 ? re_count : im_count) = ParseFloatList(
+            p, end, ';', ',', columns == 5 ? Part::kReal : Part::kImag, frame.data, bad_token);
+      } else {
+        p = SkipToAny(p, end, ",");
+      }
+      break;
+    }
+    ++columns;
+    if (p < end) {
+      ++p; // ','
+    }
   }
 
+  if (columns != 7) {
+    return {.corrupt = true, .error = "CSV line must have 7 columns"};
+  }
+  if (!numeric_ok) {
+    return {.corrupt = true, .error = "invalid numeric field"};
+  }
+  frame.rx_count = static_cast<std::uint8_t>(rx);
+  frame.tx_count = static_cast<std::uint8_t>(tx);
+  frame.subcarrier_count = static_cast<std::uint16_t>(subcarriers);
   const std::size_t expected =
       static_cast<std::size_t>(frame.rx_count) * frame.tx_count * frame.subcarrier_count;
-  if (re.size() != expected || im.size() != expected) {
-    return {.corrupt = true, .error = "data_re/data_im length mismatch"};
+  if (bad_token) {
+    return {.corrupt = true, .error = "invalid float token"};
   }
-
-  frame.data.reserve(expected);
-  for (std::size_t i = 0; i < expected; ++i) {
-    frame.data.emplace_back(re[i], im[i]);
+  if (re_count != expected || im_count != expected) {
+    return {.corrupt = true, .error = "data_re/data_im length mismatch"};
   }
-  return {.frame = std::move(frame)};
+  return {};
 }
 
-RecoveryResult ParseJsonlRecord(const std::string &line) {
-  auto grab = [&](const std::string &key) -> std::optional<std::string> {
-    const auto p = line.find("\"" + key + "\"");
-    if (p == std::string::npos)
-      return std::nullopt;
-    const auto c = line.find(':', p);
-    if (c == std::string::npos)
-      return std::nullopt;
-    auto end = line.find_first_of(",}", c + 1);
-    if (end == std::string::npos)
-      end = line.size();
-    return line.substr(c + 1, end - c - 1);
-  };
-  auto array = [&](const std::string &key) -> std::optional<std::string> {
-    const auto p = line.find("\"" + key + "\"");
-    if (p == std::string::npos)
-      return std::nullopt;
-    const auto b = line.find('[', p);
-    const auto e = line.find(']', b);
-    if (b == std::string::npos || e == std::string::npos)
-      return std::nullopt;
-    return line.substr(b + 1, e - b - 1);
+ParseStatus ParseJsonlRecordInto(std::string_view line, CsiFrame &frame) {
+  // One scan over the object: every quoted string followed by ':' is a key; known keys are
+  // parsed in place (the first occurrence wins) and everything else is stepped over.
+  enum Field : unsigned {
+    kTimestamp = 1U << 0U,
+    kCenterFreq = 1U << 1U,
+    kRx = 1U << 2U,
+    kTx = 1U << 3U,
+    kSubcarriers = 1U << 4U,
+    kDataRe = 1U << 5U,
+    kDataIm = 1U << 6U,
   };
+  constexpr unsigned kNumeric = kTimestamp | kCenterFreq | kRx | kTx | kSubcarriers;
+  const char *p = line.data();
+  const char *end = p + line.size();
+  unsigned seen = 0;
+  bool numeric_ok = true;
+  bool bad_token = false;
+  std::size_t re_count = 0;
+  std::size_t im_count = 0;
+  int rx = 0;
+  int tx = 0;
+  int subcarriers = 0;
+  frame.data.clear();
 
-  CsiFrame frame;
-  try {
-    frame.timestamp_ns = std::stoull(*grab("timestamp_ns"));
-    frame.center_freq_hz = std::stoull(*grab("center_freq_hz"));
-    frame.rx_count = static_cast<std::uint8_t>(std::stoi(*grab("rx")));
-    frame.tx_count = static_cast<std::uint8_t>(std::stoi(*grab("tx")));
-    frame.subcarrier_count = static_cast<std::uint16_t>(std::stoi(*grab("subcarrier_count")));
-  } catch (...) {
-    return {.corrupt = true, .error = "JSONL numeric parse failure"};
+  while (p < end) {
+    if (*p != '"') {
+      ++p;
+      continue;
+    }
+    const char *name = ++p;
+    p = SkipToAny(p, end, "\"");
+    if (p == end) {
+      break;
+    }
+    const std::string_view key(name, static_cast<std::size_t>(p - name));
+    ++p;
+    while (p < end && IsSpace(*p)) {
+      ++p;
+    }
+    if (p == end || *p != ':') {
+      continue; // a string value, not a key
+    }
+    ++p;
+
+    unsigned field = 0;
+    if (key == "timestamp_ns") {
+      field = kTimestamp;
+    } else if (key == "center_freq_hz") {
+      field = kCenterFreq;
+    } else if (key == "rx") {
+      field = kRx;
+    } else if (key == "tx") {
+      field = kTx;
+    } else if (key == "subcarrier_count") {
+      field = kSubcarriers;
+    } else if (key == "data_re") {
+      field = kDataRe;
+    } else if (key == "data_im") {
+      field = kDataIm;
+    }
+    if (field == 0 || (seen & field) != 0) {
+      continue;
+    }
+    seen |= field;
+
+    switch (field) {
+    case kTimestamp:
+      numeric_ok &= ParseToken(p, end, ",}", frame.timestamp_ns);
+      break;
+    case kCenterFreq:
+      numeric_ok &= ParseToken(p, end, ",}", frame.center_freq_hz);
+      break;
+    case kRx:
+      numeric_ok &= ParseToken(p, end, ",}", rx);
+      break;
+    case kTx:
+      numeric_ok &= ParseToken(p, end, ",}", tx);
+      break;
+    case kSubcarriers:
+      numeric_ok &= ParseToken(p, end, ",}", subcarriers);
+      break;
+    default: {
+      while (p < end && IsSpace(*p)) {
+        ++p;
+      }
+      if (p == end || *p != '[') {
+        seen &= ~field; // no array here
+        break;
+      }
+      ++p;
+      if ((seen & kNumeric) == kNumeric && numeric_ok) {
+        ReserveSamples(frame.data,
+                       static_cast<std::size_t>(static_cast<std::uint8_t>(rx)) *
+                           static_cast<std::uint8_t>(tx) * static_cast<std::uint16_t>(subcarriers),
+                       line.size());
+      }
+      const std::size_t count =
+          bad_token ? 0
+                    : ParseFloatList(p, end, ',', ']', field == kDataRe ? Part::kReal : Part::kImag,
+                                     frame.data, bad_token);
+      p = SkipToAny(p, end, "]");
+      if (p == end) {
+        seen &= ~field; // unterminated array
+        break;
+      }
+      ++p;
+      (field == kDataRe ? re_count : im_count) = count;
+      break;
+    }
+    }
   }
 
-  std::vector<float> re;
-  std::vector<float> im;
-  if (!array("data_re").has_value() || !array("data_im").has_value()) {
+  if ((seen & kNumeric) != kNumeric || !numeric_ok) {
+    return {.corrupt = true, .error = "JSONL numeric parse failure"};
+  }
+  if ((seen & (kDataRe | kDataIm)) != (kDataRe | kDataIm)) {
     return {.corrupt = true, .error = "JSONL missing arrays"};
   }
-  if (!ParseFloatList(*array("data_re"), ',', re) || !ParseFloatList(*array("data_im"), ',', im)) {
+  frame.rx_count = static_cast<std::uint8_t>(rx);
+  frame.tx_count = static_cast<std::uint8_t>(tx);
+  frame.subcarrier_count = static_cast<std::uint16_t>(subcarriers);
+  if (bad_token) {
     return {.corrupt = true, .error = "JSONL array parse failure"};
   }
-
   const std::size_t expected =
       static_cast<std::size_t>(frame.rx_count) * frame.tx_count * frame.subcarrier_count;
-  if (re.size() != expected || im.size() != expected) {
+  if (re_count != expected || im_count != expected) {
     return {.corrupt = true, .error = "JSONL data length mismatch"};
   }
-  frame.data.reserve(expected);
-  for (std::size_t i = 0; i < expected; ++i) {
-    frame.data.emplace_back(re[i], im[i]);
-  }
-  return {.frame = std::move(frame)};
+  return {};
 }
 
 } // namespace aethersense::io
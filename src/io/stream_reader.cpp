@@ -1,12 +1,16 @@
 #include "aethersense/io/stream_reader.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <filesystem>
+#include <cstring>
 #include <fstream>
 #include <thread>
 
+#include "aethersense/io/checkpoint.hpp"
+#include "aethersense/io/inotify_stream_reader.hpp"
+#include "aethersense/io/mapped_file.hpp"
+
 namespace aethersense::io {
-namespace fs = std::filesystem;
 
 class FileStreamReader final : public IStreamReader {
 public:
@@ -14,14 +18,10 @@ public:
 
   Result<bool> open(const std::string &path) override {
     path_ = path;
-    in_.close();
-    in_.open(path_, std::ios::in);
-    if (!in_) {
-      return Error{ErrorCode::kIoError, "failed to open stream: " + path_};
+    auto opened = OpenFile();
+    if (!opened.ok()) {
+      return opened;
     }
-    partial_.clear();
-    offset_ = 0;
-    signature_ = Signature(path_);
     ResumeIfCheckpointed();
     return true;
   }
@@ -30,20 +30,20 @@ public:
     if (!in_) {
       return Error{ErrorCode::kIoError, "stream not opened"};
     }
-    DetectRotate();
 
-    std::string line;
-    if (std::getline(in_, line)) {
-      offset_ = static_cast<std::uint64_t>(in_.tellg());
+    // line_ is reused across records, so a steady stream of similar lines does not allocate.
+    if (std::getline(in_, line_)) {
+      // tellg() fails once a final line without '\n' has set eofbit.
+      offset_ += line_.size() + (in_.eof() ? 0 : 1);
       if (!partial_.empty()) {
-        line = partial_ + line;
+        line_.insert(0, partial_);
         partial_.clear();
       }
       ++stats_.records_total;
       stats_.consecutive_errors_current = 0;
       checkpoint_timestamp_ = 0;
-      WriteCheckpoint();
-      return StreamRecord{line, false};
+      checkpoint_.Update({signature_, offset_, 0});
+      return StreamRecord{line_, false};
     }
 
     if (!in_.eof()) {
@@ -53,14 +53,22 @@ public:
 
     in_.clear();
     if (cfg_.mode == "tail") {
-      std::this_thread::sleep_for(std::chrono::milliseconds(cfg_.poll_interval_ms));
+      checkpoint_.FlushIfStale();
+      if (!cfg_.tail_nonblocking) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(cfg_.poll_interval_ms));
+      }
       DetectRotate();
       return StreamRecord{"", false};
     }
+    checkpoint_.Flush();
     return StreamRecord{"", true};
   }
 
-  StreamStats stats() const override { return stats_; }
+  StreamStats stats() const override {
+    StreamStats stats = stats_;
+    stats.checkpoint_writes_total = checkpoint_.writes_total();
+    return stats;
+  }
   std::uint64_t last_timestamp_ns() const override { return checkpoint_timestamp_; }
 
   void OnCorrupt() {
@@ -79,16 +87,21 @@ public:
 
   void SetTimestamp(std::uint64_t ts) {
     checkpoint_timestamp_ = ts;
-    WriteCheckpoint();
+    checkpoint_.Update({signature_, offset_, checkpoint_timestamp_}, 0);
   }
 
 private:
-  std::string Signature(const std::string &p) {
-    if (!fs::exists(p))
-      return {};
-    auto s = fs::status(p);
-    auto fsz = fs::file_size(p);
-    return std::to_string(static_cast<int>(s.type())) + ":" + std::to_string(fsz);
+  Result<bool> OpenFile() {
+    in_.close();
+    in_.open(path_, std::ios::in);
+    if (!in_) {
+      return Error{ErrorCode::kIoError, "failed to open stream: " + path_};
+    }
+    partial_.clear();
+    offset_ = 0;
+    signature_ = FileSignature(path_);
+    identity_ = StatFile(path_).value_or(FileIdentity{});
+    return true;
   }
 
   void ResumeIfCheckpointed() {
@@ -97,48 +110,132 @@ private:
       offset_ = static_cast<std::uint64_t>(in_.tellg());
       return;
     }
-    std::ifstream ck(cfg_.checkpoint_path);
-    if (!ck || cfg_.start_position != "checkpoint")
+    if (cfg_.start_position == "offset") {
+      offset_ = cfg_.start_offset;
+      in_.seekg(static_cast<std::streamoff>(offset_), std::ios::beg);
+      return;
+    }
+    if (cfg_.start_position != "checkpoint")
       return;
-    std::string sig;
-    ck >> sig >> offset_ >> checkpoint_timestamp_;
-    if (sig == signature_) {
+    const auto ck = ReadCheckpoint(cfg_.checkpoint_path);
+    if (ck.has_value() && ck->signature == signature_) {
+      offset_ = ck->offset;
+      checkpoint_timestamp_ = ck->timestamp_ns;
       in_.seekg(static_cast<std::streamoff>(offset_), std::ios::beg);
       ++stats_.checkpoint_resume_total;
     }
   }
 
-  void WriteCheckpoint() {
-    std::ofstream ck(cfg_.checkpoint_path, std::ios::trunc);
-    if (!ck)
-      return;
-    ck << signature_ << ' ' << offset_ << ' ' << checkpoint_timestamp_;
-    ++stats_.checkpoint_writes_total;
-  }
-
+  // Checked at the end of the file while tailing: the path now names another file (rotation)
+  // or the file shrank below what has been read (truncation). A missing path keeps the open
+  // file until the new one appears. The replacement is read from its start.
   void DetectRotate() {
-    if (!fs::exists(path_))
+    const auto now = StatFile(path_);
+    if (!now.has_value() || (now->device == identity_.device && now->inode == identity_.inode &&
+                             now->size >= offset_)) {
       return;
-    const auto new_sig = Signature(path_);
-    if (new_sig != signature_) {
-      ++stats_.rotations_detected_total;
-      if (cfg_.rotate_handling == "reopen") {
-        open(path_);
-      }
+    }
+    ++stats_.rotations_detected_total;
+    checkpoint_.Flush();
+    if (cfg_.rotate_handling == "reopen") {
+      OpenFile();
     }
   }
 
   Config::Io cfg_;
   std::string path_;
   std::ifstream in_;
+  std::string line_;
   std::string partial_;
   std::uint64_t offset_{0};
   std::uint64_t checkpoint_timestamp_{0};
   std::string signature_;
+  FileIdentity identity_;
+  StreamStats stats_;
+  CheckpointWriter checkpoint_{cfg_};
+};
+
+// File-mode reader over a MappedFile: each record is a view of the mapping up to the next
+// '\n', found with memchr, so no line is copied. Checkpoints use the same format and signature
+// as FileStreamReader, so either reader can resume the other's checkpoint.
+class MmapStreamReader final : public IStreamReader {
+public:
+  explicit MmapStreamReader(const Config::Io &cfg) : cfg_(cfg) {}
+
+  Result<bool> open(const std::string &path) override {
+    auto mapped = file_.Open(path);
+    if (!mapped.ok()) {
+      return mapped.error();
+    }
+    offset_ = 0;
+    signature_ = FileSignature(path);
+    ResumeIfCheckpointed();
+    return true;
+  }
+
+  Result<StreamRecord> read_next() override {
+    if (!file_.is_open()) {
+      return Error{ErrorCode::kIoError, "stream not opened"};
+    }
+    const std::size_t size = file_.size();
+    if (offset_ >= size) {
+      checkpoint_.Flush();
+      return StreamRecord{{}, true};
+    }
+    const char *begin = file_.data() + offset_;
+    const auto *nl = static_cast<const char *>(std::memchr(begin, '\n', size - offset_));
+    const std::size_t len = nl != nullptr ? static_cast<std::size_t>(nl - begin) : size - offset_;
+    offset_ += nl != nullptr ? len + 1 : len;
+    ++stats_.records_total;
+    stats_.consecutive_errors_current = 0;
+    checkpoint_.Update({signature_, offset_, 0});
+    return StreamRecord{std::string_view(begin, len), false};
+  }
+
+  StreamStats stats() const override {
+    StreamStats stats = stats_;
+    stats.checkpoint_writes_total = checkpoint_.writes_total();
+    return stats;
+  }
+  std::uint64_t last_timestamp_ns() const override { return 0; }
+
+private:
+  void ResumeIfCheckpointed() {
+    if (cfg_.start_position == "end") {
+      offset_ = file_.size();
+      return;
+    }
+    if (cfg_.start_position == "offset") {
+      offset_ = std::min<std::uint64_t>(cfg_.start_offset, file_.size());
+      return;
+    }
+    if (cfg_.start_position != "checkpoint")
+      return;
+    const auto ck = ReadCheckpoint(cfg_.checkpoint_path);
+    if (ck.has_value() && ck->signature == signature_) {
+      offset_ = std::min<std::uint64_t>(ck->offset, file_.size());
+      ++stats_.checkpoint_resume_total;
+    }
+  }
+
+  Config::Io cfg_;
+  MappedFile file_;
+  std::uint64_t offset_{0};
+  std::string signature_;
   StreamStats stats_;
+  CheckpointWriter checkpoint_{cfg_};
 };
 
 Result<std::unique_ptr<IStreamReader>> CreateStreamReader(const Config::Io &cfg) {
+  if (cfg.reader == "mmap" || (cfg.reader == "auto" && cfg.mode == "file")) {
+    return std::unique_ptr<IStreamReader>(new MmapStreamReader(cfg));
+  }
+  if (cfg.mode == "tail" && (cfg.reader == "inotify" || cfg.reader == "auto")) {
+    auto watched = CreateInotifyStreamReader(cfg);
+    if (watched.ok() || cfg.reader == "inotify") {
+      return watched;
+    }
+  }
   return std::unique_ptr<IStreamReader>(new FileStreamReader(cfg));
 }
 
@@ -0,0 +1,121 @@
+#include "aethersense/runtime/multi_stream.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#include "aethersense/runtime/thread_pool.hpp"
+
+namespace aethersense {
+namespace {
+
+enum class StepOutcome { kMore, kIdle, kDone, kFailed };
+
+// Processes up to max_batch_frames frames of one stream.
+StepOutcome Step(StreamState &s, std::size_t index,
+                 const MultiStreamRunner::DecisionSink &sink) {
+  const std::size_t batch = std::max<std::size_t>(s.config.runtime.max_batch_frames, 1);
+  for (std::size_t n = 0; n < batch; ++n) {
+    auto got = s.reader->next_into(s.frame);
+    if (!got.ok()) {
+      s.error = Error{got.error().code, "Read error: " + got.error().message};
+      return StepOutcome::kFailed;
+    }
+    if (!got.value()) {
+      return s.config.io.mode == "tail" ? StepOutcome::kIdle : StepOutcome::kDone;
+    }
+
+    ++s.metrics.frames_read_total;
+    auto decision = s.pipeline.ProcessFrame(s.frame, s.metrics);
+    if (!decision.ok()) {
+      s.error = Error{decision.error().code, "Pipeline error: " + decision.error().message};
+      return StepOutcome::kFailed;
+    }
+    if (decision.value().has_value()) {
+      ++s.decisions_total;
+      s.energy_sum += decision.value()->energy_motion;
+      if (decision.value()->present) {
+        ++s.present_total;
+      }
+      if (sink) {
+        sink(index, *decision.value());
+      }
+    }
+  }
+  return StepOutcome::kMore;
+}
+
+} // namespace
+
+Result<std::size_t> MultiStreamRunner::AddStream(const Config &cfg) {
+  // Run() rechecks idle tail streams itself, so their readers must not wait for input.
+  auto io = cfg.io;
+  io.tail_nonblocking = true;
+  auto reader = CreateReader(io, cfg.io.path);
+  if (!reader.ok()) {
+    return reader.error();
+  }
+  return AddStream(cfg, std::move(reader.value()));
+}
+
+std::size_t MultiStreamRunner::AddStream(const Config &cfg, std::unique_ptr<ICsiReader> reader) {
+  streams_.push_back(std::make_unique<StreamState>(cfg, std::move(reader)));
+  return streams_.size() - 1;
+}
+
+Result<bool> MultiStreamRunner::Run(std::size_t worker_threads, const DecisionSink &sink) {
+  {
+    WorkStealingPool pool(worker_threads);
+    // Tail streams without new data wait here rather than on a worker; this thread requeues them
+    // every io.poll_interval_ms (the smallest over the streams).
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::size_t> idle;
+    std::size_t running = streams_.size();
+    int interval_ms = std::numeric_limits<int>::max();
+    for (const auto &s : streams_) {
+      interval_ms = std::min(interval_ms, s->config.io.poll_interval_ms);
+    }
+
+    std::function<void(std::size_t)> drive = [&](std::size_t index) {
+      const StepOutcome outcome = Step(*streams_[index], index, sink);
+      if (outcome == StepOutcome::kMore) {
+        // Behind the other streams queued on this worker, so that every stream gets its turn.
+        pool.Yield([&drive, index] { drive(index); });
+        return;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (outcome == StepOutcome::kIdle) {
+        idle.push_back(index);
+      } else if (--running == 0) {
+        cv.notify_all();
+      }
+    };
+    for (std::size_t i = 0; i < streams_.size(); ++i) {
+      pool.Submit([&drive, i] { drive(i); });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running > 0) {
+      cv.wait_for(lock, std::chrono::milliseconds(interval_ms), [&] { return running == 0; });
+      for (const std::size_t index : idle) {
+        pool.Submit([&drive, index] { drive(index); });
+      }
+      idle.clear();
+    }
+    lock.unlock();
+    pool.Wait();
+  }
+
+  for (const auto &s : streams_) {
+    if (s->error.has_value()) {
+      return *s->error;
+    }
+  }
+  return true;
+}
+
+} // namespace aethersense
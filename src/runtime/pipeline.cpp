@@ -3,157 +3,373 @@
 #include <algorithm>
 #include <chrono>
 #include <complex>
-#include <numeric>
+#include <span>
+#include <string>
 
 #include "aethersense/core/types.hpp"
 #include "aethersense/dsp/calibration.hpp"
+#include "aethersense/dsp/fft_plan.hpp"
 #include "aethersense/dsp/filters.hpp"
 #include "aethersense/dsp/outlier.hpp"
 #include "aethersense/dsp/resampler.hpp"
+#include "aethersense/dsp/simd.hpp"
+#include "aethersense/dsp/sliding_dft.hpp"
+#include "aethersense/dsp/timing_tracker.hpp"
+#include "aethersense/dsp/variance_tracker.hpp"
 #include "aethersense/dsp/window.hpp"
 
 namespace aethersense {
 
 namespace {
 
-Pipeline::FrameSignals ComputeSignals(const CsiFrame &frame) {
-  Pipeline::FrameSignals out;
+// Per-frame ingest: amplitude and phase per channel, with the common phase error removed so
+// the window caches corrected phase for every later hop. Averaged mode has one channel per
+// subcarrier (link-averaged magnitude, phase of the link sum); per-link mode has one channel per
+// (link, subcarrier), link-major, and removes each link's own CPE.
+void ComputeSignals(const FrameView &frame, bool per_link, Pipeline::FrameSignals &out,
+                    std::vector<float> &scratch) {
+  const std::size_t links = static_cast<std::size_t>(frame.rx_count) * frame.tx_count;
+  const std::size_t subcarriers = frame.subcarrier_count;
+  const std::size_t channels = per_link ? links * subcarriers : subcarriers;
   out.timestamp_ns = frame.timestamp_ns;
-  out.amplitude_by_sc.resize(frame.subcarrier_count, 0.0F);
-  out.phase_by_sc.resize(frame.subcarrier_count, 0.0F);
+  out.amplitude_by_sc.resize(channels);
+  out.phase_by_sc.resize(channels);
+  if (!per_link) {
+    dsp::simd::LinkMagnitudePhase(frame.data.data(), links, subcarriers,
+                                  out.amplitude_by_sc.data(), out.phase_by_sc.data());
+    dsp::RemoveFrameCommonPhaseError(out.phase_by_sc, scratch);
+    return;
+  }
+  // The link-major frame is a single "link" of links * subcarriers values to the kernel.
+  dsp::simd::LinkMagnitudePhase(frame.data.data(), 1, channels, out.amplitude_by_sc.data(),
+                                out.phase_by_sc.data());
+  for (std::size_t link = 0; link < links; ++link) {
+    dsp::RemoveFrameCommonPhaseError(
+        std::span<float>(out.phase_by_sc).subspan(link * subcarriers, subcarriers), scratch);
+  }
+}
 
-  const std::size_t links = static_cast<std::size_t>(frame.rx_count) * frame.tx_count;
-  for (std::uint16_t sc = 0; sc < frame.subcarrier_count; ++sc) {
-    float amp_sum = 0.0F;
-    std::complex<float> complex_sum(0.0F, 0.0F);
-    for (std::uint8_t rx = 0; rx < frame.rx_count; ++rx) {
-      for (std::uint8_t tx = 0; tx < frame.tx_count; ++tx) {
-        const auto idx = FlatIndex(rx, tx, sc, frame.tx_count, frame.subcarrier_count);
-        const auto sample = frame.data[idx];
-        amp_sum += std::abs(sample);
-        complex_sum += sample;
-      }
+// Re-deriving the running variance sums from the window bounds their rounding drift.
+constexpr std::size_t kVarianceRebuildInterval = 4096;
+
+// Top-k channels by variance within each of `groups` equal, contiguous channel ranges (one per
+// link in per-link mode); the result lists each group's picks in order, highest first.
+void SelectTopKByAmplitudeVariance(const dsp::VarianceTracker &variance, std::size_t groups,
+                                   std::size_t k,
+                                   std::vector<std::pair<float, std::size_t>> &variance_index) {
+  variance_index.clear();
+  const std::size_t per_group = variance.channels() / groups;
+  k = std::min(k, per_group);
+  const auto by_variance = [](const auto &a, const auto &b) { return a.first > b.first; };
+  for (std::size_t g = 0; g < groups; ++g) {
+    const std::size_t base = variance_index.size();
+    for (std::size_t ch = g * per_group; ch < (g + 1) * per_group; ++ch) {
+      variance_index.push_back({variance.variance(ch), ch});
+    }
+    const auto first = variance_index.begin() + static_cast<std::ptrdiff_t>(base);
+    const auto kth = first + static_cast<std::ptrdiff_t>(k);
+    std::nth_element(first, kth, variance_index.end(), by_variance);
+    variance_index.resize(base + k);
+    std::sort(variance_index.begin() + static_cast<std::ptrdiff_t>(base), variance_index.end(),
+              by_variance);
+  }
+}
+
+// dsp.link_fusion over the per-link band energies; reorders `energies`.
+float FuseLinkEnergies(std::span<float> energies, const std::string &fusion) {
+  if (energies.size() == 1) {
+    return energies[0];
+  }
+  if (fusion == "median") {
+    return dsp::MedianInPlace(energies);
+  }
+  if (fusion == "mean") {
+    float sum = 0.0F;
+    for (float e : energies) {
+      sum += e;
     }
-    out.amplitude_by_sc[sc] = amp_sum / static_cast<float>(links);
-    out.phase_by_sc[sc] = std::atan2(complex_sum.imag(), complex_sum.real());
+    return sum / static_cast<float>(energies.size());
   }
-  return out;
+  return *std::max_element(energies.begin(), energies.end());
 }
 
 } // namespace
 
 Pipeline::Pipeline(const Config &config)
     : config_(config), decision_engine_(config.decision.threshold_on, config.decision.threshold_off,
-                                        config.decision.hold_frames) {
-  window_.reserve(config_.dsp.window_frames);
+                                        config.decision.hold_frames),
+      fft_plan_(config.dsp.window_frames, config.dsp.fft.zero_pad_pow2,
+                dsp::ParseWindowType(config.dsp.fft.window)) {
+  timestamps_.reserve(config_.dsp.window_frames);
+  if (config_.dsp.fft.engine == "sliding_dft") {
+    sliding_dft_ =
+        dsp::SlidingDft(config_.dsp.window_frames, fft_plan_.fft_len(),
+                        dsp::ParseWindowType(config_.dsp.fft.window), true,
+                        config_.dsp.smoothing.alpha);
+  }
 }
 
 Result<std::optional<Decision>> Pipeline::ProcessFrame(const CsiFrame &frame,
                                                        RuntimeMetrics &metrics) {
+  return ProcessFrame(MakeFrameView(frame), metrics);
+}
+
+Result<std::optional<Decision>> Pipeline::ProcessFrame(const FrameView &frame,
+                                                       RuntimeMetrics &metrics) {
   const auto start = std::chrono::steady_clock::now();
   if (frame.data.empty()) {
     return Error{ErrorCode::kInvalidArgument, "frame.data cannot be empty"};
   }
+  if (frame.data.size() <
+      static_cast<std::size_t>(frame.rx_count) * frame.tx_count * frame.subcarrier_count) {
+    return Error{ErrorCode::kInvalidArgument, "frame.data is smaller than rx*tx*subcarriers"};
+  }
 
+  const bool per_link = config_.dsp.link_mode == "per_link";
+  const std::size_t links =
+      per_link ? static_cast<std::size_t>(frame.rx_count) * frame.tx_count : 1;
+  const std::size_t channels = links * frame.subcarrier_count;
   if (window_.empty()) {
     metrics.shape_change_total = 0;
-  } else {
-    const auto &last = window_.back();
-    if (last.amplitude_by_sc.size() != frame.subcarrier_count) {
-      window_.clear();
-      ++metrics.shape_change_total;
-      return std::optional<Decision>{};
+    if (window_.channels() != channels || window_.capacity() != config_.dsp.window_frames) {
+      window_.Reset(config_.dsp.window_frames, channels);
     }
+    links_ = links;
+    variance_.Reset(channels);
+    timing_.Reset(config_.dsp.window_frames);
+    variance_index_.clear();
+    windows_until_reselect_ = 0;
+  } else if (window_.channels() != channels || links_ != links) {
+    window_.Clear();
+    frames_until_hop_ = 0;
+    sliding_selected_.clear();
+    ++metrics.shape_change_total;
+    return std::optional<Decision>{};
   }
 
-  if (window_.size() == config_.dsp.window_frames) {
-    window_.erase(window_.begin());
+  const bool sliding = config_.dsp.fft.engine == "sliding_dft";
+  ComputeSignals(frame, per_link, ingest_, scratch_);
+  if (sliding) {
+    UnwrapPhaseAtIngest();
+  }
+  if (window_.full()) {
+    evicted_.resize(window_.channels());
+    for (std::size_t sc = 0; sc < evicted_.size(); ++sc) {
+      evicted_[sc] = window_.amplitude(sc).older.front();
+    }
+    variance_.Replace(ingest_.amplitude_by_sc, evicted_);
+  } else {
+    variance_.Add(ingest_.amplitude_by_sc);
+  }
+  window_.Push(ingest_.timestamp_ns, ingest_.amplitude_by_sc, ingest_.phase_by_sc);
+  timing_.Push(ingest_.timestamp_ns);
+  if (++frames_since_variance_rebuild_ >= kVarianceRebuildInterval) {
+    frames_since_variance_rebuild_ = 0;
+    for (std::size_t sc = 0; sc < window_.channels(); ++sc) {
+      const auto row = window_.amplitude(sc);
+      variance_.Rebuild(sc, row.older, row.newer);
+    }
+  }
+  if (sliding && !sliding_selected_.empty()) {
+    PushSlidingSample();
   }
-  window_.push_back(ComputeSignals(frame));
   metrics.window_fill_ratio =
       static_cast<float>(window_.size()) / static_cast<float>(config_.dsp.window_frames);
 
-  if (window_.size() < config_.dsp.window_frames) {
+  if (!window_.full()) {
     return std::optional<Decision>{};
   }
-
-  std::vector<std::uint64_t> timestamps;
-  timestamps.reserve(window_.size());
-  for (const auto &f : window_) {
-    timestamps.push_back(f.timestamp_ns);
+  // Between hops frames are only ingested; the window chain runs once every hop_frames.
+  if (frames_until_hop_ > 0) {
+    --frames_until_hop_;
+    return std::optional<Decision>{};
   }
-  const float jitter_ratio = dsp::JitterMetric(timestamps);
-  if (jitter_ratio > config_.dsp.resampling.reject_jitter_ratio) {
+  frames_until_hop_ = std::max<std::size_t>(config_.dsp.hop_frames, 1) - 1;
+
+  if (timing_.jitter_ratio() > config_.dsp.resampling.reject_jitter_ratio) {
     ++metrics.windows_rejected_total;
     return std::optional<Decision>{};
   }
+  const std::uint64_t step_ns = timing_.median_interval_ns();
+  const float sample_rate = timing_.sample_rate_hz();
 
-  std::vector<std::vector<float>> amp_series(frame.subcarrier_count, std::vector<float>(window_.size()));
-  std::vector<std::vector<float>> phase_series(frame.subcarrier_count, std::vector<float>(window_.size()));
-  for (std::size_t t = 0; t < window_.size(); ++t) {
-    for (std::size_t sc = 0; sc < frame.subcarrier_count; ++sc) {
-      amp_series[sc][t] = window_[t].amplitude_by_sc[sc];
-      phase_series[sc][t] = window_[t].phase_by_sc[sc];
-    }
+  Decision decision;
+  decision.timestamp_ns = frame.timestamp_ns;
+  if (sliding) {
+    RunSlidingDftEngine(sample_rate, decision);
+  } else {
+    RunFftEngine(step_ns, sample_rate, decision);
   }
+  decision.present = decision_engine_.Update(decision.energy_motion);
 
-  dsp::RemoveCommonPhaseError(phase_series, true);
-  for (auto &series : phase_series) {
-    series = dsp::ResampleToUniformGrid(timestamps, series, config_.dsp.resampling.method);
+  const auto end = std::chrono::steady_clock::now();
+  metrics.AddProcessingTimeUs(
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+  ++metrics.frames_processed_total;
+
+  return std::optional<Decision>{decision};
+}
+
+void Pipeline::RunFftEngine(std::uint64_t step_ns, float sample_rate, Decision &out) {
+  const std::size_t frames = window_.size();
+  // Selection only looks at amplitudes, so phase conditioning runs on the chosen rows alone.
+  UpdateSelection();
+
+  const std::size_t rows = variance_index_.size();
+  phase_rows_.resize(rows * frames);
+  for (std::size_t i = 0; i < rows; ++i) {
+    window_.CopyPhase(variance_index_[i].second,
+                      std::span<float>(phase_rows_).subspan(i * frames, frames));
+  }
+  if (frames >= 2) {
+    // One bracket search for the window, then every selected row in a single pass.
+    timestamps_.resize(frames);
+    window_.CopyTimestamps(timestamps_);
+    resample_plan_.Build(timestamps_, step_ns, config_.dsp.resampling.method);
+    resampled_rows_.resize(phase_rows_.size());
+    resample_plan_.ApplyRows(phase_rows_, resampled_rows_);
+    phase_rows_.swap(resampled_rows_);
+  }
+
+  // Rows are grouped by link (a single group in averaged mode); each link averages its own
+  // selected rows into one series.
+  const std::size_t per_link = rows / links_;
+  aggregate_.assign(links_ * frames, 0.0F);
+  for (std::size_t i = 0; i < rows; ++i) {
+    const auto series = std::span<float>(phase_rows_).subspan(i * frames, frames);
     dsp::FilterOutliers(series, config_.dsp.outlier.method, config_.dsp.outlier.k,
-                        config_.dsp.outlier.window);
-    auto uw = dsp::UnwrapPhase(series);
-    dsp::RemoveLinearTrend(uw);
-    series = std::move(uw);
+                        config_.dsp.outlier.window, order_stats_);
+    dsp::UnwrapPhaseInPlace(series);
+    dsp::RemoveLinearTrend(series);
+    float *aggregate = aggregate_.data() + (i / per_link) * frames;
+    for (std::size_t t = 0; t < frames; ++t) {
+      aggregate[t] += series[t];
+    }
+  }
+  for (float &v : aggregate_) {
+    v /= static_cast<float>(per_link);
   }
 
-  const auto selected = dsp::TopKVariance(amp_series, config_.dsp.topk_subcarriers);
-  std::vector<float> aggregate(window_.size(), 0.0F);
-  for (std::size_t idx : selected) {
-    for (std::size_t t = 0; t < aggregate.size(); ++t) {
-      aggregate[t] += phase_series[idx][t];
+  smoothed_.resize(aggregate_.size());
+  for (std::size_t link = 0; link < links_; ++link) {
+    const auto series = std::span<const float>(aggregate_).subspan(link * frames, frames);
+    const auto smoothed = std::span<float>(smoothed_).subspan(link * frames, frames);
+    if (config_.dsp.smoothing.type == "median") {
+      dsp::MedianSmooth(series, config_.dsp.smoothing.kernel, smoothed, order_stats_);
+    } else {
+      std::copy(series.begin(), series.end(), smoothed.begin());
+      dsp::EmaSmoothInPlace(smoothed, config_.dsp.smoothing.alpha);
     }
+    fft_plan_.ApplyWindow(smoothed);
   }
-  for (float &v : aggregate) {
-    v /= static_cast<float>(selected.size());
+  // All links go through the FFT together.
+  fft_plan_.MagnitudeSpectra(smoothed_, links_, spectrum_);
+
+  const std::size_t bins = fft_plan_.fft_len() / 2;
+  const auto motion = fft_plan_.BandBins(sample_rate, config_.dsp.bands.motion.low_hz,
+                                         config_.dsp.bands.motion.high_hz);
+  link_energy_.resize(links_);
+  for (std::size_t link = 0; link < links_; ++link) {
+    link_energy_[link] =
+        dsp::BandEnergy(std::span<const float>(spectrum_).subspan(link * bins, bins), motion);
+  }
+  out.energy_motion = FuseLinkEnergies(link_energy_, config_.dsp.link_fusion);
+  if (config_.dsp.bands.breathing.enabled) {
+    const auto breathing = fft_plan_.BandBins(sample_rate, config_.dsp.bands.breathing.low_hz,
+                                              config_.dsp.bands.breathing.high_hz);
+    for (std::size_t link = 0; link < links_; ++link) {
+      link_energy_[link] = dsp::BandEnergy(
+          std::span<const float>(spectrum_).subspan(link * bins, bins), breathing);
+    }
+    out.energy_breathing = FuseLinkEnergies(link_energy_, config_.dsp.link_fusion);
   }
+}
 
-  std::vector<float> smoothed = aggregate;
-  if (config_.dsp.smoothing.type == "median") {
-    smoothed = dsp::MedianSmooth(aggregate, config_.dsp.smoothing.kernel);
-  } else {
-    smoothed = dsp::EmaSmooth(aggregate, config_.dsp.smoothing.alpha);
+void Pipeline::UnwrapPhaseAtIngest() {
+  auto &phase = ingest_.phase_by_sc;
+  constexpr float kPi = 3.14159265358979323846F;
+  constexpr float kTwoPi = 2.0F * kPi;
+  const bool first = window_.empty() || unwrap_last_.size() != phase.size();
+  unwrap_last_.resize(phase.size());
+  unwrap_sum_.resize(phase.size());
+  for (std::size_t sc = 0; sc < phase.size(); ++sc) {
+    const float wrapped = phase[sc];
+    if (first) {
+      unwrap_sum_[sc] = wrapped;
+    } else {
+      float delta = wrapped - unwrap_last_[sc];
+      if (delta > kPi) {
+        delta -= kTwoPi;
+      } else if (delta < -kPi) {
+        delta += kTwoPi;
+      }
+      unwrap_sum_[sc] += delta;
+    }
+    unwrap_last_[sc] = wrapped;
+    phase[sc] = static_cast<float>(unwrap_sum_[sc]);
   }
+}
 
-  std::vector<std::uint64_t> dtns;
-  for (std::size_t i = 1; i < timestamps.size(); ++i)
-    dtns.push_back(timestamps[i] - timestamps[i - 1]);
-  std::sort(dtns.begin(), dtns.end());
-  const float sample_rate = 1e9F / static_cast<float>(dtns[dtns.size() / 2]);
+void Pipeline::PushSlidingSample() {
+  float sample = 0.0F;
+  for (std::size_t sc : sliding_selected_) {
+    sample += ingest_.phase_by_sc[sc];
+  }
+  sample /= static_cast<float>(sliding_selected_.size());
+  sliding_dft_.Push(sample);
+}
 
-  dsp::ApplyWindow(smoothed, dsp::ParseWindowType(config_.dsp.fft.window));
-  const std::size_t fft_len =
-      config_.dsp.fft.zero_pad_pow2 ? dsp::NextPow2(smoothed.size()) : smoothed.size();
-  const auto spectrum = dsp::MagnitudeSpectrum(smoothed, config_.dsp.fft.zero_pad_pow2);
+void Pipeline::UpdateSelection() {
+  if (windows_until_reselect_ > 0 && !variance_index_.empty()) {
+    --windows_until_reselect_;
+    return;
+  }
+  windows_until_reselect_ = std::max<std::size_t>(config_.dsp.topk_reselect_every, 1) - 1;
+  SelectTopKByAmplitudeVariance(variance_, links_, config_.dsp.topk_subcarriers, variance_index_);
+}
 
-  const float energy_motion =
-      dsp::BandEnergy(spectrum, sample_rate, config_.dsp.bands.motion.low_hz,
-                      config_.dsp.bands.motion.high_hz, fft_len);
-  float energy_breathing = 0.0F;
-  if (config_.dsp.bands.breathing.enabled) {
-    energy_breathing = dsp::BandEnergy(spectrum, sample_rate, config_.dsp.bands.breathing.low_hz,
-                                       config_.dsp.bands.breathing.high_hz, fft_len);
+void Pipeline::RunSlidingDftEngine(float sample_rate, Decision &out) {
+  UpdateSelection();
+  selected_scratch_.clear();
+  for (const auto &[variance, idx] : variance_index_) {
+    selected_scratch_.push_back(idx);
   }
 
-  const bool present = decision_engine_.Update(energy_motion);
+  if (selected_scratch_ != sliding_selected_) {
+    // A new selection changes the sample stream, so rebuild its history from the window.
+    sliding_selected_ = selected_scratch_;
+    const std::size_t frames = window_.size();
+    scratch_.assign(frames, 0.0F);
+    row_scratch_.resize(frames);
+    for (std::size_t sc : sliding_selected_) {
+      window_.CopyPhase(sc, row_scratch_);
+      for (std::size_t t = 0; t < frames; ++t) {
+        scratch_[t] += row_scratch_[t];
+      }
+    }
+    for (float &v : scratch_) {
+      v /= static_cast<float>(sliding_selected_.size());
+    }
+    sliding_dft_.Reset(scratch_);
+  }
 
-  const auto end = std::chrono::steady_clock::now();
-  metrics.AddProcessingTimeUs(
-      std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
-  ++metrics.frames_processed_total;
+  const auto motion = fft_plan_.BandBins(sample_rate, config_.dsp.bands.motion.low_hz,
+                                         config_.dsp.bands.motion.high_hz);
+  dsp::BinRange breathing;
+  if (config_.dsp.bands.breathing.enabled) {
+    breathing = fft_plan_.BandBins(sample_rate, config_.dsp.bands.breathing.low_hz,
+                                   config_.dsp.bands.breathing.high_hz);
+  }
+  dsp::BinRange tracked = motion;
+  if (!breathing.empty()) {
+    tracked = motion.empty() ? breathing
+                             : dsp::BinRange{std::min(motion.first, breathing.first),
+                                             std::max(motion.last, breathing.last)};
+  }
+  sliding_dft_.Track(tracked);
 
-  return std::optional<Decision>{
-      Decision{frame.timestamp_ns, energy_motion, energy_breathing, present}};
+  out.energy_motion = sliding_dft_.BandEnergy(motion);
+  out.energy_breathing = sliding_dft_.BandEnergy(breathing);
 }
 
 } // namespace aethersense
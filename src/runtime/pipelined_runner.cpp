@@ -0,0 +1,173 @@
+#include "aethersense/runtime/pipelined_runner.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "aethersense/core/frame_pool.hpp"
+#include "aethersense/runtime/ring_buffer.hpp"
+#include "aethersense/runtime/spsc_ring_buffer.hpp"
+
+namespace aethersense {
+namespace {
+
+constexpr std::chrono::milliseconds kWaitSlice(100);
+
+// Frames in flight are bounded by the ring, the batch being processed and the one the reader
+// is filling; caching that many lets a warm reader always parse into a recycled buffer.
+std::size_t FramesInFlight(const Config &config) {
+  return std::bit_ceil(std::max<std::size_t>(config.runtime.ring_buffer_capacity_frames, 2)) +
+         std::max<std::size_t>(config.runtime.max_batch_frames, 1) + 1;
+}
+
+} // namespace
+
+PipelinedRunner::PipelinedRunner(const Config &config, std::unique_ptr<ICsiReader> reader)
+    : config_(config), reader_(std::move(reader)), pipeline_(config),
+      pool_(FramesInFlight(config)) {}
+
+io::StreamStats PipelinedRunner::stream_stats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
+}
+
+Result<bool> PipelinedRunner::Run(const DecisionSink &sink) {
+  read_error_.reset();
+  pipeline_error_.reset();
+  if (config_.io.mode == "file" && reader_->reads_in_place()) {
+    return RunInPlace(sink);
+  }
+  const std::size_t max_batch = std::max<std::size_t>(config_.runtime.max_batch_frames, 1);
+  SpscRingBuffer<PooledFrame> ring(config_.runtime.ring_buffer_capacity_frames);
+  const BackpressurePolicy policy = config_.io.mode == "tail"
+                                        ? ParseBackpressurePolicy(config_.runtime.backpressure)
+                                        : BackpressurePolicy::kBlock;
+  std::atomic<bool> stop{false};
+
+  std::thread reader_thread([&] {
+    // Reader stats are published once per max_batch frames and whenever the reader runs dry or
+    // fails, so the stats lock stays off the per-frame path.
+    std::size_t unpublished = 0;
+    const auto publish = [&] {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      stats_ = reader_->stream_stats();
+      unpublished = 0;
+    };
+    while (!stop.load(std::memory_order_relaxed)) {
+      PooledFrame item = pool_.Acquire();
+      auto got = reader_->next_into(*item);
+      if (!got.ok()) {
+        publish();
+        read_error_ = got.error();
+        break;
+      }
+      if (!got.value()) {
+        publish();
+        if (config_.io.mode == "tail") {
+          continue;
+        }
+        break;
+      }
+      if (++unpublished >= max_batch) {
+        publish();
+      }
+      frames_read_.fetch_add(1, std::memory_order_relaxed);
+      // A kBlock timeout only re-checks `stop`; the frame is retried, never dropped.
+      while (!ring.push(std::move(item), policy, kWaitSlice) && policy == BackpressurePolicy::kBlock &&
+             !stop.load(std::memory_order_relaxed) && !ring.closed()) {
+      }
+    }
+    if (unpublished > 0) {
+      publish();
+    }
+    ring.close();
+  });
+
+  std::vector<PooledFrame> batch;
+  batch.reserve(max_batch);
+  while (!pipeline_error_.has_value()) {
+    if (ring.pop_batch(batch, max_batch, kWaitSlice) == 0) {
+      if (ring.closed() && ring.size() == 0) {
+        break;
+      }
+      continue;
+    }
+    // Queue metrics are sampled once per batch: ring.size() reads the index the reader thread
+    // is writing, and once per batch keeps that cache line traffic off the per-frame path.
+    metrics_.frames_read_total = frames_read_.load(std::memory_order_relaxed);
+    metrics_.frames_dropped_total = ring.dropped();
+    metrics_.ring_buffer_depth = ring.size();
+    for (const auto &frame : batch) {
+      auto decision = pipeline_.ProcessFrame(*frame, metrics_);
+      if (!decision.ok()) {
+        pipeline_error_ = decision.error();
+        break;
+      }
+      if (decision.value().has_value() && sink) {
+        sink(*decision.value(), metrics_);
+      }
+    }
+  }
+
+  stop.store(true, std::memory_order_relaxed);
+  ring.close();
+  reader_thread.join();
+  metrics_.frames_read_total = frames_read_.load(std::memory_order_relaxed);
+  metrics_.frames_dropped_total = ring.dropped();
+  metrics_.ring_buffer_depth = ring.size();
+
+  if (pipeline_error_.has_value()) {
+    return *pipeline_error_;
+  }
+  if (read_error_.has_value()) {
+    return *read_error_;
+  }
+  return true;
+}
+
+Result<bool> PipelinedRunner::RunInPlace(const DecisionSink &sink) {
+  const std::size_t max_batch = std::max<std::size_t>(config_.runtime.max_batch_frames, 1);
+  std::size_t unpublished = 0;
+  const auto publish = [&] {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = reader_->stream_stats();
+    unpublished = 0;
+  };
+  FrameView view;
+  while (true) {
+    auto got = reader_->next_view(view);
+    if (!got.ok()) {
+      read_error_ = got.error();
+      break;
+    }
+    if (!got.value()) {
+      break;
+    }
+    if (++unpublished >= max_batch) {
+      publish();
+    }
+    metrics_.frames_read_total = frames_read_.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto decision = pipeline_.ProcessFrame(view, metrics_);
+    if (!decision.ok()) {
+      pipeline_error_ = decision.error();
+      break;
+    }
+    if (decision.value().has_value() && sink) {
+      sink(*decision.value(), metrics_);
+    }
+  }
+  publish();
+
+  if (pipeline_error_.has_value()) {
+    return *pipeline_error_;
+  }
+  if (read_error_.has_value()) {
+    return *read_error_;
+  }
+  return true;
+}
+
+} // namespace aethersense
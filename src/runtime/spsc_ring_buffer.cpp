@@ -0,0 +1,48 @@
+#include "aethersense/runtime/spsc_ring_buffer.hpp"
+
+#include "aethersense/core/frame_pool.hpp"
+#include "aethersense/core/types.hpp"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace aethersense {
+namespace detail {
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+
+void FutexWait(std::atomic<std::uint32_t> &word, std::uint32_t expected,
+               std::chrono::nanoseconds timeout) {
+#if defined(__linux__)
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  timespec ts{};
+  ts.tv_sec = static_cast<time_t>(seconds.count());
+  ts.tv_nsec = static_cast<long>((timeout - seconds).count());
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, &ts,
+          nullptr, 0);
+#else
+  if (word.load(std::memory_order_acquire) == expected) {
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::microseconds(200)));
+  }
+#endif
+}
+
+void FutexWakeAll(std::atomic<std::uint32_t> &word) {
+#if defined(__linux__)
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE_PRIVATE, INT32_MAX,
+          nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+} // namespace detail
+
+template class SpscRingBuffer<CsiFrame>;
+template class SpscRingBuffer<PooledFrame>;
+
+} // namespace aethersense
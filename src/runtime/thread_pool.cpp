@@ -0,0 +1,116 @@
+#include "aethersense/runtime/thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace aethersense {
+namespace {
+
+// Pool and worker index of the current thread, so Submit() from a task stays local.
+thread_local const WorkStealingPool *t_pool = nullptr;
+thread_local std::size_t t_worker = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+    : thread_count_(threads == 0 ? std::max<std::size_t>(std::thread::hardware_concurrency(), 1)
+                                 : threads) {
+  queues_ = std::make_unique<Queue[]>(thread_count_);
+  workers_.reserve(thread_count_);
+  for (std::size_t i = 0; i < thread_count_; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkStealingPool::Submit(std::function<void()> task) { Push(std::move(task), false); }
+
+void WorkStealingPool::Yield(std::function<void()> task) { Push(std::move(task), true); }
+
+void WorkStealingPool::Push(std::function<void()> task, bool behind) {
+  const bool local = t_pool == this;
+  const std::size_t index =
+      local ? t_worker : next_queue_.fetch_add(1, std::memory_order_relaxed) % thread_count_;
+  // Count first so that a worker finishing the task early can never underflow the counters.
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    ++queued_;
+    ++pending_;
+  }
+  {
+    // The owner pops from the back, so the front is the end of its line (and the first to be
+    // stolen, which moves a yielding stream of work to an idle worker).
+    std::lock_guard<std::mutex> lock(queues_[index].mutex);
+    if (local && behind) {
+      queues_[index].tasks.push_front(std::move(task));
+    } else {
+      queues_[index].tasks.push_back(std::move(task));
+    }
+  }
+  work_cv_.notify_one();
+}
+
+void WorkStealingPool::Wait() {
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  idle_cv_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool WorkStealingPool::TryTake(std::size_t index, std::function<void()> &task) {
+  {
+    Queue &own = queues_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+  for (std::size_t offset = 1; offset < thread_count_; ++offset) {
+    Queue &victim = queues_[(index + offset) % thread_count_];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::WorkerLoop(std::size_t index) {
+  t_pool = this;
+  t_worker = index;
+  std::function<void()> task;
+  while (true) {
+    if (TryTake(index, task)) {
+      {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        --queued_;
+      }
+      task();
+      task = nullptr;
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      if (--pending_ == 0) {
+        idle_cv_.notify_all();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    work_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+    if (stop_ && queued_ == 0) {
+      return;
+    }
+  }
+}
+
+} // namespace aethersense
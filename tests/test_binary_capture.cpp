@@ -0,0 +1,272 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/io/csi_reader.hpp"
+#include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/pipeline.hpp"
+
+namespace {
+
+// 2x1 links of 3 subcarriers, 1 ns apart.
+constexpr testh::FrameSpec kCaptureSpec{.rx_count = 2,
+                                        .tx_count = 1,
+                                        .subcarrier_count = 3,
+                                        .center_freq_hz = 5800000000ULL,
+                                        .first_timestamp_ns = 1000,
+                                        .period_ns = 1};
+
+aethersense::CsiFrame MakeFrame(std::size_t i) { return testh::SyntheticFrame(kCaptureSpec, i); }
+
+void WriteCapture(const std::string &path, std::size_t frames) {
+  aethersense::io::BinaryCaptureWriter writer;
+  REQUIRE(writer.Open(path).ok());
+  for (std::size_t i = 0; i < frames; ++i) {
+    REQUIRE(writer.write(aethersense::MakeFrameView(MakeFrame(i))).ok());
+  }
+  REQUIRE(writer.close().ok());
+}
+
+std::vector<char> ReadBytes(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void WriteBytes(const std::string &path, const std::vector<char> &bytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+aethersense::Config::Io BinaryIo(const std::string &path) {
+  aethersense::Config::Io io;
+  io.format = "binary";
+  io.checkpoint_path = path + ".checkpoint";
+  return io;
+}
+
+// Timestamps of every frame the reader yields until the end of the capture.
+std::vector<std::uint64_t> ReadTimestamps(aethersense::io::BinaryCaptureReader &reader) {
+  std::vector<std::uint64_t> out;
+  aethersense::FrameView view;
+  while (true) {
+    auto got = reader.next_view(view);
+    REQUIRE(got.ok());
+    if (!got.value()) {
+      return out;
+    }
+    out.push_back(view.timestamp_ns);
+  }
+}
+
+} // namespace
+
+TEST_CASE(Binary_capture_crc32c_matches_reference_value) {
+  const std::string check = "123456789";
+  REQUIRE(aethersense::io::Crc32c(check.data(), check.size()) == 0xE3069283U);
+  // Continuing a CRC over a split buffer gives the same value as one call.
+  const auto head = aethersense::io::Crc32c(check.data(), 4);
+  REQUIRE(aethersense::io::Crc32c(check.data() + 4, 5, head) == 0xE3069283U);
+  REQUIRE(aethersense::io::BinaryRecordBytes(2, 1, 3) == 32 + 64);
+}
+
+TEST_CASE(Binary_capture_round_trips_frames_as_mapped_views) {
+  const std::string p = "binary_capture_roundtrip.bin";
+  WriteCapture(p, 5);
+
+  aethersense::io::BinaryCaptureReader reader(BinaryIo(p));
+  REQUIRE(reader.Open(p).ok());
+  REQUIRE(reader.header().rx_count == 2);
+  REQUIRE(reader.header().subcarrier_count == 3);
+  REQUIRE(reader.header().center_freq_hz == 5800000000ULL);
+  aethersense::FrameView view;
+  for (std::uint64_t i = 0; i < 5; ++i) {
+    REQUIRE(reader.next_view(view).value());
+    const auto expected = MakeFrame(i);
+    REQUIRE(view.timestamp_ns == expected.timestamp_ns);
+    REQUIRE(view.data.size() == expected.data.size());
+    for (std::size_t s = 0; s < expected.data.size(); ++s) {
+      REQUIRE(view.data[s] == expected.data[s]);
+    }
+    // The samples are read in place from the 32-byte aligned sample block.
+    REQUIRE(reinterpret_cast<std::uintptr_t>(view.data.data()) % 32 == 0);
+  }
+  REQUIRE(!reader.next_view(view).value());
+  REQUIRE(reader.stream_stats().records_total == 5);
+  REQUIRE(reader.stream_stats().records_corrupt_total == 0);
+
+  // Resuming from the checkpoint continues after the last frame read.
+  auto io = BinaryIo(p);
+  io.start_position = "checkpoint";
+  aethersense::io::BinaryCaptureReader resumed(io);
+  REQUIRE(resumed.Open(p).ok());
+  REQUIRE(resumed.stream_stats().checkpoint_resume_total == 1);
+  REQUIRE(ReadTimestamps(resumed).empty());
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
+
+TEST_CASE(Binary_capture_resyncs_after_corrupt_and_shifted_records) {
+  const std::string p = "binary_capture_corrupt.bin";
+  WriteCapture(p, 10);
+  auto bytes = ReadBytes(p);
+  const std::size_t record = aethersense::io::BinaryRecordBytes(2, 1, 3);
+  const auto at = [&](std::size_t r) { return aethersense::io::kBinaryHeaderBytes + r * record; };
+  bytes[at(2) + 40] ^= 0x10;                                          // flipped sample bit
+  bytes.insert(bytes.begin() + static_cast<std::ptrdiff_t>(at(5)), 7, '\x1D'); // stray bytes
+  bytes.resize(bytes.size() - 10);                                    // truncated last record
+  WriteBytes(p, bytes);
+
+  aethersense::io::BinaryCaptureReader reader(BinaryIo(p));
+  REQUIRE(reader.Open(p).ok());
+  const auto timestamps = ReadTimestamps(reader);
+  REQUIRE((timestamps == std::vector<std::uint64_t>{1000, 1001, 1003, 1004, 1005, 1006, 1007, 1008}));
+  REQUIRE(reader.stream_stats().records_corrupt_total == 2);
+  REQUIRE(reader.stream_stats().records_partial_total == 1);
+
+  // The records after the 7 stray bytes are misaligned in the mapping; their samples still come
+  // out aligned and intact.
+  aethersense::io::BinaryCaptureReader shifted(BinaryIo(p));
+  REQUIRE(shifted.Open(p).ok());
+  aethersense::FrameView view;
+  while (shifted.next_view(view).value()) {
+    const auto expected = MakeFrame(view.timestamp_ns - 1000).data;
+    REQUIRE(reinterpret_cast<std::uintptr_t>(view.data.data()) % alignof(std::complex<float>) == 0);
+    REQUIRE(std::equal(view.data.begin(), view.data.end(), expected.begin(), expected.end()));
+  }
+  std::filesystem::remove(p);
+  std::filesystem::remove(p + ".checkpoint");
+}
+
+TEST_CASE(Binary_capture_resumes_from_a_checkpoint_off_the_record_grid) {
+  const std::string p = "binary_capture_shifted_resume.bin";
+  WriteCapture(p, 8);
+  auto bytes = ReadBytes(p);
+  const std::size_t record = aethersense::io::BinaryRecordBytes(2, 1, 3);
+  const auto at = static_cast<std::ptrdiff_t>(aethersense::io::kBinaryHeaderBytes + 2 * record);
+  bytes.insert(bytes.begin() + at, 5, '\0'); // every record from frame 2 on is off the grid
+  WriteBytes(p, bytes);
+
+  auto io = BinaryIo(p);
+  io.checkpoint_every_records = 1;
+  {
+    aethersense::io::BinaryCaptureReader reader(io);
+    REQUIRE(reader.Open(p).ok());
+    aethersense::FrameView view;
+    for (int i = 0; i < 4; ++i) {
+      REQUIRE(reader.next_view(view).value());
+    }
+    REQUIRE(view.timestamp_ns == 1003);
+  }
+
+  io.start_position = "checkpoint";
+  aethersense::io::BinaryCaptureReader resumed(io);
+  REQUIRE(resumed.Open(p).ok());
+  REQUIRE(resumed.stream_stats().checkpoint_resume_total == 1);
+  REQUIRE((ReadTimestamps(resumed) == std::vector<std::uint64_t>{1004, 1005, 1006, 1007}));
+  REQUIRE(resumed.stream_stats().records_corrupt_total == 0);
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
+
+TEST_CASE(Binary_capture_rejects_bad_headers_and_shape_changes) {
+  const std::string p = "binary_capture_header.bin";
+  {
+    aethersense::io::BinaryCaptureWriter writer;
+    REQUIRE(writer.Open(p).ok());
+    REQUIRE(writer.write(aethersense::MakeFrameView(MakeFrame(0))).ok());
+    auto other = MakeFrame(1);
+    other.subcarrier_count = 2;
+    const auto written = writer.write(aethersense::MakeFrameView(other));
+    REQUIRE(!written.ok());
+    REQUIRE(written.error().code == aethersense::ErrorCode::kInvalidArgument);
+    REQUIRE(writer.frames_written() == 1);
+  }
+  {
+    // 255x255x65535 samples would need a record size the header's u32 cannot hold.
+    aethersense::io::BinaryCaptureWriter writer;
+    REQUIRE(writer.Open(p + ".wide").ok());
+    aethersense::FrameView wide;
+    wide.rx_count = 255;
+    wide.tx_count = 255;
+    wide.subcarrier_count = 65535;
+    const auto written = writer.write(wide);
+    REQUIRE(!written.ok());
+    REQUIRE(written.error().code == aethersense::ErrorCode::kInvalidArgument);
+    REQUIRE(writer.frames_written() == 0);
+  }
+  std::filesystem::remove(p + ".wide");
+
+  auto bytes = ReadBytes(p);
+  bytes[14] ^= 0x01; // subcarrier_count, covered by the header CRC
+  WriteBytes(p, bytes);
+  aethersense::io::BinaryCaptureReader corrupt(BinaryIo(p));
+  const auto opened = corrupt.Open(p);
+  REQUIRE(!opened.ok());
+  REQUIRE(opened.error().code == aethersense::ErrorCode::kParseError);
+
+  auto text = aethersense::CreateReader(BinaryIo(p), "../testdata/csi_small.csv");
+  REQUIRE(!text.ok());
+  REQUIRE(text.error().code == aethersense::ErrorCode::kUnsupportedFormat);
+  REQUIRE(!aethersense::CreateWriter("csv", p).ok());
+  std::filesystem::remove(p);
+}
+
+TEST_CASE(Binary_capture_replays_like_the_text_capture) {
+  const std::string p = "binary_capture_replay.bin";
+  auto text = aethersense::CreateReader(aethersense::Config::Io{.format = "csv"},
+                                        "../testdata/csi_small.csv");
+  REQUIRE(text.ok());
+  auto writer = aethersense::CreateWriter("binary", p);
+  REQUIRE(writer.ok());
+  std::vector<aethersense::CsiFrame> frames;
+  while (true) {
+    auto frame = text.value()->next();
+    REQUIRE(frame.ok());
+    if (!frame.value().has_value()) {
+      break;
+    }
+    REQUIRE(writer.value()->write(aethersense::MakeFrameView(*frame.value())).ok());
+    frames.push_back(*frame.value());
+  }
+  REQUIRE(writer.value()->close().ok());
+  std::filesystem::remove(".aethersense.checkpoint");
+
+  aethersense::Config cfg;
+  cfg.dsp.window_frames = 16;
+  cfg.decision.threshold_on = 1e-8F;
+  cfg.decision.threshold_off = 5e-9F;
+  aethersense::Pipeline from_text(cfg);
+  aethersense::Pipeline from_views(cfg);
+  aethersense::RuntimeMetrics text_metrics;
+  aethersense::RuntimeMetrics view_metrics;
+  aethersense::io::BinaryCaptureReader reader(BinaryIo(p));
+  REQUIRE(reader.Open(p).ok());
+  aethersense::FrameView view;
+  std::size_t decisions = 0;
+  for (const auto &frame : frames) {
+    REQUIRE(reader.next_view(view).value());
+    const auto expected = from_text.ProcessFrame(frame, text_metrics);
+    const auto got = from_views.ProcessFrame(view, view_metrics);
+    REQUIRE(expected.ok() && got.ok());
+    REQUIRE(expected.value().has_value() == got.value().has_value());
+    if (got.value().has_value()) {
+      REQUIRE(got.value()->timestamp_ns == expected.value()->timestamp_ns);
+      REQUIRE(got.value()->energy_motion == expected.value()->energy_motion);
+      ++decisions;
+    }
+  }
+  REQUIRE(!reader.next_view(view).value());
+  REQUIRE(decisions > 0);
+  std::filesystem::remove(p);
+  std::filesystem::remove(p + ".checkpoint");
+}
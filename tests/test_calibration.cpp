@@ -7,3 +7,15 @@ TEST_CASE(Calibration_removes_common_phase_error) {
   aethersense::dsp::RemoveCommonPhaseError(phase, true);
   REQUIRE(phase[0][0] < 0.1F);
 }
+
+TEST_CASE(Calibration_frame_cpe_matches_per_time_step_removal) {
+  std::vector<std::vector<float>> phase{{0.5F}, {-1.0F}, {2.0F}, {0.25F}};
+  std::vector<float> frame{0.5F, -1.0F, 2.0F, 0.25F};
+  std::vector<float> scratch;
+  aethersense::dsp::RemoveCommonPhaseError(phase, true);
+  const float cpe = aethersense::dsp::RemoveFrameCommonPhaseError(frame, scratch);
+  REQUIRE(cpe == 0.5F);
+  for (std::size_t sc = 0; sc < frame.size(); ++sc) {
+    REQUIRE(frame[sc] == phase[sc][0]);
+  }
+}
@@ -0,0 +1,150 @@
+#include "test_harness.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/io/capture_index.hpp"
+#include "aethersense/io/csi_reader.hpp"
+
+namespace {
+
+std::string CsvLine(std::uint64_t ts) {
+  return std::to_string(ts) + ",5800000000,1,1,2,0.5;0.25,0.125;1";
+}
+
+// Header, then frames stamped 1000, 1010, ... with a corrupt line after every 50th frame.
+void WriteCsv(const std::string &path, std::size_t frames) {
+  std::ofstream out(path);
+  out << "timestamp_ns,center_freq_hz,rx,tx,subcarrier_count,data_re,data_im\n";
+  for (std::size_t i = 0; i < frames; ++i) {
+    out << CsvLine(1000 + 10 * i) << "\n";
+    if (i % 50 == 49) {
+      out << "garbage\n";
+    }
+  }
+}
+
+// Timestamps of every frame `io` yields for `path`.
+std::vector<std::uint64_t> Replay(const aethersense::Config::Io &io, const std::string &path) {
+  auto reader = aethersense::CreateReader(io, path);
+  REQUIRE(reader.ok());
+  std::vector<std::uint64_t> out;
+  aethersense::CsiFrame frame;
+  while (true) {
+    auto got = reader.value()->next_into(frame);
+    REQUIRE(got.ok());
+    if (!got.value()) {
+      return out;
+    }
+    out.push_back(frame.timestamp_ns);
+  }
+}
+
+} // namespace
+
+TEST_CASE(Capture_index_points_at_every_stride_th_frame) {
+  const std::string p = "capture_index_stride.csv";
+  WriteCsv(p, 200);
+  aethersense::Config::Io io;
+  io.format = "csv";
+  const auto index = aethersense::io::BuildCaptureIndex(io, p, 16);
+  REQUIRE(index.ok());
+  REQUIRE(index.value().frames_total == 200);
+  REQUIRE(index.value().entries.size() == 13);
+
+  std::ifstream in(p);
+  for (const auto &entry : index.value().entries) {
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(entry.offset));
+    std::string line;
+    std::getline(in, line);
+    REQUIRE(line == CsvLine(1000 + 10 * entry.frames_before));
+    REQUIRE(entry.max_timestamp_before_ns ==
+            (entry.frames_before == 0 ? 0 : 1000 + 10 * (entry.frames_before - 1)));
+  }
+
+  REQUIRE(aethersense::io::WriteCaptureIndex(p + ".idx", index.value()).ok());
+  const auto read = aethersense::io::ReadCaptureIndex(p + ".idx");
+  REQUIRE(read.has_value());
+  REQUIRE(read->signature == index.value().signature);
+  REQUIRE(read->entries.size() == index.value().entries.size());
+  REQUIRE(read->entries.back().offset == index.value().entries.back().offset);
+  std::filesystem::remove(p);
+  std::filesystem::remove(p + ".idx");
+}
+
+TEST_CASE(Capture_index_seeks_one_warmup_window_before_the_range) {
+  const std::string p = "capture_index_seek.csv";
+  WriteCsv(p, 1000);
+  aethersense::Config::Io io;
+  io.format = "csv";
+  io.checkpoint_path = p + ".checkpoint";
+  for (const std::size_t threads : {1U, 2U}) {
+    auto ranged = io;
+    ranged.parse_threads = threads;
+    ranged.stop_timestamp_ns = 6005;
+    REQUIRE(aethersense::io::SeekToTimestamp(ranged, p, 5000, 32).ok());
+    REQUIRE(ranged.start_position == "offset");
+    const auto frames = Replay(ranged, p);
+    // At least 32 warm-up frames (and at most two index strides more), then 5000..6000.
+    std::size_t warmup = 0;
+    while (frames[warmup] < 5000) {
+      ++warmup;
+    }
+    REQUIRE(warmup >= 32 && warmup <= 32 + 2 * aethersense::io::kCaptureIndexStride);
+    REQUIRE(frames.size() == warmup + 101);
+    REQUIRE(frames.back() == 6000);
+  }
+  REQUIRE(std::filesystem::exists(p + ".idx"));
+
+  // A seek before the first frame starts at the first frame.
+  auto early = io;
+  REQUIRE(aethersense::io::SeekToTimestamp(early, p, 1, 32).ok());
+  REQUIRE(Replay(early, p).front() == 1000);
+
+  // Appending to the capture invalidates the sidecar; the next seek rebuilds it.
+  {
+    std::ofstream out(p, std::ios::app);
+    out << CsvLine(99999) << "\n";
+  }
+  REQUIRE(aethersense::io::LoadOrBuildCaptureIndex(io, p).value().frames_total == 1001);
+  std::filesystem::remove(p);
+  std::filesystem::remove(p + ".idx");
+  std::filesystem::remove(io.checkpoint_path);
+}
+
+TEST_CASE(Capture_index_handles_unordered_timestamps_and_binary_captures) {
+  const std::string p = "capture_index_unordered.bin";
+  {
+    aethersense::io::BinaryCaptureWriter writer;
+    REQUIRE(writer.Open(p).ok());
+    aethersense::CsiFrame frame;
+    frame.rx_count = 1;
+    frame.tx_count = 1;
+    frame.subcarrier_count = 2;
+    frame.data = {{1.0F, 0.0F}, {0.0F, 1.0F}};
+    for (std::uint64_t i = 0; i < 300; ++i) {
+      // Mostly increasing, with one late straggler stamped inside the later query range.
+      frame.timestamp_ns = i == 20 ? 2500 : 1000 + 10 * i;
+      REQUIRE(writer.write(aethersense::MakeFrameView(frame)).ok());
+    }
+  }
+  aethersense::Config::Io io;
+  io.format = "binary";
+  io.checkpoint_path = "";
+  auto index = aethersense::io::BuildCaptureIndex(io, p, 8);
+  REQUIRE(index.ok());
+  REQUIRE(index.value().frames_total == 300);
+  // Every entry after the straggler has seen 2500, so a seek to 2400 cannot skip it.
+  io.start_position = "offset";
+  io.start_offset = aethersense::io::SeekOffset(index.value(), 2400, 0);
+  const auto frames = Replay(io, p);
+  REQUIRE(frames.size() >= 280);
+  REQUIRE(frames[frames.size() - 280] == 2500);
+  std::filesystem::remove(p);
+}
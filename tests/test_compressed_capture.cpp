@@ -0,0 +1,257 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/io/capture_index.hpp"
+#include "aethersense/io/compressed_capture.hpp"
+#include "aethersense/io/csi_reader.hpp"
+#include "aethersense/io/csi_writer.hpp"
+
+namespace {
+
+// 2x1 links of 3 subcarriers whose phase drifts slowly, like a static channel, 10 ns apart.
+constexpr testh::FrameSpec kCaptureSpec{.rx_count = 2,
+                                        .tx_count = 1,
+                                        .subcarrier_count = 3,
+                                        .center_freq_hz = 5800000000ULL,
+                                        .first_timestamp_ns = 1000,
+                                        .period_ns = 10,
+                                        .rate_hz = 0.2F,
+                                        .time_step_s = 0.01F};
+
+aethersense::CsiFrame MakeFrame(std::size_t i) { return testh::SyntheticFrame(kCaptureSpec, i); }
+
+void WriteCapture(const std::string &path, const std::string &codec, std::size_t frames,
+                  std::size_t block_frames) {
+  auto writer = aethersense::CreateWriter("compressed", path, {codec, block_frames});
+  REQUIRE(writer.ok());
+  for (std::size_t i = 0; i < frames; ++i) {
+    REQUIRE(writer.value()->write(aethersense::MakeFrameView(MakeFrame(i))).ok());
+  }
+  REQUIRE(writer.value()->close().ok());
+  REQUIRE(writer.value()->frames_written() == frames);
+}
+
+std::vector<char> ReadBytes(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void WriteBytes(const std::string &path, const std::vector<char> &bytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+aethersense::Config::Io CompressedIo(const std::string &path) {
+  aethersense::Config::Io io;
+  io.format = "compressed";
+  io.checkpoint_path = path + ".checkpoint";
+  return io;
+}
+
+std::vector<aethersense::CsiFrame> ReadAll(const aethersense::Config::Io &io,
+                                           const std::string &path) {
+  auto reader = aethersense::CreateReader(io, path);
+  REQUIRE(reader.ok());
+  std::vector<aethersense::CsiFrame> out;
+  aethersense::CsiFrame frame;
+  while (true) {
+    auto got = reader.value()->next_into(frame);
+    REQUIRE(got.ok());
+    if (!got.value()) {
+      return out;
+    }
+    out.push_back(frame);
+  }
+}
+
+} // namespace
+
+TEST_CASE(Compressed_block_lossless_round_trip_is_bit_exact) {
+  std::vector<std::uint64_t> timestamps = {500, 400, 400, 900000000000ULL, 7};
+  std::vector<std::complex<float>> samples;
+  const float specials[] = {0.0F,
+                            -0.0F,
+                            std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(),
+                            std::numeric_limits<float>::quiet_NaN(),
+                            std::numeric_limits<float>::denorm_min(),
+                            1e30F,
+                            -3.5F};
+  for (std::size_t t = 0; t < timestamps.size(); ++t) {
+    for (std::size_t s = 0; s < 4; ++s) {
+      samples.emplace_back(specials[(t + s) % 8], specials[(t * 3 + s) % 8] + 0.0F);
+    }
+  }
+  std::vector<char> block;
+  aethersense::io::EncodeCsiBlock(aethersense::io::CsiCodec::kLossless, timestamps, samples,
+                                  block);
+  REQUIRE(aethersense::io::CheckCsiBlock(block.data(), block.size()) == block.size());
+
+  std::vector<std::uint64_t> ts;
+  std::vector<std::complex<float>> decoded;
+  REQUIRE(aethersense::io::DecodeCsiBlock(block.data(), 4, 5, ts, decoded));
+  REQUIRE(ts == timestamps);
+  REQUIRE(decoded.size() == samples.size());
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    REQUIRE(std::bit_cast<std::uint32_t>(decoded[i].real()) ==
+            std::bit_cast<std::uint32_t>(samples[i].real()));
+    REQUIRE(std::bit_cast<std::uint32_t>(decoded[i].imag()) ==
+            std::bit_cast<std::uint32_t>(samples[i].imag()));
+  }
+
+  // The wrong frame size, or any flipped byte, is caught rather than decoded.
+  REQUIRE(!aethersense::io::DecodeCsiBlock(block.data(), 3, 5, ts, decoded));
+  block[block.size() / 2] ^= 0x10;
+  REQUIRE(aethersense::io::CheckCsiBlock(block.data(), block.size()) == 0);
+}
+
+TEST_CASE(Compressed_block_frame_count_is_checked_before_decoding) {
+  std::vector<std::uint64_t> timestamps = {10, 20, 30};
+  std::vector<std::complex<float>> samples(3 * 4, {1.0F, -1.0F});
+  std::vector<char> block;
+  aethersense::io::EncodeCsiBlock(aethersense::io::CsiCodec::kLossless, timestamps, samples,
+                                  block);
+  std::vector<std::uint64_t> ts;
+  std::vector<std::complex<float>> decoded;
+  // More frames than the capture's block size.
+  REQUIRE(!aethersense::io::DecodeCsiBlock(block.data(), 4, 2, ts, decoded));
+
+  // A block whose CRC is valid but whose frame count is out of reach of its payload is
+  // rejected without sizing the outputs for it, even for the widest shape.
+  const auto reseal = [&block](std::uint16_t frames) {
+    std::memcpy(block.data() + 12, &frames, sizeof(frames));
+    const std::uint32_t crc = aethersense::io::Crc32c(block.data() + 8, block.size() - 8);
+    std::memcpy(block.data() + 4, &crc, sizeof(crc));
+    REQUIRE(aethersense::io::CheckCsiBlock(block.data(), block.size()) == block.size());
+  };
+  reseal(65535);
+  REQUIRE(!aethersense::io::DecodeCsiBlock(block.data(), 255 * 255 * 65535ULL, 65535, ts,
+                                           decoded));
+  REQUIRE(decoded.empty());
+  reseal(0);
+  REQUIRE(!aethersense::io::DecodeCsiBlock(block.data(), 4, 65535, ts, decoded));
+}
+
+TEST_CASE(Compressed_capture_round_trips_through_reader_and_writer) {
+  const std::string p = "compressed_round_trip.csi";
+  WriteCapture(p, "lossless", 150, 64);
+  const auto frames = ReadAll(CompressedIo(p), p);
+  REQUIRE(frames.size() == 150);
+  for (std::size_t i = 0; i < frames.size(); ++i) {
+    const auto expected = MakeFrame(i);
+    REQUIRE(frames[i].timestamp_ns == expected.timestamp_ns);
+    REQUIRE(frames[i].center_freq_hz == expected.center_freq_hz);
+    REQUIRE(frames[i].rx_count == 2 && frames[i].tx_count == 1);
+    REQUIRE(frames[i].data == expected.data);
+  }
+  // Slowly varying samples compress well below their float32 size.
+  REQUIRE(std::filesystem::file_size(p) < 150 * 6 * 8);
+
+  // A checkpoint is left at the end of the last block.
+  auto io = CompressedIo(p);
+  io.start_position = "checkpoint";
+  REQUIRE(ReadAll(io, p).empty());
+
+  // Shape changes and zero-frame blocks are rejected.
+  auto writer = aethersense::CreateWriter("compressed", p, {"lossless", 4});
+  REQUIRE(writer.ok());
+  REQUIRE(writer.value()->write(aethersense::MakeFrameView(MakeFrame(0))).ok());
+  auto other = MakeFrame(1);
+  other.subcarrier_count = 2;
+  REQUIRE(!writer.value()->write(aethersense::MakeFrameView(other)).ok());
+  REQUIRE(!aethersense::CreateWriter("compressed", p, {"lossless", 0}).ok());
+  REQUIRE(!aethersense::CreateWriter("compressed", p, {"float8", 4}).ok());
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
+
+TEST_CASE(Compressed_capture_int16_error_is_within_half_a_step) {
+  const std::string p = "compressed_int16.csi";
+  WriteCapture(p, "int16", 100, 32);
+  const auto frames = ReadAll(CompressedIo(p), p);
+  REQUIRE(frames.size() == 100);
+  // No sample is larger than 1.5 in magnitude, so a block's step is at most 1.5 / 32767.
+  const float half_step = 0.5F * 1.5F / 32767.0F + 1e-6F;
+  for (std::size_t i = 0; i < frames.size(); ++i) {
+    const auto expected = MakeFrame(i);
+    for (std::size_t s = 0; s < expected.data.size(); ++s) {
+      REQUIRE(std::fabs(frames[i].data[s].real() - expected.data[s].real()) <= half_step);
+      REQUIRE(std::fabs(frames[i].data[s].imag() - expected.data[s].imag()) <= half_step);
+    }
+  }
+  std::filesystem::remove(p);
+  std::filesystem::remove(p + ".checkpoint");
+}
+
+TEST_CASE(Compressed_capture_skips_corrupt_blocks_and_counts_partial_tail) {
+  const std::string p = "compressed_corrupt.csi";
+  WriteCapture(p, "lossless", 40, 10);
+  auto bytes = ReadBytes(p);
+  // Flip a byte inside the second block's payload and cut the last block short.
+  std::size_t second = aethersense::io::kCompressedHeaderBytes;
+  second += aethersense::io::CheckCsiBlock(bytes.data() + second, bytes.size() - second);
+  bytes[second + aethersense::io::kCsiBlockHeaderBytes + 3] ^= 0x40;
+  bytes.resize(bytes.size() - 5);
+  WriteBytes(p, bytes);
+
+  auto io = CompressedIo(p);
+  io.max_corrupt_ratio = 0.5F;
+  aethersense::io::CompressedCaptureReader reader(io);
+  REQUIRE(reader.Open(p).ok());
+  std::vector<std::uint64_t> timestamps;
+  aethersense::FrameView view;
+  while (true) {
+    auto got = reader.next_view(view);
+    REQUIRE(got.ok());
+    if (!got.value()) {
+      break;
+    }
+    timestamps.push_back(view.timestamp_ns);
+  }
+  // Blocks 0 and 2 survive; block 1 is corrupt and block 3 is truncated.
+  REQUIRE(timestamps.size() == 20);
+  REQUIRE(timestamps[9] == 1090 && timestamps[10] == 1200);
+  REQUIRE(reader.stream_stats().records_corrupt_total == 1);
+  REQUIRE(reader.stream_stats().records_partial_total == 1);
+  REQUIRE(reader.stream_stats().records_total == 20);
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
+
+TEST_CASE(Compressed_capture_seeks_through_the_index_at_block_boundaries) {
+  const std::string p = "compressed_seek.csi";
+  WriteCapture(p, "lossless", 1000, 100);
+  auto io = CompressedIo(p);
+  const auto index = aethersense::io::BuildCaptureIndex(io, p, 64);
+  REQUIRE(index.ok());
+  REQUIRE(index.value().frames_total == 1000);
+  // One entry per block, since blocks are longer than the stride.
+  REQUIRE(index.value().entries.size() == 10);
+  REQUIRE(index.value().entries[3].frames_before == 300);
+  REQUIRE(aethersense::io::WriteCaptureIndex(p + ".idx", index.value()).ok());
+  REQUIRE(aethersense::io::ReadCaptureIndex(p + ".idx").has_value());
+
+  io.stop_timestamp_ns = 6005;
+  REQUIRE(aethersense::io::SeekToTimestamp(io, p, 5000, 32).ok());
+  const auto frames = ReadAll(io, p);
+  // Frame 400 (ts 5000) needs 32 frames of warm-up, so replay starts at block 3.
+  REQUIRE(frames.front().timestamp_ns == 1000 + 10 * 300);
+  REQUIRE(frames.back().timestamp_ns == 6000);
+  std::filesystem::remove(p);
+  std::filesystem::remove(p + ".idx");
+  std::filesystem::remove(io.checkpoint_path);
+}
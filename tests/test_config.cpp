@@ -1,5 +1,8 @@
 #include "test_harness.hpp"
 
+#include <filesystem>
+#include <fstream>
+
 #include "aethersense/core/config.hpp"
 
 TEST_CASE(Config_v3_validates_nominal_values) {
@@ -14,6 +17,9 @@ TEST_CASE(Config_v3_validates_nominal_values) {
 
   const auto result = aethersense::ValidateConfig(cfg, false, 4);
   REQUIRE(result.ok());
+
+  cfg.io.start_position = "offset";
+  REQUIRE(aethersense::ValidateConfig(cfg, false, 4).ok());
 }
 
 TEST_CASE(Config_v3_rejects_invalid_values) {
@@ -33,6 +39,78 @@ TEST_CASE(Config_v3_rejects_invalid_values) {
   cfg.dsp.window_frames = 8;
   result = aethersense::ValidateConfig(cfg, false);
   REQUIRE(!result.ok());
+
+  cfg.dsp.window_frames = 16;
+  cfg.dsp.hop_frames = 17;
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.dsp.hop_frames = 1;
+  cfg.dsp.topk_reselect_every = 0;
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.dsp.topk_reselect_every = 1;
+  cfg.dsp.link_mode = "per_link";
+  cfg.dsp.fft.engine = "sliding_dft";
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.dsp.fft.engine = "fft";
+  cfg.dsp.link_fusion = "sum";
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.dsp.link_fusion = "max";
+  cfg.runtime.worker_threads = 4096;
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.runtime.worker_threads = 0;
+  cfg.io.mode = "tail";
+  cfg.io.reader = "mmap";
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.reader = "auto";
+  cfg.io.parse_threads = 4;
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.mode = "file";
+  cfg.io.parse_threads = 1;
+  cfg.io.reader = "inotify";
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.reader = "auto";
+  cfg.io.parse_threads = 4;
+  cfg.io.parse_chunk_bytes = 0;
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.parse_chunk_bytes = static_cast<std::size_t>(-1); // a negative value from the JSON
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.parse_chunk_bytes = (std::size_t{1} << 30U) + 1;
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.parse_chunk_bytes = 1U << 20U;
+  cfg.io.parse_threads = 1;
+  cfg.io.format = "xml";
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.format = "binary";
+  cfg.io.mode = "tail";
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
+
+  cfg.io.format = "compressed";
+  result = aethersense::ValidateConfig(cfg, false);
+  REQUIRE(!result.ok());
 }
 
 TEST_CASE(Load_config_v3_from_JSON) {
@@ -40,4 +118,21 @@ TEST_CASE(Load_config_v3_from_JSON) {
   REQUIRE(result.ok());
   REQUIRE(result.value().config_version == 3);
   REQUIRE(result.value().dsp.window_frames == 16);
+  REQUIRE(result.value().dsp.hop_frames == 1);
+  REQUIRE(result.value().dsp.topk_reselect_every == 1);
+  REQUIRE(result.value().dsp.link_mode == "averaged");
+  REQUIRE(result.value().dsp.link_fusion == "max");
+  REQUIRE(result.value().runtime.worker_threads == 0);
+  REQUIRE(result.value().io.reader == "auto");
+  REQUIRE(result.value().io.parse_threads == 1);
+  REQUIRE(result.value().io.parse_chunk_bytes == 1048576);
+}
+
+TEST_CASE(Load_config_rejects_a_negative_checkpoint_batch) {
+  const std::string p = "config_negative_checkpoint_batch.json";
+  std::ofstream(p) << "{\"config_version\": 3, \"io\": {\"checkpoint_every_records\": -1}}";
+  const auto result = aethersense::LoadConfigFromJsonFile(p);
+  REQUIRE(!result.ok());
+  REQUIRE(result.error().code == aethersense::ErrorCode::kInvalidConfig);
+  std::filesystem::remove(p);
 }
@@ -0,0 +1,72 @@
+#include "test_harness.hpp"
+
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "aethersense/dsp/fft_plan.hpp"
+#include "aethersense/dsp/filters.hpp"
+#include "aethersense/dsp/window.hpp"
+
+TEST_CASE(FftPlan_real_transform_matches_magnitude_spectrum) {
+  for (std::size_t n : {16U, 24U, 48U, 64U}) {
+    std::vector<float> x(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      x[i] = std::sin(0.37F * static_cast<float>(i)) + 0.25F * std::cos(1.9F * static_cast<float>(i)) +
+             0.01F * static_cast<float>(i);
+    }
+    aethersense::dsp::FftPlan plan(n, true, aethersense::dsp::WindowType::kHamming);
+    REQUIRE(plan.fft_len() == aethersense::dsp::NextPow2(n));
+
+    auto legacy = x;
+    aethersense::dsp::ApplyWindow(legacy, aethersense::dsp::WindowType::kHamming);
+    const auto expected = aethersense::dsp::MagnitudeSpectrum(legacy, true);
+
+    auto planned = x;
+    plan.ApplyWindow(planned);
+    std::vector<float> spectrum;
+    plan.MagnitudeSpectrum(planned, spectrum);
+    REQUIRE(spectrum.size() == expected.size());
+    for (std::size_t k = 0; k < spectrum.size(); ++k) {
+      REQUIRE_NEAR(spectrum[k], expected[k], 1e-4F * (1.0F + expected[k]));
+    }
+  }
+}
+
+TEST_CASE(FftPlan_batched_spectra_match_per_signal_spectra) {
+  for (std::size_t n : {16U, 24U}) {
+    for (bool pad : {true, false}) {
+      const std::size_t count = 9;
+      std::vector<float> signals(count * n);
+      for (std::size_t s = 0; s < count; ++s) {
+        for (std::size_t i = 0; i < n; ++i) {
+          signals[s * n + i] = std::sin(0.2F * static_cast<float>((s + 1) * i)) +
+                               0.1F * static_cast<float>(s);
+        }
+      }
+      aethersense::dsp::FftPlan plan(n, pad, aethersense::dsp::WindowType::kHann);
+      std::vector<float> batched;
+      plan.MagnitudeSpectra(signals, count, batched);
+      const std::size_t bins = plan.fft_len() / 2;
+      REQUIRE(batched.size() == count * bins);
+      std::vector<float> single;
+      for (std::size_t s = 0; s < count; ++s) {
+        plan.MagnitudeSpectrum(std::span<const float>(signals).subspan(s * n, n), single);
+        for (std::size_t k = 0; k < bins; ++k) {
+          REQUIRE(batched[s * bins + k] == single[k]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE(FftPlan_caches_band_bins_per_sample_rate) {
+  aethersense::dsp::FftPlan plan(32, true, aethersense::dsp::WindowType::kHann);
+  const auto a = plan.BandBins(16.0F, 1.5F, 2.5F);
+  const auto expected = aethersense::dsp::BandBins(16.0F, 1.5F, 2.5F, 32);
+  REQUIRE(a.first == expected.first && a.last == expected.last);
+  const auto b = plan.BandBins(8.0F, 1.5F, 2.5F);
+  const auto expected_b = aethersense::dsp::BandBins(8.0F, 1.5F, 2.5F, 32);
+  REQUIRE(b.first == expected_b.first && b.last == expected_b.last);
+  REQUIRE(b.first != a.first);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/core/errors.hpp"
+#include "aethersense/core/types.hpp"
+#include "aethersense/io/csi_reader.hpp"
+
+namespace testh {
+
+// Shape and signal of the frames SyntheticFrame() makes. Sample j of frame i is
+// polar(1 + 0.1 j, 0.3 j + sin(2 pi rate_hz t)) with t = i * time_step_s, so every sample
+// swings with the same slow, breathing-like phase modulation.
+struct FrameSpec {
+  std::uint8_t rx_count{1};
+  std::uint8_t tx_count{1};
+  std::uint16_t subcarrier_count{4};
+  std::uint64_t center_freq_hz{0};
+  std::uint64_t first_timestamp_ns{1000000000ULL};
+  std::uint64_t period_ns{50000000ULL};
+  float rate_hz{1.2F};
+  float time_step_s{0.05F};
+};
+
+inline aethersense::CsiFrame SyntheticFrame(const FrameSpec &spec, std::size_t i) {
+  aethersense::CsiFrame frame;
+  frame.timestamp_ns = spec.first_timestamp_ns + i * spec.period_ns;
+  frame.center_freq_hz = spec.center_freq_hz;
+  frame.rx_count = spec.rx_count;
+  frame.tx_count = spec.tx_count;
+  frame.subcarrier_count = spec.subcarrier_count;
+  const std::size_t samples =
+      static_cast<std::size_t>(spec.rx_count) * spec.tx_count * spec.subcarrier_count;
+  const float t = spec.time_step_s * static_cast<float>(i);
+  for (std::size_t j = 0; j < samples; ++j) {
+    const float angle = 0.3F * static_cast<float>(j) + std::sin(6.2831853F * spec.rate_hz * t);
+    frame.data.push_back(std::polar(1.0F + 0.1F * static_cast<float>(j), angle));
+  }
+  return frame;
+}
+
+// In-memory reader over `frames` SyntheticFrame()s, which then ends. Reading frame `fail_at`
+// fails instead (pass `frames` to fail after the last one), and frame `empty_at` carries no data
+// so that the pipeline rejects it.
+class SyntheticReader : public aethersense::ICsiReader {
+public:
+  SyntheticReader(FrameSpec spec, std::size_t frames, std::size_t fail_at = SIZE_MAX,
+                  std::size_t empty_at = SIZE_MAX)
+      : spec_(spec), frames_(frames), fail_at_(fail_at), empty_at_(empty_at) {}
+
+  aethersense::Result<std::optional<aethersense::CsiFrame>> next() override {
+    if (next_ == fail_at_) {
+      return aethersense::Error{aethersense::ErrorCode::kIoError, "synthetic failure"};
+    }
+    if (next_ == frames_) {
+      return std::optional<aethersense::CsiFrame>{};
+    }
+    auto frame = SyntheticFrame(spec_, next_);
+    if (next_++ == empty_at_) {
+      frame.data.clear();
+    }
+    return std::optional<aethersense::CsiFrame>{std::move(frame)};
+  }
+  aethersense::io::StreamStats stream_stats() const override {
+    aethersense::io::StreamStats stats;
+    stats.records_total = next_;
+    return stats;
+  }
+
+private:
+  FrameSpec spec_;
+  std::size_t frames_;
+  std::size_t fail_at_;
+  std::size_t empty_at_;
+  std::size_t next_{0};
+};
+
+// Small window and top-K so that decisions start after a few frames of SyntheticFrame() input.
+inline aethersense::Config SyntheticConfig(std::size_t max_batch_frames) {
+  aethersense::Config cfg;
+  cfg.dsp.window_frames = 16;
+  cfg.dsp.topk_subcarriers = 2;
+  cfg.runtime.max_batch_frames = max_batch_frames;
+  return cfg;
+}
+
+} // namespace testh
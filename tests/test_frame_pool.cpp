@@ -0,0 +1,104 @@
+#include "test_harness.hpp"
+
+#include <complex>
+#include <utility>
+#include <vector>
+
+#include "aethersense/core/frame_pool.hpp"
+#include "aethersense/io/csi_reader.hpp"
+#include "aethersense/io/record_recovery.hpp"
+
+TEST_CASE(Frame_pool_recycles_sample_buffers) {
+  aethersense::FramePool pool(4);
+  const std::complex<float> *buffer = nullptr;
+  {
+    auto frame = pool.Acquire();
+    REQUIRE(static_cast<bool>(frame));
+    frame->data.assign(64, {1.0F, 2.0F});
+    buffer = frame->data.data();
+  }
+  REQUIRE(pool.cached() == 1);
+  REQUIRE(pool.created_total() == 1);
+
+  auto frame = pool.Acquire();
+  REQUIRE(frame->data.empty());
+  REQUIRE(frame->data.capacity() >= 64);
+  frame->data.resize(64);
+  REQUIRE(frame->data.data() == buffer);
+  REQUIRE(pool.cached() == 0);
+  REQUIRE(pool.created_total() == 1);
+
+  aethersense::PooledFrame moved = std::move(frame);
+  REQUIRE(!static_cast<bool>(frame));
+  REQUIRE(static_cast<bool>(moved));
+  moved.Reset();
+  REQUIRE(!static_cast<bool>(moved));
+  REQUIRE(pool.cached() == 1);
+}
+
+TEST_CASE(Frame_pool_caps_idle_frames) {
+  aethersense::FramePool pool(2);
+  {
+    std::vector<aethersense::PooledFrame> frames;
+    for (int i = 0; i < 5; ++i) {
+      frames.push_back(pool.Acquire());
+    }
+    REQUIRE(pool.created_total() == 5);
+  }
+  REQUIRE(pool.cached() == 2);
+  auto a = pool.Acquire();
+  auto b = pool.Acquire();
+  auto c = pool.Acquire();
+  REQUIRE(pool.created_total() == 6);
+}
+
+TEST_CASE(Parse_into_reuses_frame_buffer) {
+  aethersense::CsiFrame frame;
+  auto first = aethersense::io::ParseCsvRecordInto("1,2,1,1,2,0.1;0.2,0.3;0.4", frame);
+  REQUIRE(!first.corrupt);
+  const auto *buffer = frame.data.data();
+  auto second = aethersense::io::ParseCsvRecordInto("5,6,1,1,2,1.5;2.5,-1;-2", frame);
+  REQUIRE(!second.corrupt);
+  REQUIRE(frame.data.data() == buffer);
+  REQUIRE(frame.timestamp_ns == 5);
+  REQUIRE(frame.data.size() == 2);
+  REQUIRE_NEAR(frame.data[1].real(), 2.5F, 1e-6F);
+  REQUIRE_NEAR(frame.data[1].imag(), -2.0F, 1e-6F);
+
+  auto bad = aethersense::io::ParseCsvRecordInto("5,6,1,1,2,1.5;x,-1;-2", frame);
+  REQUIRE(bad.corrupt);
+  REQUIRE(bad.error == "invalid float token");
+  auto short_im = aethersense::io::ParseJsonlRecordInto(
+      "{\"timestamp_ns\":1,\"center_freq_hz\":2,\"rx\":1,\"tx\":1,\"subcarrier_count\":2,"
+      "\"data_re\":[1,2],\"data_im\":[3]}",
+      frame);
+  REQUIRE(short_im.corrupt);
+  REQUIRE(short_im.error == "JSONL data length mismatch");
+}
+
+TEST_CASE(Reader_next_into_matches_next) {
+  const aethersense::Config::Io io{.format = "csv"};
+  auto by_value = aethersense::CreateReader(io, "../testdata/csi_small.csv");
+  auto in_place = aethersense::CreateReader(io, "../testdata/csi_small.csv");
+  REQUIRE(by_value.ok());
+  REQUIRE(in_place.ok());
+
+  aethersense::CsiFrame frame;
+  std::size_t frames = 0;
+  while (true) {
+    auto expected = by_value.value()->next();
+    auto got = in_place.value()->next_into(frame);
+    REQUIRE(expected.ok());
+    REQUIRE(got.ok());
+    REQUIRE(got.value() == expected.value().has_value());
+    if (!got.value()) {
+      break;
+    }
+    REQUIRE(frame.timestamp_ns == expected.value()->timestamp_ns);
+    REQUIRE(frame.data == expected.value()->data);
+    ++frames;
+  }
+  REQUIRE(frames > 0);
+  REQUIRE(in_place.value()->stream_stats().records_total ==
+          by_value.value()->stream_stats().records_total);
+}
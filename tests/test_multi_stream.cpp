@@ -0,0 +1,155 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/multi_stream.hpp"
+#include "aethersense/runtime/pipeline.hpp"
+
+namespace {
+
+// Stream s modulates at its own rate, so streams that got mixed up would not match.
+testh::FrameSpec StreamSpec(std::size_t stream) {
+  return {.rx_count = 1, .tx_count = 2, .subcarrier_count = 3,
+          .rate_hz = 0.5F + 0.4F * static_cast<float>(stream)};
+}
+
+// Tail reader that has no new data for `idle_polls` calls, then fails so the run can end.
+class IdleReader : public aethersense::ICsiReader {
+public:
+  explicit IdleReader(std::size_t idle_polls) : idle_polls_(idle_polls) {}
+
+  aethersense::Result<std::optional<aethersense::CsiFrame>> next() override {
+    if (polls_++ < idle_polls_) {
+      return std::optional<aethersense::CsiFrame>{};
+    }
+    return aethersense::Error{aethersense::ErrorCode::kIoError, "gave up waiting"};
+  }
+  aethersense::io::StreamStats stream_stats() const override { return {}; }
+
+  std::size_t polls() const { return polls_; }
+
+private:
+  std::size_t idle_polls_;
+  std::size_t polls_{0};
+};
+
+} // namespace
+
+TEST_CASE(MultiStreamRunner_matches_sequential_pipelines_per_stream) {
+  REQUIRE(alignof(aethersense::StreamState) >= 64);
+  const std::size_t streams = 6;
+  const auto cfg = testh::SyntheticConfig(4);
+
+  aethersense::MultiStreamRunner runner;
+  for (std::size_t s = 0; s < streams; ++s) {
+    runner.AddStream(cfg, std::make_unique<testh::SyntheticReader>(StreamSpec(s), 60 + 13 * s));
+  }
+  std::mutex mutex;
+  std::vector<std::vector<aethersense::Decision>> got(streams);
+  const auto result = runner.Run(3, [&](std::size_t stream, const aethersense::Decision &d) {
+    std::lock_guard<std::mutex> lock(mutex);
+    got[stream].push_back(d);
+  });
+  REQUIRE(result.ok());
+
+  for (std::size_t s = 0; s < streams; ++s) {
+    aethersense::Pipeline pipeline(cfg);
+    aethersense::RuntimeMetrics metrics;
+    std::vector<aethersense::Decision> expected;
+    for (std::size_t i = 0; i < 60 + 13 * s; ++i) {
+      auto decision = pipeline.ProcessFrame(testh::SyntheticFrame(StreamSpec(s), i), metrics);
+      REQUIRE(decision.ok());
+      if (decision.value().has_value()) {
+        expected.push_back(*decision.value());
+      }
+    }
+    REQUIRE(got[s].size() == expected.size());
+    REQUIRE(runner.stream(s).decisions_total == expected.size());
+    REQUIRE(runner.stream(s).metrics.frames_read_total == 60 + 13 * s);
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+      REQUIRE(got[s][k].timestamp_ns == expected[k].timestamp_ns);
+      REQUIRE(got[s][k].energy_motion == expected[k].energy_motion);
+      REQUIRE(got[s][k].present == expected[k].present);
+    }
+  }
+}
+
+TEST_CASE(MultiStreamRunner_isolates_a_failing_stream) {
+  const auto cfg = testh::SyntheticConfig(4);
+  aethersense::MultiStreamRunner runner;
+  runner.AddStream(cfg, std::make_unique<testh::SyntheticReader>(StreamSpec(0), 40));
+  runner.AddStream(cfg, std::make_unique<testh::SyntheticReader>(StreamSpec(1), 40, 25));
+  runner.AddStream(cfg, std::make_unique<testh::SyntheticReader>(StreamSpec(2), 40));
+
+  const auto result = runner.Run(2);
+  REQUIRE(!result.ok());
+  REQUIRE(runner.stream(1).error.has_value());
+  REQUIRE(runner.stream(1).metrics.frames_read_total == 25);
+  REQUIRE(!runner.stream(0).error.has_value());
+  REQUIRE(runner.stream(0).metrics.frames_read_total == 40);
+  REQUIRE(runner.stream(2).metrics.frames_read_total == 40);
+}
+
+TEST_CASE(MultiStreamRunner_gives_every_tail_stream_a_turn) {
+  // More endless-looking tail streams than workers: each must be served from the start, not
+  // after the streams ahead of it have run dry.
+  auto cfg = testh::SyntheticConfig(4);
+  cfg.io.mode = "tail";
+  const std::size_t streams = 6;
+  const std::size_t frames = 400;
+  aethersense::MultiStreamRunner runner;
+  for (std::size_t s = 0; s < streams; ++s) {
+    runner.AddStream(cfg, std::make_unique<testh::SyntheticReader>(StreamSpec(s), frames, frames));
+  }
+  std::mutex mutex;
+  std::vector<std::size_t> order;
+  const auto result = runner.Run(2, [&](std::size_t stream, const aethersense::Decision &) {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(stream);
+  });
+  REQUIRE(!result.ok()); // every reader fails after its last frame
+
+  std::vector<std::size_t> first(streams, order.size());
+  std::vector<std::size_t> seen(streams, 0);
+  std::size_t first_to_300 = order.size();
+  for (std::size_t k = 0; k < order.size(); ++k) {
+    first[order[k]] = std::min(first[order[k]], k);
+    if (++seen[order[k]] == 300) {
+      first_to_300 = std::min(first_to_300, k);
+    }
+  }
+  for (std::size_t s = 0; s < streams; ++s) {
+    REQUIRE(runner.stream(s).metrics.frames_read_total == frames);
+    REQUIRE(first[s] < first_to_300);
+  }
+}
+
+TEST_CASE(MultiStreamRunner_parks_idle_tail_streams_off_the_workers) {
+  auto cfg = testh::SyntheticConfig(4);
+  cfg.io.mode = "tail";
+  cfg.io.poll_interval_ms = 20;
+  aethersense::MultiStreamRunner runner;
+  auto idle = std::make_unique<IdleReader>(5);
+  const IdleReader &idle_reader = *idle;
+  runner.AddStream(cfg, std::move(idle));
+  runner.AddStream(cfg, std::make_unique<testh::SyntheticReader>(StreamSpec(1), 200, 200));
+
+  // One worker: the idle stream must hand it back rather than spin on it.
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = runner.Run(1);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  REQUIRE(!result.ok());
+  REQUIRE(runner.stream(1).metrics.frames_read_total == 200);
+  REQUIRE(idle_reader.polls() == 6);
+  // Each empty poll was retried a poll interval later, not straight away.
+  REQUIRE(elapsed >= std::chrono::milliseconds(5 * 20));
+  REQUIRE(runner.stream(0).error.has_value());
+}
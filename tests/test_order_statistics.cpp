@@ -0,0 +1,154 @@
+#include "test_harness.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "aethersense/dsp/filters.hpp"
+#include "aethersense/dsp/order_statistics.hpp"
+#include "aethersense/dsp/outlier.hpp"
+
+namespace {
+
+std::vector<float> NoisySeries(std::size_t n, std::uint32_t seed) {
+  std::vector<float> out(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    seed = seed * 1664525U + 1013904223U;
+    // Coarse quantization produces plenty of duplicate values.
+    out[i] = static_cast<float>((seed >> 20) % 16) * 0.25F + std::sin(0.1F * static_cast<float>(i));
+    if (i % 17 == 5) {
+      out[i] += 20.0F;
+    }
+  }
+  return out;
+}
+
+// The sort-per-sample filter the rolling version replaces.
+void ReferenceFilterOutliers(std::vector<float> &series, const std::string &method, float k,
+                             int window) {
+  const int half = window / 2;
+  for (int i = 0; i < static_cast<int>(series.size()); ++i) {
+    const int s = std::max(0, i - half);
+    const int e = std::min(static_cast<int>(series.size()), i + half + 1);
+    std::vector<float> local(series.begin() + s, series.begin() + e);
+    std::sort(local.begin(), local.end());
+    const float med = local[local.size() / 2];
+    std::vector<float> dev;
+    for (float v : local)
+      dev.push_back(std::fabs(v - med));
+    std::sort(dev.begin(), dev.end());
+    const float mad = std::max(1e-6F, dev[dev.size() / 2]);
+    if (std::fabs(series[i] - med) / mad > k) {
+      if (method == "hampel") {
+        series[i] = med;
+      } else {
+        const float left = (i > 0) ? series[i - 1] : med;
+        const float right = (i + 1 < static_cast<int>(series.size())) ? series[i + 1] : med;
+        series[i] = 0.5F * (left + right);
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE(OrderStatistics_rank_median_and_mad_match_sorted_window) {
+  aethersense::dsp::OrderStatistics stats(4);
+  std::vector<float> values;
+  const auto series = NoisySeries(300, 7U);
+  for (std::size_t i = 0; i < series.size(); ++i) {
+    stats.Insert(series[i]);
+    values.push_back(series[i]);
+    if (i % 3 == 2) {
+      const float evicted = values[values.size() / 3];
+      REQUIRE(stats.Erase(evicted));
+      values.erase(std::find(values.begin(), values.end(), evicted));
+    }
+    std::vector<float> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    REQUIRE(stats.size() == sorted.size());
+    for (std::size_t r = 0; r < sorted.size(); r += 7) {
+      REQUIRE(stats.At(r) == sorted[r]);
+    }
+    const float med = sorted[sorted.size() / 2];
+    REQUIRE(stats.UpperMedian() == med);
+    REQUIRE(stats.Median() == aethersense::dsp::Median(sorted));
+    std::vector<float> dev;
+    for (float v : sorted) {
+      dev.push_back(std::fabs(v - med));
+    }
+    std::sort(dev.begin(), dev.end());
+    REQUIRE(stats.Mad(med) == dev[dev.size() / 2]);
+    REQUIRE(stats.Mad(0.3F) >= 0.0F);
+  }
+  REQUIRE(!stats.Erase(1e9F));
+}
+
+TEST_CASE(OrderStatistics_orders_nan_last_and_erases_it) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  aethersense::dsp::OrderStatistics stats(5);
+  for (float v : {2.0F, nan, 1.0F, 3.0F, nan}) {
+    stats.Insert(v);
+  }
+  REQUIRE(stats.At(0) == 1.0F && stats.At(1) == 2.0F && stats.At(2) == 3.0F);
+  REQUIRE(std::isnan(stats.At(3)) && std::isnan(stats.At(4)));
+  // Three of the five deviations are finite, and the MAD is the third smallest.
+  REQUIRE(stats.Mad(2.0F) == 1.0F);
+  REQUIRE(stats.Erase(nan));
+  REQUIRE(stats.Erase(2.0F));
+  REQUIRE(stats.size() == 3);
+  REQUIRE(stats.Mad(1.0F) == 2.0F);
+  stats.Insert(nan);
+  REQUIRE(std::isnan(stats.Mad(1.0F))); // the third smallest of {0, 2, NaN, NaN}
+  REQUIRE(stats.Erase(nan));
+  REQUIRE(stats.Erase(nan));
+  REQUIRE(!stats.Erase(nan));
+  REQUIRE(stats.Median() == 2.0F);
+
+  // A NaN sample leaves the rolling window like any other, so the set never outgrows it.
+  auto series = NoisySeries(64, 5U);
+  series[10] = nan;
+  const int window = 5;
+  aethersense::dsp::FilterOutliers(std::span<float>(series), "hampel", 3.0F, window, stats);
+  REQUIRE(stats.size() == window / 2 + 1);
+  REQUIRE(std::isnan(series[10]));
+  for (std::size_t i = 0; i < series.size(); ++i) {
+    REQUIRE(i == 10 || std::isfinite(series[i]));
+  }
+}
+
+TEST_CASE(Rolling_outlier_filter_and_median_smooth_match_sort_based_versions) {
+  for (int window : {3, 4, 5, 9, 31}) {
+    for (const std::string method : {"mad", "hampel"}) {
+      auto expected = NoisySeries(257, static_cast<std::uint32_t>(window));
+      auto actual = expected;
+      ReferenceFilterOutliers(expected, method, 3.0F, window);
+      aethersense::dsp::FilterOutliers(actual, method, 3.0F, window);
+      REQUIRE(actual == expected);
+    }
+  }
+
+  const auto x = NoisySeries(101, 3U);
+  for (int kernel : {1, 2, 3, 4, 7, 15}) {
+    const auto smoothed = aethersense::dsp::MedianSmooth(x, kernel);
+    const int radius = kernel / 2;
+    for (int i = 0; i < static_cast<int>(x.size()); ++i) {
+      if (kernel <= 1) {
+        REQUIRE(smoothed[i] == x[i]);
+        continue;
+      }
+      std::vector<float> local;
+      for (int j = std::max(0, i - radius); j <= std::min(100, i + radius); ++j) {
+        local.push_back(x[j]);
+      }
+      std::sort(local.begin(), local.end());
+      const std::size_t m = local.size() / 2;
+      const float expected = local.size() % 2 == 0 ? 0.5F * (local[m - 1] + local[m]) : local[m];
+      REQUIRE(smoothed[i] == expected);
+    }
+  }
+}
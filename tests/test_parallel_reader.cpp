@@ -0,0 +1,136 @@
+#include "test_harness.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/io/csi_reader.hpp"
+
+namespace {
+
+// What a reader produced, call by call: a timestamp per frame, "end" for no frame and the
+// error message for a failed read.
+struct Replay {
+  std::vector<std::string> events;
+  aethersense::io::StreamStats stats;
+};
+
+Replay ReadAll(aethersense::Config::Io io, const std::string &path, std::size_t reads) {
+  Replay out;
+  auto reader = aethersense::CreateReader(io, path);
+  REQUIRE(reader.ok());
+  aethersense::CsiFrame frame;
+  for (std::size_t i = 0; i < reads; ++i) {
+    auto got = reader.value()->next_into(frame);
+    if (!got.ok()) {
+      out.events.push_back(got.error().message);
+    } else if (!got.value()) {
+      out.events.push_back("end");
+    } else {
+      out.events.push_back(std::to_string(frame.timestamp_ns) + ":" +
+                           std::to_string(frame.data.size()));
+    }
+  }
+  out.stats = reader.value()->stream_stats();
+  return out;
+}
+
+// Sequential reader vs the parallel one with small chunks, on the same file.
+Replay RequireSameReplay(aethersense::Config::Io io, const std::string &path, std::size_t reads) {
+  io.mode = "file";
+  io.checkpoint_path = path + ".checkpoint";
+  io.parse_threads = 1;
+  const auto sequential = ReadAll(io, path, reads);
+  io.parse_threads = 3;
+  io.parse_chunk_bytes = 200;
+  const auto parallel = ReadAll(io, path, reads);
+  REQUIRE(parallel.events == sequential.events);
+  REQUIRE(parallel.stats.records_total == sequential.stats.records_total);
+  REQUIRE(parallel.stats.records_corrupt_total == sequential.stats.records_corrupt_total);
+  std::filesystem::remove(io.checkpoint_path);
+  return sequential;
+}
+
+std::string CsvLine(std::size_t i) {
+  return std::to_string(1000 + i) + ",5800000000,1,1,2," + std::to_string(i) + ";0.5,0.25;" +
+         std::to_string(i % 7);
+}
+
+} // namespace
+
+TEST_CASE(Parallel_reader_matches_sequential_order_and_stats) {
+  const std::string p = "parallel_reader_test.csv";
+  std::ofstream out(p);
+  out << "timestamp_ns,center_freq_hz,rx,tx,subcarrier_count,data_re,data_im\n";
+  for (std::size_t i = 0; i < 300; ++i) {
+    out << (i % 17 == 5 ? "1,2,bad" : CsvLine(i)) << "\n";
+  }
+  out << "\n" << CsvLine(300) << "\n" << CsvLine(301); // empty line, no final newline
+  out.close();
+
+  aethersense::Config::Io io;
+  io.format = "csv";
+  const auto replay = RequireSameReplay(io, p, 320);
+  REQUIRE(replay.events[282] == "end");
+  REQUIRE(replay.events[283] == "1300:2");
+  std::filesystem::remove(p);
+}
+
+TEST_CASE(Parallel_reader_replays_corrupt_ratio_failure) {
+  const std::string p = "parallel_reader_corrupt.csv";
+  std::ofstream out(p);
+  for (std::size_t i = 0; i < 400; ++i) {
+    // Clean at first, then one corrupt line in three: the ratio check fails partway through.
+    out << (i > 150 && i % 3 == 0 ? "garbage" : CsvLine(i)) << "\n";
+  }
+  out.close();
+
+  aethersense::Config::Io io;
+  io.format = "csv";
+  io.max_corrupt_ratio = 0.2F;
+  const auto replay = RequireSameReplay(io, p, 420);
+  REQUIRE(std::count(replay.events.begin(), replay.events.end(), "corrupt ratio exceeded") > 0);
+  std::filesystem::remove(p);
+}
+
+TEST_CASE(Parallel_reader_reads_jsonl_and_resumes_checkpoint) {
+  aethersense::Config::Io io;
+  io.format = "jsonl";
+  RequireSameReplay(io, "../testdata/csi_small.jsonl", 30);
+
+  const std::string p = "parallel_reader_resume.csv";
+  std::ofstream out(p);
+  for (std::size_t i = 0; i < 50; ++i) {
+    out << CsvLine(i) << "\n";
+  }
+  out.close();
+  io.format = "csv";
+  io.checkpoint_path = p + ".checkpoint";
+  io.parse_threads = 2;
+  io.parse_chunk_bytes = 256;
+  io.checkpoint_every_records = 1;
+  std::size_t first_chunk = 0;
+  {
+    auto reader = aethersense::CreateReader(io, p);
+    REQUIRE(reader.ok());
+    // Reading past the first chunk checkpoints its end.
+    while (reader.value()->stream_stats().checkpoint_writes_total == 0) {
+      REQUIRE(reader.value()->next().value().has_value());
+      ++first_chunk;
+    }
+  }
+  io.start_position = "checkpoint";
+  auto resumed = aethersense::CreateReader(io, p);
+  REQUIRE(resumed.ok());
+  REQUIRE(resumed.value()->stream_stats().checkpoint_resume_total == 1);
+  auto frame = resumed.value()->next();
+  REQUIRE(frame.value().has_value());
+  REQUIRE(frame.value()->timestamp_ns == 1000 + first_chunk - 1);
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
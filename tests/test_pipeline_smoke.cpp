@@ -1,5 +1,9 @@
 #include "test_harness.hpp"
 
+#include <cmath>
+#include <complex>
+#include <string>
+
 #include "aethersense/core/config.hpp"
 #include "aethersense/io/csi_reader.hpp"
 #include "aethersense/runtime/metrics.hpp"
@@ -71,3 +75,88 @@ TEST_CASE(Pipeline_rejects_jittery_windows) {
   }
   REQUIRE(metrics.windows_rejected_total > 0);
 }
+
+TEST_CASE(Pipeline_hop_frames_emits_one_decision_per_hop) {
+  aethersense::Config cfg;
+  cfg.dsp.window_frames = 16;
+  cfg.dsp.hop_frames = 4;
+  aethersense::Pipeline pipeline(cfg);
+  aethersense::RuntimeMetrics metrics;
+
+  int decisions = 0;
+  for (int i = 0; i < 40; ++i) {
+    aethersense::CsiFrame frame;
+    frame.timestamp_ns = 1000000000ULL + static_cast<std::uint64_t>(i) * 50000000ULL;
+    frame.rx_count = 1;
+    frame.tx_count = 1;
+    frame.subcarrier_count = 2;
+    frame.data = {std::complex<float>(1.0F, 0.05F * static_cast<float>(i)),
+                  std::complex<float>(0.5F, 0.0F)};
+    auto result = pipeline.ProcessFrame(frame, metrics);
+    REQUIRE(result.ok());
+    if (result.value().has_value()) {
+      ++decisions;
+      REQUIRE((i - 15) % 4 == 0);
+    }
+  }
+  REQUIRE(decisions == 7);
+}
+
+namespace {
+
+// 3x3 MIMO at 20 Hz; `moving_link` (or every link when < 0) carries a 1.5 Hz phase swing.
+float LastMotionEnergy(const std::string &link_mode, const std::string &fusion, int moving_link) {
+  aethersense::Config cfg;
+  cfg.dsp.window_frames = 32;
+  cfg.dsp.topk_subcarriers = 2;
+  cfg.dsp.link_mode = link_mode;
+  cfg.dsp.link_fusion = fusion;
+  aethersense::Pipeline pipeline(cfg);
+  aethersense::RuntimeMetrics metrics;
+
+  float energy = -1.0F;
+  for (int i = 0; i < 48; ++i) {
+    aethersense::CsiFrame frame;
+    frame.timestamp_ns = 1000000000ULL + static_cast<std::uint64_t>(i) * 50000000ULL;
+    frame.rx_count = 3;
+    frame.tx_count = 3;
+    frame.subcarrier_count = 4;
+    const float t = 0.05F * static_cast<float>(i);
+    for (int link = 0; link < 9; ++link) {
+      const bool moving = moving_link < 0 || link == moving_link;
+      for (int sc = 0; sc < 4; ++sc) {
+        const float swing = moving ? 1.2F * std::sin(6.2831853F * 1.5F * t) : 0.0F;
+        const float angle =
+            0.4F * static_cast<float>(sc) + (1.0F + 0.1F * static_cast<float>(sc)) * swing;
+        const float amp = 1.0F + 0.05F * static_cast<float>(sc) * std::cos(static_cast<float>(i));
+        frame.data.push_back(std::polar(amp, angle));
+      }
+    }
+    auto result = pipeline.ProcessFrame(frame, metrics);
+    REQUIRE(result.ok());
+    if (result.value().has_value()) {
+      energy = result.value()->energy_motion;
+    }
+  }
+  return energy;
+}
+
+} // namespace
+
+TEST_CASE(Pipeline_per_link_mode_matches_averaged_on_identical_links) {
+  const float averaged = LastMotionEnergy("averaged", "max", -1);
+  REQUIRE(averaged > 0.0F);
+  for (const char *fusion : {"max", "mean", "median"}) {
+    REQUIRE_NEAR(LastMotionEnergy("per_link", fusion, -1), averaged, 1e-3F * averaged);
+  }
+}
+
+TEST_CASE(Pipeline_per_link_mode_keeps_single_moving_link_visible) {
+  const float averaged = LastMotionEnergy("averaged", "max", 4);
+  const float fused_max = LastMotionEnergy("per_link", "max", 4);
+  const float fused_mean = LastMotionEnergy("per_link", "mean", 4);
+  const float fused_median = LastMotionEnergy("per_link", "median", 4);
+  REQUIRE(fused_max > fused_mean);
+  REQUIRE(fused_mean > fused_median);
+  REQUIRE(fused_max > 2.0F * averaged);
+}
@@ -0,0 +1,127 @@
+#include "test_harness.hpp"
+#include "test_fixtures.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/io/binary_capture.hpp"
+#include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/pipeline.hpp"
+#include "aethersense/runtime/pipelined_runner.hpp"
+
+namespace {
+
+aethersense::Config RunnerConfig() {
+  auto cfg = testh::SyntheticConfig(3);
+  cfg.runtime.ring_buffer_capacity_frames = 8;
+  return cfg;
+}
+
+} // namespace
+
+TEST_CASE(PipelinedRunner_file_mode_is_lossless_and_matches_sequential_pipeline) {
+  auto cfg = RunnerConfig();
+  cfg.runtime.backpressure = "drop_oldest";
+  aethersense::PipelinedRunner runner(
+      cfg, std::make_unique<testh::SyntheticReader>(testh::FrameSpec{}, 120));
+  std::vector<aethersense::Decision> got;
+  const auto result = runner.Run(
+      [&](const aethersense::Decision &d, const aethersense::RuntimeMetrics &) { got.push_back(d); });
+  REQUIRE(result.ok());
+  REQUIRE(runner.metrics().frames_read_total == 120);
+  REQUIRE(runner.metrics().frames_dropped_total == 0);
+  REQUIRE(runner.stream_stats().records_total == 120);
+
+  aethersense::Pipeline pipeline(cfg);
+  aethersense::RuntimeMetrics metrics;
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < 120; ++i) {
+    auto decision = pipeline.ProcessFrame(testh::SyntheticFrame({}, i), metrics);
+    REQUIRE(decision.ok());
+    if (decision.value().has_value()) {
+      REQUIRE(k < got.size());
+      REQUIRE(got[k].timestamp_ns == decision.value()->timestamp_ns);
+      REQUIRE(got[k].energy_motion == decision.value()->energy_motion);
+      ++k;
+    }
+  }
+  REQUIRE(k == got.size());
+}
+
+TEST_CASE(PipelinedRunner_tail_mode_applies_backpressure_policy) {
+  auto cfg = RunnerConfig();
+  cfg.io.mode = "tail";
+  cfg.runtime.backpressure = "drop_newest";
+  // The reader fails once its 300 frames are read.
+  aethersense::PipelinedRunner runner(
+      cfg, std::make_unique<testh::SyntheticReader>(testh::FrameSpec{}, 300, 300));
+  // A slow consumer lets the reader overrun the 8-frame buffer.
+  const auto result = runner.Run([](const aethersense::Decision &, const aethersense::RuntimeMetrics &) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+  REQUIRE(!result.ok());
+  REQUIRE(runner.read_error().has_value());
+  REQUIRE(runner.metrics().frames_read_total == 300);
+  REQUIRE(runner.metrics().frames_dropped_total > 0);
+}
+
+TEST_CASE(PipelinedRunner_stops_reader_on_pipeline_error) {
+  auto cfg = RunnerConfig();
+  // Frame 40 carries no data, which the pipeline rejects.
+  aethersense::PipelinedRunner runner(
+      cfg, std::make_unique<testh::SyntheticReader>(testh::FrameSpec{}, 100000, SIZE_MAX, 40));
+  const auto result = runner.Run();
+  REQUIRE(!result.ok());
+  REQUIRE(runner.pipeline_error().has_value());
+  REQUIRE(!runner.read_error().has_value());
+  REQUIRE(runner.metrics().frames_read_total < 100000);
+}
+
+TEST_CASE(PipelinedRunner_replays_a_binary_capture_in_place) {
+  const std::string p = "pipelined_runner_capture.bin";
+  {
+    aethersense::io::BinaryCaptureWriter writer;
+    REQUIRE(writer.Open(p).ok());
+    for (std::size_t i = 0; i < 120; ++i) {
+      REQUIRE(writer.write(aethersense::MakeFrameView(testh::SyntheticFrame({}, i))).ok());
+    }
+    REQUIRE(writer.close().ok());
+  }
+  auto cfg = RunnerConfig();
+  cfg.io.format = "binary";
+  cfg.io.checkpoint_path.clear();
+  auto reader = std::make_unique<aethersense::io::BinaryCaptureReader>(cfg.io);
+  REQUIRE(reader->Open(p).ok());
+  REQUIRE(reader->reads_in_place());
+
+  aethersense::PipelinedRunner runner(cfg, std::move(reader));
+  std::vector<aethersense::Decision> got;
+  const auto result = runner.Run(
+      [&](const aethersense::Decision &d, const aethersense::RuntimeMetrics &) { got.push_back(d); });
+  REQUIRE(result.ok());
+  REQUIRE(runner.metrics().frames_read_total == 120);
+  REQUIRE(runner.stream_stats().records_total == 120);
+
+  aethersense::Pipeline pipeline(cfg);
+  aethersense::RuntimeMetrics metrics;
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < 120; ++i) {
+    auto decision = pipeline.ProcessFrame(testh::SyntheticFrame({}, i), metrics);
+    REQUIRE(decision.ok());
+    if (decision.value().has_value()) {
+      REQUIRE(k < got.size());
+      REQUIRE(got[k].timestamp_ns == decision.value()->timestamp_ns);
+      REQUIRE(got[k].energy_motion == decision.value()->energy_motion);
+      ++k;
+    }
+  }
+  REQUIRE(k == got.size());
+  REQUIRE(k > 0);
+  std::filesystem::remove(p);
+}
@@ -1,5 +1,7 @@
 #include "test_harness.hpp"
 
+#include <string>
+
 #include "aethersense/io/record_recovery.hpp"
 
 TEST_CASE(Record_recovery_skips_corrupt_csv) {
@@ -8,3 +10,59 @@ TEST_CASE(Record_recovery_skips_corrupt_csv) {
   auto bad = aethersense::io::ParseCsvRecord("1,2");
   REQUIRE(bad.corrupt);
 }
+
+TEST_CASE(Record_recovery_csv_error_precedence) {
+  using aethersense::io::ParseCsvRecord;
+  REQUIRE(ParseCsvRecord("").error == "CSV line must have 7 columns");
+  REQUIRE(ParseCsvRecord("x,2,1,1,1,0.1,0.2,extra").error == "CSV line must have 7 columns");
+  REQUIRE(ParseCsvRecord("1,2,1,1,1,0.1,").error == "CSV line must have 7 columns");
+  REQUIRE(ParseCsvRecord("x,2,1,1,1,bad,0.2").error == "invalid numeric field");
+  REQUIRE(ParseCsvRecord("1,2,1,1,2,0.1;bad,0.2;0.3").error == "invalid float token");
+  REQUIRE(ParseCsvRecord("1,2,1,1,2,0.1;;0.2,0.2;0.3").error == "invalid float token");
+  REQUIRE(ParseCsvRecord("1,2,1,1,2,0.1,0.2;0.3").error == "data_re/data_im length mismatch");
+  REQUIRE(ParseCsvRecord("1,2,1,1,2,0.1;0.2;0.3,0.2;0.3").error ==
+          "data_re/data_im length mismatch");
+}
+
+TEST_CASE(Record_recovery_csv_token_rules) {
+  // Leading whitespace and '+' are accepted, trailing characters in a token are ignored, and a
+  // trailing separator or comma adds no token or column.
+  auto r = aethersense::io::ParseCsvRecord(" 7,+2,1,1,2, 0.5;-1.25e1x;,1.5 ;2,");
+  REQUIRE(!r.corrupt);
+  REQUIRE(r.frame->timestamp_ns == 7);
+  REQUIRE(r.frame->center_freq_hz == 2);
+  REQUIRE(r.frame->data.size() == 2);
+  REQUIRE_NEAR(r.frame->data[0].real(), 0.5F, 1e-6F);
+  REQUIRE_NEAR(r.frame->data[1].real(), -12.5F, 1e-6F);
+  REQUIRE_NEAR(r.frame->data[0].imag(), 1.5F, 1e-6F);
+  REQUIRE_NEAR(r.frame->data[1].imag(), 2.0F, 1e-6F);
+  REQUIRE(aethersense::io::ParseCsvRecord("1,2,1,1,1,1e39,0").error == "invalid float token");
+  REQUIRE(aethersense::io::ParseCsvRecord("99999999999999999999,2,1,1,1,0,0").error ==
+          "invalid numeric field");
+}
+
+TEST_CASE(Record_recovery_jsonl_single_pass) {
+  using aethersense::io::ParseJsonlRecord;
+  // Keys in any order, spaces around values, and strings that merely look like keys.
+  auto r = ParseJsonlRecord("{\"data_im\": [0.5, -0.5], \"label\": \"rx\", \"data_re\":[1,2],"
+                            "\"rx\": 1, \"tx\": 1, \"subcarrier_count\": 2,"
+                            "\"timestamp_ns\": 42, \"center_freq_hz\": 5800000000}");
+  REQUIRE(!r.corrupt);
+  REQUIRE(r.frame->timestamp_ns == 42);
+  REQUIRE(r.frame->center_freq_hz == 5800000000ULL);
+  REQUIRE(r.frame->data.size() == 2);
+  REQUIRE_NEAR(r.frame->data[1].real(), 2.0F, 1e-6F);
+  REQUIRE_NEAR(r.frame->data[1].imag(), -0.5F, 1e-6F);
+
+  const std::string head =
+      "{\"timestamp_ns\":1,\"center_freq_hz\":2,\"rx\":1,\"tx\":1,\"subcarrier_count\":2,";
+  REQUIRE(ParseJsonlRecord("{\"timestamp_ns\":1}").error == "JSONL numeric parse failure");
+  REQUIRE(ParseJsonlRecord(head + "\"data_re\":[1,2]}").error == "JSONL missing arrays");
+  REQUIRE(ParseJsonlRecord(head + "\"data_re\":[1,2],\"data_im\":[1,2").error ==
+          "JSONL missing arrays");
+  REQUIRE(ParseJsonlRecord(head + "\"data_re\":[1,x],\"data_im\":[1,2]}").error ==
+          "JSONL array parse failure");
+  REQUIRE(ParseJsonlRecord(head + "\"data_re\":[1,2,3],\"data_im\":[1,2]}").error ==
+          "JSONL data length mismatch");
+  REQUIRE(!ParseJsonlRecord(head + "\"data_re\":[1,2,],\"data_im\":[1,2]}").corrupt);
+}
@@ -1,6 +1,8 @@
 #include "test_harness.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <string>
 
 #include "aethersense/dsp/resampler.hpp"
 
@@ -21,3 +23,31 @@ TEST_CASE(Resampler_reduces_jitter_impact_deterministically) {
   for (std::size_t i = 1; i < rs.size(); ++i) mse += std::fabs(rs[i]-rs[i-1]);
   REQUIRE(mse > 1.0F);
 }
+
+TEST_CASE(Resample_plan_rows_match_per_series_resampling) {
+  std::vector<std::uint64_t> t;
+  for (int i = 0; i < 40; ++i) {
+    const std::int64_t jitter = (i % 4 == 1) ? 7000000 : -2000000 * (i % 3);
+    t.push_back(static_cast<std::uint64_t>(1000000000LL + i * 40000000LL + jitter));
+  }
+  std::vector<std::uint64_t> dt;
+  for (std::size_t i = 1; i < t.size(); ++i) dt.push_back(t[i] - t[i - 1]);
+  std::sort(dt.begin(), dt.end());
+
+  const std::size_t rows = 3;
+  std::vector<float> data(rows * t.size());
+  for (std::size_t i = 0; i < data.size(); ++i) data[i] = std::sin(0.37F * static_cast<float>(i));
+
+  for (const std::string method : {"linear", "nearest"}) {
+    aethersense::dsp::ResamplePlan plan;
+    plan.Build(t, dt[dt.size() / 2], method);
+    REQUIRE(plan.size() == t.size());
+    std::vector<float> out(data.size());
+    plan.ApplyRows(data, out);
+    for (std::size_t r = 0; r < rows; ++r) {
+      const std::vector<float> series(data.begin() + r * t.size(), data.begin() + (r + 1) * t.size());
+      const auto expected = aethersense::dsp::ResampleToUniformGrid(t, series, method);
+      for (std::size_t i = 0; i < t.size(); ++i) REQUIRE(out[r * t.size() + i] == expected[i]);
+    }
+  }
+}
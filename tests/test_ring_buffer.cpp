@@ -1,5 +1,7 @@
 #include <chrono>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "test_harness.hpp"
 
@@ -11,6 +13,7 @@ TEST_CASE(RingBuffer_drop_oldest_policy) {
   REQUIRE(ring.push(2, aethersense::BackpressurePolicy::kDropOldest));
   REQUIRE(ring.push(3, aethersense::BackpressurePolicy::kDropOldest));
   REQUIRE(ring.push(4, aethersense::BackpressurePolicy::kDropOldest));
+  REQUIRE(ring.dropped() == 1);
   int out = 0;
   REQUIRE(ring.try_pop(out));
   REQUIRE(out == 2);
@@ -21,6 +24,7 @@ TEST_CASE(RingBuffer_drop_newest_policy) {
   REQUIRE(ring.push(1, aethersense::BackpressurePolicy::kDropNewest));
   REQUIRE(ring.push(2, aethersense::BackpressurePolicy::kDropNewest));
   REQUIRE(!ring.push(3, aethersense::BackpressurePolicy::kDropNewest));
+  REQUIRE(ring.dropped() == 1);
   int out = 0;
   REQUIRE(ring.try_pop(out));
   REQUIRE(out == 1);
@@ -37,3 +41,31 @@ TEST_CASE(RingBuffer_block_policy_timeout_and_move_only) {
   REQUIRE(ring.try_pop(out));
   REQUIRE(*out == 7);
 }
+
+TEST_CASE(RingBuffer_pop_batch_drains_in_order_and_ends_after_close) {
+  aethersense::RingBuffer<int> ring(8);
+  std::thread producer([&ring] {
+    for (int i = 0; i < 100; ++i) {
+      while (!ring.push(int{i}, aethersense::BackpressurePolicy::kBlock)) {
+      }
+    }
+    ring.close();
+  });
+
+  std::vector<int> batch;
+  int expected = 0;
+  while (true) {
+    const std::size_t n = ring.pop_batch(batch, 5, std::chrono::milliseconds(50));
+    REQUIRE(n <= 5);
+    if (n == 0 && ring.closed() && ring.size() == 0) {
+      break;
+    }
+    for (int v : batch) {
+      REQUIRE(v == expected++);
+    }
+  }
+  producer.join();
+  REQUIRE(expected == 100);
+  REQUIRE(ring.dropped() == 0);
+  REQUIRE(!ring.push(1, aethersense::BackpressurePolicy::kDropOldest));
+}
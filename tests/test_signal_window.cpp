@@ -0,0 +1,29 @@
+#include "test_harness.hpp"
+
+#include <vector>
+
+#include "aethersense/runtime/signal_window.hpp"
+
+TEST_CASE(SignalWindow_keeps_chronological_rows_after_wraparound) {
+  aethersense::SignalWindow window;
+  window.Reset(3, 2);
+  for (int i = 0; i < 5; ++i) {
+    const float v = static_cast<float>(i);
+    const std::vector<float> amp{v, 10.0F + v};
+    const std::vector<float> phase{-v, -10.0F - v};
+    window.Push(static_cast<std::uint64_t>(i), amp, phase);
+  }
+  REQUIRE(window.full());
+  REQUIRE(window.timestamp(0) == 2);
+  REQUIRE(window.newest_timestamp() == 4);
+
+  std::vector<float> row(3);
+  window.CopyAmplitude(1, row);
+  REQUIRE(row[0] == 12.0F && row[1] == 13.0F && row[2] == 14.0F);
+  window.CopyPhase(0, row);
+  REQUIRE(row[0] == -2.0F && row[2] == -4.0F);
+
+  const auto seg = window.amplitude(0);
+  REQUIRE(seg.older.size() + seg.newer.size() == 3);
+  REQUIRE(seg.older.front() == 2.0F);
+}
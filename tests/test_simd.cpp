@@ -0,0 +1,57 @@
+#include "test_harness.hpp"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "aethersense/dsp/simd.hpp"
+
+TEST_CASE(Simd_fast_atan2_error_is_bounded) {
+  float max_err = 0.0F;
+  for (int i = 0; i < 3600; ++i) {
+    const float angle = -3.14159F + 0.001745F * static_cast<float>(i);
+    const float r = 0.5F + 0.001F * static_cast<float>(i % 97);
+    const float y = r * std::sin(angle);
+    const float x = r * std::cos(angle);
+    max_err = std::max(max_err, std::fabs(aethersense::dsp::simd::FastAtan2(y, x) - std::atan2(y, x)));
+  }
+  REQUIRE(max_err < 1e-6F);
+  REQUIRE(aethersense::dsp::simd::FastAtan2(0.0F, 0.0F) == 0.0F);
+}
+
+TEST_CASE(Simd_link_kernels_match_reference_on_every_isa) {
+  using aethersense::dsp::simd::Isa;
+  const std::size_t links = 4;
+  for (std::size_t subcarriers : {3U, 17U, 242U}) {
+    std::vector<std::complex<float>> data(links * subcarriers);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      const float f = static_cast<float>(i);
+      data[i] = {std::cos(0.7F * f) * (1.0F + 0.01F * f), std::sin(1.3F * f) - 0.2F};
+    }
+    std::vector<float> ref_amp(subcarriers);
+    std::vector<float> ref_phase(subcarriers);
+    for (std::size_t sc = 0; sc < subcarriers; ++sc) {
+      float amp = 0.0F;
+      std::complex<float> sum(0.0F, 0.0F);
+      for (std::size_t link = 0; link < links; ++link) {
+        amp += std::abs(data[link * subcarriers + sc]);
+        sum += data[link * subcarriers + sc];
+      }
+      ref_amp[sc] = amp / static_cast<float>(links);
+      ref_phase[sc] = std::atan2(sum.imag(), sum.real());
+    }
+    for (Isa isa : {Isa::kScalar, Isa::kSse2, Isa::kAvx2, Isa::kAvx512}) {
+      if (!aethersense::dsp::simd::IsaSupported(isa)) {
+        continue;
+      }
+      std::vector<float> amp(subcarriers);
+      std::vector<float> phase(subcarriers);
+      aethersense::dsp::simd::LinkMagnitudePhase(isa, data.data(), links, subcarriers, amp.data(),
+                                                 phase.data());
+      for (std::size_t sc = 0; sc < subcarriers; ++sc) {
+        REQUIRE_NEAR(amp[sc], ref_amp[sc], 1e-5F);
+        REQUIRE_NEAR(phase[sc], ref_phase[sc], 1e-6F);
+      }
+    }
+  }
+}
@@ -0,0 +1,119 @@
+#include "test_harness.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/dsp/calibration.hpp"
+#include "aethersense/dsp/filters.hpp"
+#include "aethersense/dsp/sliding_dft.hpp"
+#include "aethersense/dsp/window.hpp"
+#include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/pipeline.hpp"
+
+TEST_CASE(SlidingDft_band_energy_matches_fft_path) {
+  const std::size_t n = 48;
+  const std::size_t fft_len = aethersense::dsp::NextPow2(n);
+  const float fs = 20.0F;
+  const auto bins = aethersense::dsp::BandBins(fs, 0.5F, 5.0F, fft_len);
+  aethersense::dsp::SlidingDft sdft(n, fft_len, aethersense::dsp::WindowType::kHann, true, 0.3F);
+  sdft.Track(bins);
+
+  std::vector<float> stream;
+  for (int i = 0; i < 6000; ++i) {
+    const float t = static_cast<float>(i) / fs;
+    stream.push_back(0.01F * static_cast<float>(i) + std::sin(2.0F * 3.14159265F * 1.3F * t) +
+                     0.3F * std::cos(2.0F * 3.14159265F * 4.1F * t));
+    sdft.Push(stream.back());
+    if (stream.size() < n || i % 97 != 0) {
+      continue;
+    }
+    std::vector<float> x(stream.end() - static_cast<std::ptrdiff_t>(n), stream.end());
+    aethersense::dsp::RemoveLinearTrend(x);
+    x = aethersense::dsp::EmaSmooth(x, 0.3F);
+    aethersense::dsp::ApplyWindow(x, aethersense::dsp::WindowType::kHann);
+    const auto spec = aethersense::dsp::MagnitudeSpectrum(x, true);
+    const float expected = aethersense::dsp::BandEnergy(spec, fs, 0.5F, 5.0F, fft_len);
+    REQUIRE(std::fabs(sdft.BandEnergy(bins) - expected) <= 1e-3F * expected);
+  }
+}
+
+TEST_CASE(Pipeline_sliding_dft_engine_matches_fft_engine_on_uniform_input) {
+  aethersense::Config cfg;
+  cfg.dsp.window_frames = 32;
+  cfg.dsp.topk_subcarriers = 2;
+  cfg.dsp.outlier.k = 1e6F;
+  aethersense::Config sliding_cfg = cfg;
+  sliding_cfg.dsp.fft.engine = "sliding_dft";
+  REQUIRE(aethersense::ValidateConfig(sliding_cfg, false).ok());
+  aethersense::Pipeline fft(cfg);
+  aethersense::Pipeline sliding(sliding_cfg);
+  aethersense::RuntimeMetrics m1;
+  aethersense::RuntimeMetrics m2;
+
+  int compared = 0;
+  for (int i = 0; i < 300; ++i) {
+    const float t = static_cast<float>(i) * 0.05F;
+    aethersense::CsiFrame frame;
+    frame.timestamp_ns = 1000000000ULL + static_cast<std::uint64_t>(i) * 50000000ULL;
+    frame.rx_count = 1;
+    frame.tx_count = 1;
+    frame.subcarrier_count = 4;
+    for (int sc = 0; sc < 4; ++sc) {
+      const float fs = static_cast<float>(sc);
+      const float amp = 1.0F + 0.2F * (fs + 1.0F) * std::sin(2.0F * 3.14159265F * 0.9F * t + fs);
+      const float phase = 0.3F * fs + 0.5F * std::sin(2.0F * 3.14159265F * 1.2F * t) * (1.0F + fs);
+      frame.data.push_back(std::polar(amp, phase));
+    }
+    auto a = fft.ProcessFrame(frame, m1);
+    auto b = sliding.ProcessFrame(frame, m2);
+    REQUIRE(a.ok() && b.ok());
+    REQUIRE(a.value().has_value() == b.value().has_value());
+    if (a.value().has_value()) {
+      const float e = a.value()->energy_motion;
+      REQUIRE(std::fabs(b.value()->energy_motion - e) <= 1e-3F * e + 1e-6F);
+      ++compared;
+    }
+  }
+  REQUIRE(compared == 300 - 31);
+}
+
+TEST_CASE(Pipeline_sliding_dft_engine_tracks_motion_band) {
+  aethersense::Config cfg;
+  cfg.dsp.window_frames = 32;
+  cfg.dsp.topk_subcarriers = 1;
+  cfg.dsp.fft.engine = "sliding_dft";
+  cfg.decision.threshold_on = 0.5F;
+  cfg.decision.threshold_off = 0.25F;
+  REQUIRE(aethersense::ValidateConfig(cfg, false).ok());
+  aethersense::Pipeline pipeline(cfg);
+  aethersense::RuntimeMetrics metrics;
+
+  int decisions = 0;
+  float still_energy = 0.0F;
+  float moving_energy = 0.0F;
+  for (int i = 0; i < 200; ++i) {
+    const float t = static_cast<float>(i) * 0.05F;
+    const float motion = i < 100 ? 0.0F : 0.8F * std::sin(2.0F * 3.14159265F * 1.5F * t);
+    aethersense::CsiFrame frame;
+    frame.timestamp_ns = 1000000000ULL + static_cast<std::uint64_t>(i) * 50000000ULL;
+    frame.rx_count = 1;
+    frame.tx_count = 1;
+    frame.subcarrier_count = 2;
+    frame.data = {std::polar(1.0F + 0.1F * std::fabs(motion), motion),
+                  std::polar(1.0F, 0.1F)};
+    auto result = pipeline.ProcessFrame(frame, metrics);
+    REQUIRE(result.ok());
+    if (result.value().has_value()) {
+      ++decisions;
+      if (i == 99) {
+        still_energy = result.value()->energy_motion;
+      }
+      if (i == 199) {
+        moving_energy = result.value()->energy_motion;
+      }
+    }
+  }
+  REQUIRE(decisions == 200 - 31);
+  REQUIRE(moving_energy > 100.0F * (still_energy + 1e-6F));
+}
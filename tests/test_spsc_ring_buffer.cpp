@@ -0,0 +1,92 @@
+#include "test_harness.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "aethersense/runtime/spsc_ring_buffer.hpp"
+
+TEST_CASE(SpscRingBuffer_rounds_capacity_and_applies_drop_policies) {
+  aethersense::SpscRingBuffer<int> ring(3);
+  REQUIRE(ring.capacity() == 4);
+  for (int i = 1; i <= 6; ++i) {
+    REQUIRE(ring.push(int{i}, aethersense::BackpressurePolicy::kDropOldest));
+  }
+  REQUIRE(ring.dropped() == 2);
+  REQUIRE(ring.size() == 4);
+  int out = 0;
+  REQUIRE(ring.try_pop(out));
+  REQUIRE(out == 3);
+
+  REQUIRE(ring.push(7, aethersense::BackpressurePolicy::kDropNewest));
+  REQUIRE(!ring.push(8, aethersense::BackpressurePolicy::kDropNewest));
+  REQUIRE(ring.dropped() == 3);
+  std::vector<int> batch;
+  REQUIRE(ring.pop_batch(batch, 16, std::chrono::milliseconds(1)) == 4);
+  REQUIRE(batch == std::vector<int>({4, 5, 6, 7}));
+}
+
+TEST_CASE(SpscRingBuffer_batch_push_and_block_timeout_with_move_only_items) {
+  aethersense::SpscRingBuffer<std::unique_ptr<int>> ring(4);
+  std::vector<std::unique_ptr<int>> items;
+  for (int i = 0; i < 6; ++i) {
+    items.push_back(std::make_unique<int>(i));
+  }
+  REQUIRE(ring.push_batch(items, aethersense::BackpressurePolicy::kBlock,
+                          std::chrono::milliseconds(5)) == 4);
+  REQUIRE(ring.dropped() == 0);
+  REQUIRE(items[4] != nullptr);
+
+  std::vector<std::unique_ptr<int>> out;
+  REQUIRE(ring.pop_batch(out, 3, std::chrono::milliseconds(1)) == 3);
+  REQUIRE(*out[0] == 0 && *out[2] == 2);
+  ring.close();
+  REQUIRE(!ring.push(std::make_unique<int>(9), aethersense::BackpressurePolicy::kDropOldest));
+  REQUIRE(ring.pop_batch(out, 3, std::chrono::milliseconds(1)) == 1);
+  REQUIRE(*out[0] == 3);
+  REQUIRE(ring.pop_batch(out, 3, std::chrono::milliseconds(1)) == 0);
+}
+
+TEST_CASE(SpscRingBuffer_concurrent_transfer_keeps_order) {
+  for (auto policy : {aethersense::BackpressurePolicy::kBlock,
+                      aethersense::BackpressurePolicy::kDropOldest,
+                      aethersense::BackpressurePolicy::kDropNewest}) {
+    aethersense::SpscRingBuffer<int> ring(16);
+    constexpr int kItems = 20000;
+    std::thread producer([&] {
+      std::vector<int> chunk;
+      for (int i = 0; i < kItems; i += 5) {
+        chunk = {i, i + 1, i + 2, i + 3, i + 4};
+        std::size_t sent = 0;
+        while (sent < chunk.size()) {
+          sent += ring.push_batch(std::span<int>(chunk).subspan(sent), policy);
+          if (policy != aethersense::BackpressurePolicy::kBlock) {
+            break;
+          }
+        }
+      }
+      ring.close();
+    });
+
+    std::vector<int> batch;
+    std::size_t received = 0;
+    int last = -1;
+    while (true) {
+      const std::size_t n = ring.pop_batch(batch, 7, std::chrono::milliseconds(50));
+      if (n == 0 && ring.closed() && ring.size() == 0) {
+        break;
+      }
+      for (int v : batch) {
+        REQUIRE(v > last);
+        last = v;
+      }
+      received += n;
+    }
+    producer.join();
+    REQUIRE(received + ring.dropped() == kItems);
+    if (policy == aethersense::BackpressurePolicy::kBlock) {
+      REQUIRE(ring.dropped() == 0);
+    }
+  }
+}
@@ -1,8 +1,13 @@
 #include "test_harness.hpp"
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "aethersense/io/checkpoint.hpp"
 #include "aethersense/io/stream_reader.hpp"
 
 TEST_CASE(Stream_reader_reads_file_mode_records) {
@@ -23,3 +28,197 @@ TEST_CASE(Stream_reader_reads_file_mode_records) {
   REQUIRE(rec1.value().line == "a");
   std::filesystem::remove(p);
 }
+
+namespace {
+
+std::vector<std::string> ReadAll(aethersense::io::IStreamReader &reader) {
+  std::vector<std::string> lines;
+  while (true) {
+    auto rec = reader.read_next();
+    REQUIRE(rec.ok());
+    if (rec.value().eof) {
+      break;
+    }
+    lines.emplace_back(rec.value().line);
+  }
+  return lines;
+}
+
+} // namespace
+
+TEST_CASE(Mmap_reader_matches_stream_reader) {
+  const std::string p = "stream_mmap_test.log";
+  std::ofstream out(p);
+  out << "first\n\nthird;with;fields\nlast\n";
+  out.close();
+
+  aethersense::Config::Io io;
+  io.mode = "file";
+  io.checkpoint_path = "stream_mmap_test.checkpoint";
+  io.reader = "mmap";
+  auto mapped = aethersense::io::CreateStreamReader(io);
+  io.reader = "stream";
+  auto streamed = aethersense::io::CreateStreamReader(io);
+  REQUIRE(mapped.ok());
+  REQUIRE(streamed.ok());
+  REQUIRE(mapped.value()->open(p).ok());
+  REQUIRE(streamed.value()->open(p).ok());
+
+  const auto lines = ReadAll(*mapped.value());
+  REQUIRE(lines == ReadAll(*streamed.value()));
+  REQUIRE(lines.size() == 4);
+  REQUIRE(lines[1].empty());
+  REQUIRE(lines[3] == "last");
+  REQUIRE(mapped.value()->stats().records_total == 4);
+  // Checkpoints are batched; reaching the end of the file writes the one pending.
+  REQUIRE(mapped.value()->stats().checkpoint_writes_total == 1);
+
+  // A final line without '\n' is still a record.
+  out.open(p, std::ios::app);
+  out << "tail";
+  out.close();
+  REQUIRE(mapped.value()->open(p).ok());
+  const auto with_tail = ReadAll(*mapped.value());
+  REQUIRE(with_tail.size() == 5);
+  REQUIRE(with_tail[4] == "tail");
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
+
+TEST_CASE(Mmap_reader_resumes_stream_reader_checkpoint) {
+  const std::string p = "stream_mmap_resume.log";
+  std::ofstream out(p);
+  out << "a\nb\nc\n";
+  out.close();
+
+  aethersense::Config::Io io;
+  io.mode = "file";
+  io.checkpoint_path = "stream_mmap_resume.checkpoint";
+  io.reader = "stream";
+  {
+    auto streamed = aethersense::io::CreateStreamReader(io);
+    REQUIRE(streamed.value()->open(p).ok());
+    REQUIRE(streamed.value()->read_next().value().line == "a");
+  }
+
+  io.reader = "mmap";
+  io.start_position = "checkpoint";
+  auto mapped = aethersense::io::CreateStreamReader(io);
+  REQUIRE(mapped.value()->open(p).ok());
+  REQUIRE(mapped.value()->stats().checkpoint_resume_total == 1);
+  REQUIRE(mapped.value()->read_next().value().line == "b");
+
+  io.start_position = "end";
+  auto at_end = aethersense::io::CreateStreamReader(io);
+  REQUIRE(at_end.value()->open(p).ok());
+  REQUIRE(at_end.value()->read_next().value().eof);
+  // Closing the readers writes their pending checkpoints.
+  mapped.value().reset();
+  at_end.value().reset();
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
+
+TEST_CASE(Mmap_reader_reports_missing_file) {
+  aethersense::Config::Io io;
+  io.reader = "mmap";
+  auto mapped = aethersense::io::CreateStreamReader(io);
+  REQUIRE(mapped.ok());
+  REQUIRE(!mapped.value()->read_next().ok());
+  REQUIRE(!mapped.value()->open("does_not_exist.log").ok());
+}
+
+TEST_CASE(Checkpoint_writer_batches_and_replaces_the_file_atomically) {
+  aethersense::Config::Io io;
+  io.checkpoint_path = "checkpoint_writer_test.checkpoint";
+  io.checkpoint_every_records = 3;
+  io.checkpoint_interval_ms = 60000;
+  {
+    aethersense::io::CheckpointWriter writer(io);
+    writer.Update({"0:10", 1, 0});
+    writer.Update({"0:10", 2, 0});
+    REQUIRE(writer.writes_total() == 0);
+    REQUIRE(!std::filesystem::exists(io.checkpoint_path));
+    // Amending the current record does not count toward the batch.
+    writer.Update({"0:10", 2, 77}, 0);
+    writer.Update({"0:10", 3, 0});
+    REQUIRE(writer.writes_total() == 1);
+    REQUIRE(aethersense::io::ReadCheckpoint(io.checkpoint_path)->offset == 3);
+    REQUIRE(!std::filesystem::exists(io.checkpoint_path + ".tmp"));
+
+    writer.Update({"0:10", 4, 99});
+    writer.Flush();
+    writer.Flush(); // nothing pending
+    REQUIRE(writer.writes_total() == 2);
+    const auto ck = aethersense::io::ReadCheckpoint(io.checkpoint_path);
+    REQUIRE(ck->signature == "0:10" && ck->offset == 4 && ck->timestamp_ns == 99);
+    writer.Update({"0:10", 5, 0});
+  }
+  // Destruction flushes the last point.
+  REQUIRE(aethersense::io::ReadCheckpoint(io.checkpoint_path)->offset == 5);
+
+  // Background writes with fsync report the same count once flushed.
+  io.checkpoint_async = true;
+  io.checkpoint_fsync = true;
+  io.checkpoint_every_records = 1;
+  {
+    aethersense::io::CheckpointWriter writer(io);
+    for (std::uint64_t i = 1; i <= 50; ++i) {
+      writer.Update({"0:10", i, i});
+    }
+    writer.Flush();
+    // Checkpoints queued while an earlier one was being written are coalesced.
+    REQUIRE(writer.writes_total() >= 1 && writer.writes_total() <= 50);
+    REQUIRE(aethersense::io::ReadCheckpoint(io.checkpoint_path)->offset == 50);
+  }
+
+  // A pending point goes out once it is older than the interval.
+  io.checkpoint_async = false;
+  io.checkpoint_every_records = 1000;
+  io.checkpoint_interval_ms = 5;
+  {
+    aethersense::io::CheckpointWriter writer(io);
+    writer.Update({"0:10", 60, 0});
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    writer.FlushIfStale();
+    REQUIRE(writer.writes_total() == 1);
+    writer.FlushIfStale();
+    REQUIRE(writer.writes_total() == 1);
+  }
+
+  // No checkpoint path, no file and no thread.
+  io.checkpoint_path.clear();
+  aethersense::io::CheckpointWriter disabled(io);
+  disabled.Update({"0:10", 1, 0});
+  disabled.Flush();
+  REQUIRE(disabled.writes_total() == 0);
+  std::filesystem::remove("checkpoint_writer_test.checkpoint");
+}
+
+TEST_CASE(Stream_reader_batches_checkpoints_while_tailing) {
+  const std::string p = "stream_checkpoint_flush.log";
+  std::ofstream out(p);
+  out << "a\nb\nc\n";
+  out.close();
+
+  aethersense::Config::Io io;
+  io.mode = "tail";
+  io.reader = "stream";
+  io.poll_interval_ms = 1;
+  io.checkpoint_path = p + ".checkpoint";
+  io.checkpoint_interval_ms = 60000;
+  {
+    auto reader = aethersense::io::CreateStreamReader(io);
+    REQUIRE(reader.value()->open(p).ok());
+    for (int i = 0; i < 3; ++i) {
+      REQUIRE(!reader.value()->read_next().value().line.empty());
+    }
+    // Waiting for more input does not write a checkpoint per record...
+    REQUIRE(reader.value()->read_next().value().line.empty());
+    REQUIRE(reader.value()->stats().checkpoint_writes_total == 0);
+  }
+  // ...and closing the reader writes the exact position.
+  REQUIRE(aethersense::io::ReadCheckpoint(io.checkpoint_path)->offset == 6);
+  std::filesystem::remove(p);
+  std::filesystem::remove(io.checkpoint_path);
+}
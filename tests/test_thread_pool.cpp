@@ -0,0 +1,78 @@
+#include "test_harness.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "aethersense/runtime/thread_pool.hpp"
+
+TEST_CASE(WorkStealingPool_runs_nested_tasks_before_wait_returns) {
+  aethersense::WorkStealingPool pool(3);
+  REQUIRE(pool.size() == 3);
+  std::atomic<int> done{0};
+  for (int i = 0; i < 20; ++i) {
+    pool.Submit([&pool, &done] {
+      for (int j = 0; j < 5; ++j) {
+        pool.Submit([&done] { done.fetch_add(1); });
+      }
+      done.fetch_add(1);
+    });
+  }
+  pool.Wait();
+  REQUIRE(done.load() == 120);
+
+  // The pool is reusable after Wait().
+  pool.Submit([&done] { done.fetch_add(1); });
+  pool.Wait();
+  REQUIRE(done.load() == 121);
+}
+
+TEST_CASE(WorkStealingPool_idle_workers_steal_from_a_busy_deque) {
+  aethersense::WorkStealingPool pool(4);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  // Everything is queued on one worker's own deque; the others can only get work by stealing.
+  pool.Submit([&] {
+    for (int i = 0; i < 32; ++i) {
+      pool.Submit([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+      });
+    }
+  });
+  pool.Wait();
+  REQUIRE(threads.size() > 1);
+}
+
+TEST_CASE(WorkStealingPool_yielded_tasks_take_turns) {
+  aethersense::WorkStealingPool pool(2);
+  constexpr std::size_t kTasks = 8;
+  std::atomic<std::size_t> steps[kTasks] = {};
+  std::atomic<std::size_t> total{0};
+  std::atomic<bool> go{false};
+  // Each task requeues itself until 1600 steps have run in all; none may be starved. A step
+  // sleeps briefly so that both workers get the CPU even on a single core.
+  std::function<void(std::size_t)> step = [&](std::size_t t) {
+    while (!go.load()) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+    steps[t].fetch_add(1);
+    if (total.fetch_add(1) + 1 < 1600) {
+      pool.Yield([&step, t] { step(t); });
+    }
+  };
+  for (std::size_t t = 0; t < kTasks; ++t) {
+    pool.Submit([&step, t] { step(t); });
+  }
+  go.store(true);
+  pool.Wait();
+  for (std::size_t t = 0; t < kTasks; ++t) {
+    REQUIRE(steps[t].load() >= 100);
+  }
+}
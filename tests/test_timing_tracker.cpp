@@ -0,0 +1,53 @@
+#include "test_harness.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "aethersense/dsp/resampler.hpp"
+#include "aethersense/dsp/timing_tracker.hpp"
+
+TEST_CASE(TimingTracker_matches_window_statistics_over_sliding_stream) {
+  const std::size_t window = 16;
+  aethersense::dsp::TimingTracker tracker;
+  tracker.Reset(window);
+  REQUIRE(tracker.jitter_ratio() == 0.0F);
+
+  std::vector<std::uint64_t> history;
+  std::uint64_t ts = 5000000000ULL;
+  for (std::size_t i = 0; i < 300; ++i) {
+    // 100 Hz with irregular jitter and an occasional dropped frame.
+    ts += 10000000ULL + (i * 7919ULL) % 900000ULL + (i % 37 == 0 ? 10000000ULL : 0ULL);
+    tracker.Push(ts);
+    history.push_back(ts);
+    if (history.size() > window) {
+      history.erase(history.begin());
+    }
+
+    REQUIRE(tracker.intervals() == history.size() - 1);
+    if (history.size() < 2) {
+      continue;
+    }
+    std::vector<std::uint64_t> dt;
+    for (std::size_t k = 1; k < history.size(); ++k) {
+      dt.push_back(history[k] - history[k - 1]);
+    }
+    std::sort(dt.begin(), dt.end());
+    REQUIRE(tracker.median_interval_ns() == dt[dt.size() / 2]);
+    REQUIRE(tracker.sample_rate_hz() == 1e9F / static_cast<float>(dt[dt.size() / 2]));
+    REQUIRE_NEAR(tracker.jitter_ratio(), aethersense::dsp::JitterMetric(history), 1e-5F);
+  }
+
+  tracker.Clear();
+  REQUIRE(tracker.intervals() == 0);
+  REQUIRE(tracker.median_interval_ns() == 0);
+}
+
+TEST_CASE(TimingTracker_flags_zero_median_interval) {
+  aethersense::dsp::TimingTracker tracker;
+  tracker.Reset(8);
+  for (int i = 0; i < 4; ++i) {
+    tracker.Push(1000);
+  }
+  REQUIRE(tracker.jitter_ratio() == 1.0F);
+}
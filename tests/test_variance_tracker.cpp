@@ -0,0 +1,63 @@
+#include "test_harness.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "aethersense/dsp/filters.hpp"
+#include "aethersense/dsp/variance_tracker.hpp"
+
+TEST_CASE(VarianceTracker_matches_two_pass_variance_over_sliding_window) {
+  const std::size_t channels = 3;
+  const std::size_t window = 16;
+  aethersense::dsp::VarianceTracker tracker;
+  tracker.Reset(channels);
+
+  std::vector<std::vector<float>> history(channels);
+  std::vector<float> added(channels);
+  std::vector<float> evicted(channels);
+  for (std::size_t t = 0; t < 200; ++t) {
+    for (std::size_t ch = 0; ch < channels; ++ch) {
+      added[ch] = 10.0F + static_cast<float>(ch) + 0.5F * std::sin(0.37F * static_cast<float>(t * (ch + 1)));
+    }
+    if (history[0].size() == window) {
+      for (std::size_t ch = 0; ch < channels; ++ch) {
+        evicted[ch] = history[ch].front();
+        history[ch].erase(history[ch].begin());
+      }
+      tracker.Replace(added, evicted);
+    } else {
+      tracker.Add(added);
+    }
+    for (std::size_t ch = 0; ch < channels; ++ch) {
+      history[ch].push_back(added[ch]);
+    }
+
+    REQUIRE(tracker.count() == history[0].size());
+    for (std::size_t ch = 0; ch < channels; ++ch) {
+      const auto &h = history[ch];
+      double mean = 0.0;
+      for (float v : h) {
+        mean += v;
+      }
+      mean /= static_cast<double>(h.size());
+      double var = 0.0;
+      for (float v : h) {
+        var += (v - mean) * (v - mean);
+      }
+      var /= static_cast<double>(h.size());
+      REQUIRE_NEAR(tracker.variance(ch), static_cast<float>(var), 1e-5F);
+    }
+  }
+
+  tracker.Rebuild(1, history[1], {});
+  REQUIRE(tracker.count() == window);
+}
+
+TEST_CASE(TopKVariance_returns_highest_variance_first) {
+  const std::vector<std::vector<float>> series = {
+      {0.0F, 0.0F, 0.0F}, {0.0F, 2.0F, 0.0F}, {0.0F, 1.0F, 0.0F}, {0.0F, 4.0F, 0.0F}};
+  const auto top = aethersense::dsp::TopKVariance(series, 2);
+  REQUIRE(top.size() == 2);
+  REQUIRE(top[0] == 3);
+  REQUIRE(top[1] == 1);
+}
@@ -0,0 +1,100 @@
+#include "test_harness.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "aethersense/core/config.hpp"
+#include "aethersense/runtime/metrics.hpp"
+#include "aethersense/runtime/pipeline.hpp"
+
+// Counting replacement of the global allocator; applies to the whole test binary but only the
+// delta across a measured region matters.
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}
+
+void *operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+std::vector<aethersense::CsiFrame> MakeFrames(std::size_t count) {
+  std::vector<aethersense::CsiFrame> frames(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto &frame = frames[i];
+    // 100 Hz with a little deterministic jitter.
+    frame.timestamp_ns = 1000000000ULL + i * 10000000ULL + (i % 3) * 200000ULL;
+    frame.center_freq_hz = 5800000000ULL;
+    frame.rx_count = 2;
+    frame.tx_count = 2;
+    frame.subcarrier_count = 30;
+    frame.data.resize(4 * 30);
+    for (std::size_t j = 0; j < frame.data.size(); ++j) {
+      const float t = static_cast<float>(i) * 0.01F;
+      const float angle = 0.3F * static_cast<float>(j) + 2.0F * std::sin(6.28F * 1.5F * t);
+      const float amp = 1.0F + 0.2F * std::sin(static_cast<float>(i + j));
+      frame.data[j] = std::polar(amp, angle);
+    }
+  }
+  return frames;
+}
+
+std::size_t SteadyStateAllocations(const aethersense::Config &cfg) {
+  const auto frames = MakeFrames(400);
+  aethersense::Pipeline pipeline(cfg);
+  aethersense::RuntimeMetrics metrics;
+  std::size_t decisions = 0;
+  for (std::size_t i = 0; i < 200; ++i) {
+    auto result = pipeline.ProcessFrame(frames[i], metrics);
+    REQUIRE(result.ok());
+  }
+  const std::size_t before = g_allocations.load();
+  for (std::size_t i = 200; i < frames.size(); ++i) {
+    auto result = pipeline.ProcessFrame(frames[i], metrics);
+    if (result.ok() && result.value().has_value()) {
+      ++decisions;
+    }
+  }
+  const std::size_t allocations = g_allocations.load() - before;
+  REQUIRE(decisions > 0);
+  return allocations;
+}
+
+} // namespace
+
+TEST_CASE(Pipeline_steady_state_does_not_allocate) {
+  aethersense::Config cfg;
+  cfg.dsp.window_frames = 64;
+  cfg.dsp.topk_subcarriers = 4;
+  cfg.dsp.resampling.reject_jitter_ratio = 0.9F;
+  REQUIRE(SteadyStateAllocations(cfg) == 0);
+
+  cfg.dsp.smoothing.type = "median";
+  cfg.dsp.outlier.method = "hampel";
+  cfg.dsp.bands.breathing.enabled = true;
+  REQUIRE(SteadyStateAllocations(cfg) == 0);
+
+  cfg.dsp.link_mode = "per_link";
+  REQUIRE(SteadyStateAllocations(cfg) == 0);
+
+  cfg.dsp.link_mode = "averaged";
+  cfg.dsp.smoothing.type = "ema";
+  cfg.dsp.fft.engine = "sliding_dft";
+  cfg.dsp.hop_frames = 4;
+  cfg.dsp.topk_reselect_every = 8;
+  REQUIRE(SteadyStateAllocations(cfg) == 0);
+}